@@ -2,7 +2,7 @@
 # Build script for LED grid firmware.
 # Usage:
 #   ./build.sh              # Compile only
-#   ./build.sh --upload     # Compile + OTA upload to device
+#   ./build.sh --upload     # Compile + compressed OTA upload to device
 #   ./build.sh --upload IP  # Compile + OTA upload to specific IP
 
 set -euo pipefail
@@ -20,7 +20,7 @@ python3 compress_html.py
 
 # Step 2: Compile
 echo "==> Compiling..."
-arduino-cli compile --fqbn "$FQBN" "$SKETCH_DIR" --export-binaries
+arduino-cli compile --fqbn "$FQBN" "$SKETCH_DIR" --libraries ../libraries --export-binaries
 
 # Step 3: Optional OTA upload
 if [[ "${1:-}" == "--upload" ]]; then
@@ -29,6 +29,12 @@ if [[ "${1:-}" == "--upload" ]]; then
         exit 1
     fi
     IP="${2:-$DEFAULT_IP}"
+
+    # Compress the image; the device decodes it as it arrives
+    echo "==> Compressing firmware..."
+    read -r SIZE MD5 < <(python3 compress_ota.py "$BIN")
+    HS="$BIN.hs"
+
     echo "==> OTA uploading to $IP..."
 
     # Login to get session cookie
@@ -36,15 +42,28 @@ if [[ "${1:-}" == "--upload" ]]; then
         -d "password=$DEVICE_PASS" \
         "http://$IP/login" -o /dev/null
 
-    # Upload firmware
-    RESULT=$(curl -s -b /tmp/esp_cookies.txt \
-        -F "firmware=@$BIN" \
-        "http://$IP/update")
+    # Upload firmware; if the connection drops, resume from what the device has
+    OFFSET=0
+    for _ in 1 2 3; do
+        tail -c +$((OFFSET + 1)) "$HS" > /tmp/esp_ota_part.hs
+        if RESULT=$(curl -s -b /tmp/esp_cookies.txt \
+                -F "firmware=@/tmp/esp_ota_part.hs;filename=$(basename "$HS")" \
+                "http://$IP/update?size=$SIZE&md5=$MD5&offset=$OFFSET"); then
+            break
+        fi
+        STATUS=$(curl -s -b /tmp/esp_cookies.txt "http://$IP/api/ota" || true)
+        if ! echo "$STATUS" | grep -q '"state":"suspended"'; then
+            break
+        fi
+        OFFSET=$(echo "$STATUS" | sed -n 's/.*"received":\([0-9]*\).*/\1/p')
+        echo "==> Connection lost, resuming at byte $OFFSET..."
+    done
 
-    if echo "$RESULT" | grep -q "Update OK"; then
+    if echo "${RESULT:-}" | grep -q "Update OK"; then
         echo "==> Upload OK — device rebooting"
+        echo "$RESULT" | sed -n 's/.*<p>\(.*\)<\/p>.*/    \1/p'
     else
-        echo "==> Upload failed: $RESULT" >&2
+        echo "==> Upload failed: ${RESULT:-no response}" >&2
         exit 1
     fi
 fi
@@ -2,13 +2,15 @@
 """Generate gzip-compressed HTML header from html_pages.h.
 
 Reads html_pages.h, bakes shared CSS into each page, gzip compresses,
-and outputs html_pages_gz.h with PROGMEM byte arrays.
+and outputs html_pages_gz.h with PROGMEM byte arrays. Each page also gets
+an ETag: a hash of its baked content, so it only changes when the page does.
 
 Run automatically by build.sh before arduino-cli compile.
 """
 
 import re
 import gzip
+import hashlib
 import sys
 from pathlib import Path
 
@@ -61,7 +63,7 @@ def main():
     out.append("#include <Arduino.h>")
     out.append("")
     out.append("// Auto-generated — do not edit. Edit html_pages.h instead.")
-    out.append("// Generated by compress_html.py (CSS pre-baked, gzip level 9)")
+    out.append("// Generated by compress_html.py (CSS pre-baked, gzip level 9, content-hash ETags)")
     out.append("")
 
     total_raw = 0
@@ -74,7 +76,9 @@ def main():
 
         baked = pages[name].replace("%CSS%", css)
         raw_bytes = baked.encode("utf-8")
-        gz_data = gzip.compress(raw_bytes, compresslevel=9)
+        # mtime=0 keeps the output identical from build to build
+        gz_data = gzip.compress(raw_bytes, compresslevel=9, mtime=0)
+        etag = hashlib.sha256(raw_bytes).hexdigest()[:16]
 
         total_raw += len(raw_bytes)
         total_gz += len(gz_data)
@@ -84,6 +88,7 @@ def main():
         out.append(to_c_array(gz_data))
         out.append("};")
         out.append(f"static const size_t {var_name}_LEN = sizeof({var_name});")
+        out.append(f'static const char {var_name}_ETAG[] = "\\"{etag}\\"";')
         out.append("")
 
     out.append("#endif // HTML_PAGES_GZ_H")
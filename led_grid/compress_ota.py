@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""Compress a firmware image for OTA upload.
+
+Writes <image>.hs: the image in heatshrink format, with the window and
+lookahead sizes the device decodes with (OTA_HS_WINDOW_BITS and
+OTA_HS_LOOKAHEAD_BITS in config.h). The output is the same format as
+`heatshrink -e -w <W> -l <L>`, so either tool can make it.
+
+Prints "<image size> <image MD5>" on stdout; build.sh passes both with the
+upload so the device can check what it wrote.
+
+Run automatically by build.sh --upload.
+"""
+
+import hashlib
+import re
+import sys
+from pathlib import Path
+
+SCRIPT_DIR = Path(__file__).parent
+CONFIG = SCRIPT_DIR / "config.h"
+
+MIN_MATCH = 3       # hash key length; shorter matches barely beat literals
+MAX_CHAIN = 48      # candidates tried per position
+
+
+def config_value(name: str) -> int:
+    match = re.search(rf"#define\s+{name}\s+(\d+)", CONFIG.read_text())
+    if not match:
+        sys.exit(f"error: {name} not found in {CONFIG}")
+    return int(match.group(1))
+
+
+class BitWriter:
+    def __init__(self):
+        self.out = bytearray()
+        self.acc = 0
+        self.nbits = 0
+
+    def put(self, value: int, bits: int):
+        self.acc = (self.acc << bits) | value
+        self.nbits += bits
+        while self.nbits >= 8:
+            self.nbits -= 8
+            self.out.append((self.acc >> self.nbits) & 0xFF)
+        self.acc &= (1 << self.nbits) - 1
+
+    def finish(self) -> bytes:
+        if self.nbits:
+            # Zero padding reads as the start of a back-reference that never
+            # completes, which the decoder drops
+            self.out.append((self.acc << (8 - self.nbits)) & 0xFF)
+        return bytes(self.out)
+
+
+def compress(data: bytes, window_bits: int, lookahead_bits: int) -> bytes:
+    window = 1 << window_bits
+    max_len = 1 << lookahead_bits
+    out = BitWriter()
+    chains: dict[bytes, list[int]] = {}
+    n = len(data)
+    i = 0
+
+    while i < n:
+        best_len, best_off = 0, 0
+        limit = min(max_len, n - i)
+        candidates = chains.get(data[i:i + MIN_MATCH]) if limit >= MIN_MATCH else None
+        if candidates:
+            target = data[i:i + limit]
+            for p in reversed(candidates[-MAX_CHAIN:]):
+                off = i - p
+                if off > window:
+                    break
+                if data[p:p + limit] == target:
+                    best_len, best_off = limit, off
+                    break
+                k = MIN_MATCH
+                while data[p + k] == data[i + k]:
+                    k += 1
+                if k > best_len:
+                    best_len, best_off = k, off
+
+        if best_len >= MIN_MATCH:
+            out.put(0, 1)
+            out.put(best_off - 1, window_bits)
+            out.put(best_len - 1, lookahead_bits)
+            step = best_len
+        else:
+            out.put(1, 1)
+            out.put(data[i], 8)
+            step = 1
+
+        for j in range(i, min(i + step, n - MIN_MATCH + 1)):
+            chain = chains.setdefault(data[j:j + MIN_MATCH], [])
+            chain.append(j)
+            if len(chain) > 2 * MAX_CHAIN:
+                del chain[:MAX_CHAIN]
+        i += step
+
+    return out.finish()
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(f"usage: {sys.argv[0]} <firmware.bin>")
+    src = Path(sys.argv[1])
+    data = src.read_bytes()
+
+    packed = compress(data,
+                      config_value("OTA_HS_WINDOW_BITS"),
+                      config_value("OTA_HS_LOOKAHEAD_BITS"))
+    dst = src.with_name(src.name + ".hs")
+    dst.write_bytes(packed)
+
+    pct = len(packed) * 100 / len(data) if data else 0
+    print(f"  {src.name}: {len(data)} -> {len(packed)} bytes ({pct:.0f}%)",
+          file=sys.stderr)
+    print(len(data), hashlib.md5(data).hexdigest())
+
+
+if __name__ == "__main__":
+    main()
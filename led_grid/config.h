@@ -2,28 +2,113 @@
 #define CONFIG_H
 
 #include <Arduino.h>
+#include <led_geometry.h>
+#include <led_tiling.h>
 
 #define FW_VERSION "0.5.0"
 
 // ─── Hardware ───────────────────────────────────────────────────────────────
 #define LED_PIN         4        // GPIO4 — data pin for the LED grid
-#define GRID_WIDTH      16
-#define GRID_HEIGHT     16
-#define NUM_LEDS        (GRID_WIDTH * GRID_HEIGHT)  // 256
+#define PANEL_WIDTH     16
+#define PANEL_HEIGHT    16
+#define TILES_X         1        // panels across (see Panel Tiling)
+#define TILES_Y         1        // panels down
+#define GRID_WIDTH      (PANEL_WIDTH * TILES_X)
+#define GRID_HEIGHT     (PANEL_HEIGHT * TILES_Y)
+#define NUM_LEDS        (GRID_WIDTH * GRID_HEIGHT)  // 256 for one panel
 
 // LED strip type (WS2812B is most common for grids)
 #define LED_TYPE        (NEO_GRB + NEO_KHZ800)
 
 // ─── Defaults ─────────────────────────────────────────────────────────────
-#define DEFAULT_BRIGHTNESS  40   // 0-255 — keep moderate to limit current draw
+#define DEFAULT_BRIGHTNESS  40   // 0-255 — the power limit caps the actual draw
+
+// ─── Power Limit ───────────────────────────────────────────────────────────
+#define POWER_BUDGET_MA         3000   // LED supply budget in mA (0 = estimate only)
+#define POWER_MA_PER_CHANNEL    20     // one WS2812B colour channel at full drive
+#define POWER_IDLE_MA_PER_LED   1      // quiescent draw per LED, lit or not
+#define POWER_RELEASE_SHIFT     3      // recover 1/8 of the gap per frame after a limit
 
 // ─── Animation Timing ──────────────────────────────────────────────────────
 #define LED_UPDATE_INTERVAL_MS  30   // ~33 FPS
 #define RAINBOW_CYCLE_MS      10000  // Full rainbow rotation period
 #define COLOUR_WASH_CYCLE_MS   5000  // Solid hue sweep period
 
+// ─── Render Task ───────────────────────────────────────────────────────────
+#define RENDER_TASK_PRIORITY  5      // above loop() (1), below the WiFi/LwIP tasks
+#define RENDER_TASK_STACK     8192   // bytes
+#define RENDER_QUEUE_LEN      16     // commands from loop() in flight, power of two
+
+// ─── Performance Counters ──────────────────────────────────────────────────
+#define PERF_STATS       true    // loop/render/show timing at /api/perf
+
+// ─── Event Trace ───────────────────────────────────────────────────────────
+#define TRACE_ENABLED     true   // span ring exported at /api/trace
+#define TRACE_EVENTS      512    // ring size, power of two (12 bytes each)
+#define TRACE_STALL_MS    50     // loop() or a render pass longer than this freezes the rings
+#define TRACE_HTTP_MIN_US 100    // shorter handleClient() calls were idle polls
+
 // ─── Grid Layout ───────────────────────────────────────────────────────────
 #define SERPENTINE_LAYOUT  true
+#define PANEL_ROTATION     ROTATE_90
+
+// ─── Panel Tiling ──────────────────────────────────────────────────────────
+// Set TILES_X/TILES_Y above to chain several panels into one wall, then
+// list every panel here in data-chain order: its position on the wall,
+// mounting and the output that drives it. Outputs map to OUTPUT_PINS and
+// each gets its own RMT channel (the C3 has two), transmitted concurrently.
+// A 32x32 wall as two chains of two panels, the right-hand column mounted
+// upside down so each chain snakes back on itself:
+//
+//   #define TILES_X 2
+//   #define TILES_Y 2
+//   static const LedTile WALL_LAYOUT[] = {
+//       { 0, 0, ROTATE_90,  true, 0 },  { 1, 0, ROTATE_270, true, 0 },
+//       { 0, 1, ROTATE_90,  true, 1 },  { 1, 1, ROTATE_270, true, 1 },
+//   };
+//   static const uint8_t OUTPUT_PINS[] = { 4, 5 };
+static const LedTile WALL_LAYOUT[] = {
+    // col row  rotation        serpentine          output
+    {  0,  0,   PANEL_ROTATION, SERPENTINE_LAYOUT,  0 },
+};
+static const uint8_t OUTPUT_PINS[] = { LED_PIN };
+
+#define NUM_TILES    (TILES_X * TILES_Y)
+#define NUM_OUTPUTS  (sizeof(OUTPUT_PINS) / sizeof(OUTPUT_PINS[0]))
+
+// Row-major serpentine, mounted a quarter turn clockwise.
+// Loop bounds, row bitmasks and the strip map all specialise on this type.
+// A single panel keeps the constant-folding LedGeometry; a wall looks its
+// strip index up in the map compiled from WALL_LAYOUT at boot.
+typedef LedGeometry<PANEL_WIDTH, PANEL_HEIGHT, WIRING_ROWS, PANEL_ROTATION, SERPENTINE_LAYOUT> PanelGeometry;
+typedef LedTiledGeometry<PANEL_WIDTH, PANEL_HEIGHT, TILES_X, TILES_Y, WIRING_ROWS> WallGeometry;
+typedef LedSelect<(NUM_TILES > 1), WallGeometry, PanelGeometry>::type GridGeometry;
+
+// Logical x runs right→left as the viewer sees the rotated grid (see
+// drawDigit); overlays and text are placed in screen coordinates.
+typedef LedMirrorX<GridGeometry> ScreenGeometry;
+
+// ─── UDP Pixel Input ───────────────────────────────────────────────────────
+#define UDP_INPUT                 true   // DDP / E1.31 / Art-Net receiver for EFFECT_LIVE (MQTT frames arrive either way)
+#define DDP_PORT                  4048
+#define E131_PORT                 5568
+#define ARTNET_PORT               6454
+#define E131_START_UNIVERSE       1      // sACN universes start at 1
+#define ARTNET_START_UNIVERSE     0
+#define UDP_PIXELS_PER_UNIVERSE   170    // 510 of 512 DMX channels, whole RGB pixels
+#define UDP_FRAME_DEADLINE_MS     40     // present a partial frame after this long
+#define UDP_MAX_PACKETS_PER_LOOP  8      // bound per render pass so frames keep their slot
+
+// ─── GIF Clips ─────────────────────────────────────────────────────────────
+#define GIF_MAX_UPLOAD            (256 * 1024)  // bytes; larger uploads are refused
+#define GIF_MAX_SIDE              128    // GIF screen width/height limit (decode canvas)
+#define GIF_MAX_FRAMES            1024   // frames kept from one GIF
+#define GIF_INSTALL_WAIT_MS       2000   // /api/gif: longest wait for the render task to swap the clip in
+
+// ─── OTA Update ────────────────────────────────────────────────────────────
+#define OTA_HS_WINDOW_BITS        11     // heatshrink -w: 2 KB decode window
+#define OTA_HS_LOOKAHEAD_BITS     4      // heatshrink -l: copies of up to 16 bytes
+#define OTA_RESUME_MS             120000 // an interrupted upload can be resumed this long
 
 // ─── WiFi / Network ────────────────────────────────────────────────────────
 #define MDNS_HOSTNAME   "tetris"       // http://tetris.local
@@ -51,12 +136,35 @@ enum Effect : uint8_t {
     EFFECT_SPIRAL,           // Rotating colour pinwheel
     EFFECT_VALENTINES,       // Pulsing heart with sparkles
     EFFECT_SNAKE,            // Snake game — AI or manual phone control
+    EFFECT_LIVE,             // Frames pushed over UDP (DDP / E1.31 / Art-Net) or MQTT (ledgrid/<id>/frame)
+    EFFECT_GIF,              // Uploaded animated GIF, streamed from flash
+    EFFECT_NOISE_FIRE,       // Fire from a rising gradient-noise field
+    EFFECT_NOISE_AURORA,     // Aurora curtains wandering on noise
+    EFFECT_NOISE_LAVA,       // Lava blobs thresholded from a noise field
+    EFFECT_NOISE_CANDLE,     // Candle flicker following a noise curve
     EFFECT_COUNT             // Sentinel — number of effects
 };
 
+// ─── Config Store ──────────────────────────────────────────────────────────
+#define CONFIG_SCHEMA_VERSION     1       // bump with a migration when GridConfig changes
+#define CONFIG_SAVE_DELAY_MS      2000    // commit once settings are quiet this long
+#define CONFIG_SAVE_MAX_DELAY_MS  30000   // ... or this long after the first unsaved change
+#define CONFIG_SAVE_RETRY_MS      5000    // retry a failed write after this, doubling each time ...
+#define CONFIG_SAVE_RETRY_MAX_MS  60000   // ... up to this
+
 // ─── MQTT ─────────────────────────────────────────────────────────────────
 #define MQTT_DEFAULT_PORT    1883
-#define MQTT_BUFFER_SIZE     1024
+#define MQTT_DISCOVERY_CACHE 3072    // HA discovery payloads, built once (see mqtt_client.cpp)
+
+// ledgrid/<ID>/frame: RGB in screen order, or a palette (count byte, 0 = 256,
+// then count x RGB) followed by one index per pixel
+#define MQTT_FRAME_RGB_BYTES      (NUM_LEDS * 3)
+#define MQTT_FRAME_MAX_BYTES      (MQTT_FRAME_RGB_BYTES > 1 + 256 * 3 + NUM_LEDS ? MQTT_FRAME_RGB_BYTES : 1 + 256 * 3 + NUM_LEDS)
+#define MQTT_FRAME_MIN_INTERVAL_MS 40     // frames arriving faster are dropped (25 fps)
+#define MQTT_FRAME_HOLD_MS        30000  // Live blanks this long after the last MQTT frame
+
+// Big enough for the largest frame plus its topic and the MQTT header
+#define MQTT_BUFFER_SIZE     (MQTT_FRAME_MAX_BYTES + 64 > 1024 ? MQTT_FRAME_MAX_BYTES + 64 : 1024)
 
 struct MqttConfig {
     bool     enabled;
@@ -0,0 +1,413 @@
+#include "gif_import.h"
+#include "gif_player.h"
+#include "led_effects.h"
+#include "render_task.h"
+#include <LittleFS.h>
+
+#define LZW_MAX_CODES         4096
+#define GIF_MIN_DELAY_MS      20      // shorter (or 0) delays play at the
+#define GIF_DEFAULT_DELAY_MS  100     // browsers' default instead
+
+// ─── Import State ──────────────────────────────────────────────────────────
+// Heap-allocated for the duration of one import.
+
+struct GifImport {
+    uint16_t sw, sh;                     // logical screen size
+    uint8_t *screen;                     // sw * sh clip-palette indices
+    uint8_t *saved;                      // screen before a "restore previous" frame
+
+    uint16_t prefix[LZW_MAX_CODES];
+    uint8_t  suffix[LZW_MAX_CODES];
+    uint8_t  stack[LZW_MAX_CODES + 1];
+
+    uint8_t  gct[256 * 3];               // global colour table
+    uint16_t gctSize;
+    uint8_t  lct[256 * 3];               // current frame's local table
+    uint8_t  colourMap[256];             // frame table index → clip palette
+
+    uint8_t  palette[CLIP_PALETTE * 3];  // clip palette being built
+    uint16_t paletteSize;
+
+    uint8_t  frame[NUM_LEDS];            // scaled output, strip order
+
+    // Sub-block bit reader
+    uint8_t  blockLeft;
+    bool     blocksDone;
+    uint32_t bitBuf;
+    uint8_t  bitCount;
+};
+
+struct ImageDesc {
+    uint16_t left, top, w, h;
+    bool     interlaced;
+};
+
+static inline uint16_t le16(const uint8_t *p) { return p[0] | ((uint16_t)p[1] << 8); }
+
+// ─── Clip Palette ──────────────────────────────────────────────────────────
+
+// Index of (r, g, b) in the clip palette: an exact match, a new entry, or
+// the nearest colour once all 256 are used. Entry 0 is black (background).
+static uint8_t clipColour(GifImport &g, uint8_t r, uint8_t gr, uint8_t b) {
+    for (uint16_t i = 0; i < g.paletteSize; i++) {
+        const uint8_t *p = &g.palette[i * 3];
+        if (p[0] == r && p[1] == gr && p[2] == b) return (uint8_t)i;
+    }
+    if (g.paletteSize < CLIP_PALETTE) {
+        uint8_t *p = &g.palette[g.paletteSize * 3];
+        p[0] = r; p[1] = gr; p[2] = b;
+        return (uint8_t)g.paletteSize++;
+    }
+    uint32_t best = 0xFFFFFFFF;
+    uint8_t  bestIdx = 0;
+    for (uint16_t i = 0; i < CLIP_PALETTE; i++) {
+        const uint8_t *p = &g.palette[i * 3];
+        int32_t dr = (int32_t)p[0] - r, dg = (int32_t)p[1] - gr, db = (int32_t)p[2] - b;
+        uint32_t d = dr * dr + dg * dg + db * db;
+        if (d < best) { best = d; bestIdx = (uint8_t)i; }
+    }
+    return bestIdx;
+}
+
+static void mapColourTable(GifImport &g, const uint8_t *table, uint16_t size) {
+    for (uint16_t i = 0; i < 256; i++) {
+        g.colourMap[i] = (i < size)
+            ? clipColour(g, table[i * 3], table[i * 3 + 1], table[i * 3 + 2])
+            : 0;
+    }
+}
+
+// ─── Stream Helpers ────────────────────────────────────────────────────────
+
+static bool readBytes(File &f, uint8_t *buf, size_t n) {
+    return f.read(buf, n) == n;
+}
+
+// Skip a chain of data sub-blocks, through the zero-length terminator.
+static bool skipSubBlocks(File &f) {
+    for (;;) {
+        int len = f.read();
+        if (len < 0) return false;
+        if (len == 0) return true;
+        if (!f.seek(len, SeekCur)) return false;
+    }
+}
+
+static int nextDataByte(GifImport &g, File &f) {
+    if (g.blockLeft == 0) {
+        if (g.blocksDone) return -1;
+        int len = f.read();
+        if (len <= 0) {
+            g.blocksDone = true;
+            return -1;
+        }
+        g.blockLeft = (uint8_t)len;
+    }
+    g.blockLeft--;
+    return f.read();
+}
+
+// Next LSB-first code of `size` bits, or -1 at the end of the data.
+static int readCode(GifImport &g, File &f, uint8_t size) {
+    while (g.bitCount < size) {
+        int b = nextDataByte(g, f);
+        if (b < 0) return -1;
+        g.bitBuf   |= (uint32_t)b << g.bitCount;
+        g.bitCount += 8;
+    }
+    int code = g.bitBuf & ((1U << size) - 1);
+    g.bitBuf   >>= size;
+    g.bitCount  -= size;
+    return code;
+}
+
+// ─── LZW Image Decode ──────────────────────────────────────────────────────
+
+// Decode one image's pixels onto the screen canvas. Pixels equal to
+// `transparent` (-1 = none) leave the canvas untouched. A truncated
+// stream keeps whatever decoded before it.
+static bool decodeImage(GifImport &g, File &f, const ImageDesc &d, int transparent) {
+    static const uint8_t PASS_START[4] = {0, 4, 2, 1};
+    static const uint8_t PASS_STEP[4]  = {8, 8, 4, 2};
+
+    int minCode = f.read();
+    if (minCode < 2 || minCode > 8) return false;
+
+    const uint16_t clear = 1U << minCode;
+    const uint16_t eoi   = clear + 1;
+    uint8_t  size  = minCode + 1;
+    uint16_t next  = clear + 2;
+    int      old   = -1;
+    uint8_t  first = 0;
+
+    for (uint16_t i = 0; i < clear; i++) {
+        g.prefix[i] = 0;
+        g.suffix[i] = (uint8_t)i;
+    }
+    g.blockLeft  = 0;
+    g.blocksDone = false;
+    g.bitBuf     = 0;
+    g.bitCount   = 0;
+
+    uint32_t remaining = (uint32_t)d.w * d.h;
+    uint16_t col = 0, row = 0;
+    uint8_t  pass = 0;
+
+    for (;;) {
+        int code = readCode(g, f, size);
+        if (code < 0 || code == eoi) break;
+        if (code == clear) {
+            size = minCode + 1;
+            next = clear + 2;
+            old  = -1;
+            continue;
+        }
+
+        uint16_t sp = 0;
+        if (old < 0) {
+            if (code >= clear) break;            // corrupt: no root code
+            g.stack[sp++] = (uint8_t)code;
+            first = (uint8_t)code;
+        } else {
+            int in = code;
+            if (code > next) break;              // corrupt
+            if (code == next) {                  // KwKwK: old string + its first byte
+                g.stack[sp++] = first;
+                code = old;
+            }
+            while (code >= clear && sp < LZW_MAX_CODES) {
+                g.stack[sp++] = g.suffix[code];
+                code = g.prefix[code];
+            }
+            first = (uint8_t)code;
+            g.stack[sp++] = first;
+            if (next < LZW_MAX_CODES) {
+                g.prefix[next] = (uint16_t)old;
+                g.suffix[next] = first;
+                next++;
+                if (next == (1U << size) && size < 12) size++;
+            }
+            code = in;
+        }
+        old = code;
+
+        // Emit the string (stacked last byte first) in raster order
+        while (sp > 0 && remaining > 0) {
+            uint8_t idx = g.stack[--sp];
+            uint16_t sx = d.left + col, sy = d.top + row;
+            if ((int)idx != transparent && sx < g.sw && sy < g.sh) {
+                g.screen[(uint32_t)sy * g.sw + sx] = g.colourMap[idx];
+            }
+            remaining--;
+            if (++col < d.w) continue;
+            col = 0;
+            if (!d.interlaced) {
+                row++;
+            } else {
+                row += PASS_STEP[pass];
+                while (row >= d.h && pass < 3) row = PASS_START[++pass];
+            }
+        }
+    }
+
+    // Skip anything left of the image data
+    while (g.blockLeft > 0) { f.read(); g.blockLeft--; }
+    if (!g.blocksDone) skipSubBlocks(f);
+    return true;
+}
+
+// Nearest-neighbour scale of the screen canvas to the grid, in strip order.
+static void scaleFrame(GifImport &g) {
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        uint32_t sy = (uint32_t)y * g.sh / GRID_HEIGHT;
+        for (uint8_t x = 0; x < GRID_WIDTH; x++) {
+            uint32_t sx = (uint32_t)x * g.sw / GRID_WIDTH;
+            g.frame[screenToIndex(x, y)] = g.screen[sy * g.sw + sx];
+        }
+    }
+}
+
+// ─── Import ────────────────────────────────────────────────────────────────
+
+static uint16_t decodeGif(GifImport &g, File &in, File &out, const char **err) {
+    uint8_t hdr[13];
+    if (!readBytes(in, hdr, sizeof(hdr)) ||
+        memcmp(hdr, "GIF", 3) != 0 || (memcmp(hdr + 3, "87a", 3) != 0 && memcmp(hdr + 3, "89a", 3) != 0)) {
+        *err = "Not a GIF";
+        return 0;
+    }
+    g.sw = le16(hdr + 6);
+    g.sh = le16(hdr + 8);
+    if (g.sw == 0 || g.sh == 0 || g.sw > GIF_MAX_SIDE || g.sh > GIF_MAX_SIDE) {
+        *err = "GIF too large";
+        return 0;
+    }
+    if (hdr[10] & 0x80) {
+        g.gctSize = 2U << (hdr[10] & 7);
+        if (!readBytes(in, g.gct, g.gctSize * 3)) { *err = "Truncated GIF"; return 0; }
+    }
+
+    g.screen = (uint8_t *)calloc((size_t)g.sw * g.sh, 1);
+    if (!g.screen) { *err = "Out of memory"; return 0; }
+
+    g.palette[0] = g.palette[1] = g.palette[2] = 0;
+    g.paletteSize = 1;
+
+    // Header and palette are rewritten once every frame is in
+    uint8_t zero[64] = {0};
+    for (uint16_t n = 0; n < CLIP_FRAMES_AT; n += sizeof(zero)) {
+        size_t chunk = (CLIP_FRAMES_AT - n < sizeof(zero)) ? CLIP_FRAMES_AT - n : sizeof(zero);
+        out.write(zero, chunk);
+    }
+
+    uint16_t frames = 0;
+    uint16_t delayCs = 0;        // graphic control extension for the next image
+    uint8_t  disposal = 0;
+    int      transparent = -1;
+    uint8_t  prevDisposal = 0;
+    ImageDesc prev = {0, 0, 0, 0, false};
+
+    for (;;) {
+        int b = in.read();
+        if (b < 0 || b == 0x3B) break;           // trailer (or truncated: keep what we have)
+
+        if (b == 0x21) {                         // extension
+            int label = in.read();
+            uint8_t gce[6];
+            if (label == 0xF9 && readBytes(in, gce, 6) && gce[0] == 4) {
+                disposal    = (gce[1] >> 2) & 7;
+                transparent = (gce[1] & 1) ? gce[4] : -1;
+                delayCs     = le16(gce + 2);
+                if (gce[5] != 0) skipSubBlocks(in);
+            } else if (label < 0 || !skipSubBlocks(in)) {
+                break;
+            }
+            continue;
+        }
+        if (b != 0x2C) {
+            if (frames == 0) *err = "Corrupt GIF";
+            break;
+        }
+
+        uint8_t id[9];
+        if (!readBytes(in, id, sizeof(id))) break;
+        ImageDesc d = {le16(id), le16(id + 2), le16(id + 4), le16(id + 6), (id[8] & 0x40) != 0};
+
+        // Previous frame's disposal, then save for this one's if needed
+        if (prevDisposal == 2) {
+            for (uint16_t y = prev.top; y < prev.top + prev.h && y < g.sh; y++) {
+                for (uint16_t x = prev.left; x < prev.left + prev.w && x < g.sw; x++) {
+                    g.screen[(uint32_t)y * g.sw + x] = 0;
+                }
+            }
+        } else if (prevDisposal == 3 && g.saved) {
+            memcpy(g.screen, g.saved, (size_t)g.sw * g.sh);
+        }
+        if (disposal == 3) {
+            if (!g.saved) g.saved = (uint8_t *)malloc((size_t)g.sw * g.sh);
+            if (g.saved) memcpy(g.saved, g.screen, (size_t)g.sw * g.sh);
+        }
+
+        if (id[8] & 0x80) {
+            uint16_t lctSize = 2U << (id[8] & 7);
+            if (!readBytes(in, g.lct, lctSize * 3)) break;
+            mapColourTable(g, g.lct, lctSize);
+        } else if (g.gctSize) {
+            mapColourTable(g, g.gct, g.gctSize);
+        } else {
+            *err = "GIF has no colour table";
+            break;
+        }
+
+        if (!decodeImage(g, in, d, transparent)) {
+            if (frames == 0) *err = "Corrupt GIF";
+            break;
+        }
+
+        uint16_t delayMs = delayCs * 10;
+        if (delayMs < GIF_MIN_DELAY_MS) delayMs = GIF_DEFAULT_DELAY_MS;
+        uint8_t delayLe[2] = {(uint8_t)delayMs, (uint8_t)(delayMs >> 8)};
+        scaleFrame(g);
+        if (out.write(delayLe, 2) != 2 || out.write(g.frame, NUM_LEDS) != NUM_LEDS) {
+            *err = "Flash full";
+            return 0;
+        }
+
+        prevDisposal = disposal;
+        prev         = d;
+        delayCs      = 0;
+        disposal     = 0;
+        transparent  = -1;
+        if (++frames >= GIF_MAX_FRAMES) break;
+        yield();
+    }
+
+    if (frames == 0) {
+        if (!*err) *err = "GIF has no frames";
+        return 0;
+    }
+
+    ClipHeader h;
+    h.magic       = CLIP_MAGIC;
+    h.version     = CLIP_VERSION;
+    h.width       = GRID_WIDTH;
+    h.height      = GRID_HEIGHT;
+    h.reserved    = 0;
+    h.frameCount  = frames;
+    h.paletteSize = g.paletteSize;
+    if (!out.seek(0) || out.write((const uint8_t *)&h, sizeof(h)) != sizeof(h) ||
+        out.write(g.palette, sizeof(g.palette)) != sizeof(g.palette)) {
+        *err = "Flash write failed";
+        return 0;
+    }
+    return frames;
+}
+
+uint16_t importGifClip(const char *gifPath, const char **err) {
+    *err = nullptr;
+    if (renderClipInstall() == CLIP_INSTALL_PENDING) { *err = "Previous clip still installing"; return 0; }
+
+    File in = LittleFS.open(gifPath, "r");
+    if (!in) { *err = "Upload missing"; return 0; }
+    File out = LittleFS.open(CLIP_TMP_PATH, "w");
+    if (!out) { in.close(); *err = "Flash write failed"; return 0; }
+
+    GifImport *g = (GifImport *)calloc(1, sizeof(GifImport));
+    uint16_t frames = 0;
+    if (g) {
+        uint32_t startMs = millis();
+        frames = decodeGif(*g, in, out, err);
+        if (frames) {
+            Serial.printf("GIF: %ux%u, %u frames, %u colours, %lu ms\n", g->sw, g->sh,
+                          frames, g->paletteSize, (unsigned long)(millis() - startMs));
+        }
+        free(g->screen);
+        free(g->saved);
+        free(g);
+    } else {
+        *err = "Out of memory";
+    }
+    in.close();
+    out.close();
+
+    if (!frames) {
+        LittleFS.remove(CLIP_TMP_PATH);
+        return 0;
+    }
+
+    // The render task may be reading the old clip: it swaps files between
+    // frames, and reports back
+    if (!renderInstallClip()) {
+        LittleFS.remove(CLIP_TMP_PATH);
+        *err = "Renderer busy";
+        return 0;
+    }
+    uint32_t startMs = millis();
+    ClipInstall result;
+    while ((result = renderClipInstall()) == CLIP_INSTALL_PENDING && millis() - startMs < GIF_INSTALL_WAIT_MS) {
+        delay(5);
+    }
+    if (result == CLIP_INSTALL_PENDING) { *err = "Clip still installing"; return 0; }
+    if (result != CLIP_INSTALL_OK) { *err = "Clip install failed"; return 0; }
+    return frames;
+}
@@ -0,0 +1,25 @@
+#ifndef GIF_IMPORT_H
+#define GIF_IMPORT_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// ─── GIF Import ────────────────────────────────────────────────────────────
+// Turns an uploaded GIF (87a/89a, up to GIF_MAX_SIDE pixels a side) into
+// the clip file gif_player.cpp plays. Each frame is composited at the GIF's
+// own size (disposal and transparency applied), scaled to the grid by
+// nearest neighbour, and written as palette indices in strip order. Frame
+// colour tables are merged into one 256-entry clip palette; once it is
+// full, further colours map to their nearest entry.
+//
+// The LZW tables and canvases are allocated for the import and freed when
+// it returns — none of the decoder is live while the clip plays.
+
+// Decode gifPath into CLIP_TMP_PATH and have the render task install it
+// as the current clip (replacing any old one), waiting up to
+// GIF_INSTALL_WAIT_MS for it to do so. Returns the number of frames, or 0
+// with *err set to a short reason. Refused while an earlier install is
+// still pending, since CLIP_TMP_PATH is still waiting to be renamed.
+uint16_t importGifClip(const char *gifPath, const char **err);
+
+#endif // GIF_IMPORT_H
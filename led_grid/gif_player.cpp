@@ -0,0 +1,120 @@
+#include "gif_player.h"
+#include <LittleFS.h>
+
+#define CLIP_READ_CHUNK  64       // indices per LittleFS read
+#define CLIP_RESYNC_MS   1000     // stalled longer than this: restart timing
+
+static_assert(sizeof(ClipHeader) == 12, "ClipHeader is written to flash as-is");
+
+static File     clip;
+static bool     fsReady     = false;
+static uint16_t frameCount  = 0;
+static uint16_t frameIdx    = 0;          // next frame to show
+static uint32_t nextFrameMs = 0;          // when frameIdx is due
+static bool     timing      = false;      // nextFrameMs is valid
+static uint32_t palette[CLIP_PALETTE];    // 0x00RRGGBB
+
+// Seek to frame f and read its delay, leaving the file at its indices.
+static uint16_t readDelay(uint16_t f) {
+    uint8_t d[2] = {0, 0};
+    clip.seek(CLIP_FRAMES_AT + (uint32_t)f * CLIP_FRAME_BYTES);
+    clip.read(d, 2);
+    return d[0] | ((uint16_t)d[1] << 8);
+}
+
+// ─── Public API ────────────────────────────────────────────────────────────
+
+void setupClipPlayer() {
+    fsReady = LittleFS.begin(true);   // formats the partition on first boot
+    if (!fsReady) {
+        Serial.println(F("Clip: LittleFS mount failed"));
+        return;
+    }
+    if (loadClip()) Serial.printf("Clip: %u frames\n", frameCount);
+}
+
+void unloadClip() {
+    if (clip) clip.close();
+    frameCount = 0;
+}
+
+bool loadClip() {
+    unloadClip();
+    if (!fsReady || !LittleFS.exists(CLIP_PATH)) return false;
+
+    clip = LittleFS.open(CLIP_PATH, "r");
+    if (!clip) return false;
+
+    ClipHeader h;
+    if (clip.read((uint8_t *)&h, sizeof(h)) != sizeof(h) ||
+        h.magic != CLIP_MAGIC || h.version != CLIP_VERSION ||
+        h.width != GRID_WIDTH || h.height != GRID_HEIGHT ||
+        h.frameCount == 0 || h.paletteSize == 0 || h.paletteSize > CLIP_PALETTE ||
+        clip.size() < CLIP_FRAMES_AT + (uint32_t)h.frameCount * CLIP_FRAME_BYTES) {
+        Serial.println(F("Clip: invalid clip file"));
+        clip.close();
+        return false;
+    }
+
+    uint8_t rgb[3];
+    for (uint16_t i = 0; i < CLIP_PALETTE; i++) {
+        if (clip.read(rgb, 3) != 3) rgb[0] = rgb[1] = rgb[2] = 0;
+        palette[i] = ((uint32_t)rgb[0] << 16) | ((uint32_t)rgb[1] << 8) | rgb[2];
+    }
+
+    frameCount = h.frameCount;
+    frameIdx   = 0;
+    timing     = false;
+    return true;
+}
+
+bool installClip() {
+    unloadClip();
+    LittleFS.remove(CLIP_PATH);
+    if (!LittleFS.rename(CLIP_TMP_PATH, CLIP_PATH)) {
+        Serial.println(F("Clip: rename failed"));
+        LittleFS.remove(CLIP_TMP_PATH);
+        return false;
+    }
+    return loadClip();
+}
+
+uint16_t clipFrameCount() {
+    return frameCount;
+}
+
+void updateClip(Canvas &strip) {
+    if (frameCount == 0) {
+        strip.clear();
+        strip.show();
+        return;
+    }
+
+    uint32_t now = millis();
+    if (timing && (int32_t)(now - nextFrameMs) < 0) return;   // current frame holds
+    if (!timing || now - nextFrameMs > CLIP_RESYNC_MS) {
+        nextFrameMs = now;
+        timing      = true;
+    }
+
+    // Behind schedule (delays shorter than the render interval): skip
+    // frames whose slot has already passed, reading only their delay
+    uint16_t delayMs = readDelay(frameIdx);
+    for (uint16_t n = 1; n < frameCount && (int32_t)(now - (nextFrameMs + delayMs)) >= 0; n++) {
+        nextFrameMs += delayMs;
+        frameIdx     = (frameIdx + 1) % frameCount;
+        delayMs      = readDelay(frameIdx);
+    }
+
+    uint8_t buf[CLIP_READ_CHUNK];
+    for (uint16_t i = 0; i < NUM_LEDS; ) {
+        uint16_t n = (NUM_LEDS - i < CLIP_READ_CHUNK) ? NUM_LEDS - i : CLIP_READ_CHUNK;
+        if (clip.read(buf, n) != n) break;
+        for (uint16_t j = 0; j < n; j++) strip.setPixelColor(i + j, palette[buf[j]]);
+        i += n;
+    }
+    strip.show();
+
+    nextFrameMs += delayMs;
+    frameIdx     = (frameIdx + 1) % frameCount;
+}
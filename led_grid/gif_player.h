@@ -0,0 +1,59 @@
+#ifndef GIF_PLAYER_H
+#define GIF_PLAYER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "led_effects.h"
+
+// ─── Clip Playback ─────────────────────────────────────────────────────────
+// Plays the clip file gif_import.cpp builds from an uploaded GIF. The GIF is
+// decoded once, at upload; playback only reads pre-rendered frames:
+//
+//   ClipHeader | palette (256 x RGB) | frame 0 | frame 1 | ...
+//   frame = uint16 delay (ms, little-endian) + NUM_LEDS palette indices
+//
+// Indices are stored in strip order, so a frame is one sequential read
+// from LittleFS and a palette lookup per LED into the base layer. RAM use
+// is the 1 KB palette plus a small read buffer, whatever the clip length.
+
+#define CLIP_PATH        "/clip.bin"
+#define CLIP_TMP_PATH    "/clip.tmp"     // import output until installClip()
+#define CLIP_MAGIC       0x50494C43UL    // "CLIP"
+#define CLIP_VERSION     1
+#define CLIP_PALETTE     256
+
+struct ClipHeader {
+    uint32_t magic;
+    uint8_t  version;
+    uint8_t  width;            // GRID_WIDTH / GRID_HEIGHT at import
+    uint8_t  height;
+    uint8_t  reserved;
+    uint16_t frameCount;
+    uint16_t paletteSize;      // used entries (1-256)
+};
+
+#define CLIP_FRAME_BYTES  (2 + NUM_LEDS)
+#define CLIP_FRAMES_AT    (sizeof(ClipHeader) + CLIP_PALETTE * 3)
+
+// Mount LittleFS and open the stored clip, if any. Call once from setup().
+void setupClipPlayer();
+
+// (Re)open CLIP_PATH after an upload. Returns false if there is no valid clip.
+bool loadClip();
+
+// Close the clip file (before it is replaced).
+void unloadClip();
+
+// Replace CLIP_PATH with CLIP_TMP_PATH and open it. Runs on the render
+// task, between frames (see renderInstallClip()). Returns false if the
+// rename failed or the new clip is invalid; there is no clip then.
+bool installClip();
+
+// Frames in the loaded clip, 0 if none.
+uint16_t clipFrameCount();
+
+// Show the frame due now (EFFECT_GIF). Holds each frame for its recorded
+// delay, skipping frames if the render loop fell behind.
+void updateClip(Canvas &strip);
+
+#endif // GIF_PLAYER_H
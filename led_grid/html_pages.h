@@ -110,6 +110,8 @@ static const char DASHBOARD_PAGE[] PROGMEM = R"rawliteral(
 <div class="status-bar">
   <span><span class="dot dot-green" id="wsDot"></span> <span id="uptime">—</span></span>
   <span>Heap: <span id="heap">—</span></span>
+  <span>MQTT: <span id="mqtt">—</span></span>
+  <span>Late frames: <span id="late">—</span></span>
   <span><span id="ip">—</span></span>
 </div>
 </div>
@@ -150,9 +152,22 @@ static const char DASHBOARD_PAGE[] PROGMEM = R"rawliteral(
   <button class="btn-effect" data-e="14" id="eff14">🌀 Plasma</button>
   <button class="btn-effect" data-e="15" id="eff15">🌀 Spiral</button>
   <button class="btn-effect" data-e="16" id="eff16">💕 Valentine</button>
+  <button class="btn-effect" data-e="18" id="eff18">📡 Live</button>
+  <button class="btn-effect" data-e="19" id="eff19">🎞 GIF</button>
+  <button class="btn-effect" data-e="20" id="eff20">🔥 Noise Fire</button>
+  <button class="btn-effect" data-e="21" id="eff21">🌌 Noise Aurora</button>
+  <button class="btn-effect" data-e="22" id="eff22">🫧 Noise Lava</button>
+  <button class="btn-effect" data-e="23" id="eff23">🕯 Noise Candle</button>
 </div>
 </div>
 
+<div class="card">
+<h2>🎞 GIF Clip</h2>
+<p style="font-size:0.8em;color:#8888aa;margin-bottom:8px">Animated GIF, scaled to the grid. <span id="clipInfo"></span></p>
+<input type="file" id="gifFile" accept=".gif,image/gif" style="margin-bottom:8px;color:#e0e0e8">
+<button class="btn-primary btn-full" id="gifBtn" onclick="uploadGif()">Upload &amp; Play</button>
+</div>
+
 <div class="card" id="aiCard">
 <h2>AI Tuning</h2>
 <label>Skill Level</label>
@@ -255,42 +270,97 @@ function saveAll(){
   post('/api/save','',function(ok){toast(ok?'Settings saved!':'Save failed',!ok)});
 }
 
-// Status polling
-function poll(){
-  fetch('/api/status').then(function(r){
-    if(r.status===401){location.href='/login';return}
-    return r.json();
-  }).then(function(d){
-    if(!d)return;
-    document.getElementById('uptime').textContent=d.uptime;
-    document.getElementById('heap').textContent=Math.round(d.freeHeap/1024)+'KB';
-    document.getElementById('ip').textContent=d.ip;
-    if(Date.now()-lastTouch>3000){
-      brSlider.value=d.brightness;brVal.textContent=d.brightness;
-      skillSlider.value=d.aiSkillPct;skillVal.textContent=d.aiSkillPct+'%';
-      speedSlider.value=d.dropStartMs;speedVal.textContent=d.dropStartMs;
-      document.getElementById('bgR').value=d.bgR;
-      document.getElementById('bgG').value=d.bgG;
-      document.getElementById('bgB').value=d.bgB;
-    }
+function uploadGif(){
+  var f=document.getElementById('gifFile').files[0];
+  if(!f)return;
+  var btn=document.getElementById('gifBtn');
+  var x=new XMLHttpRequest();var fd=new FormData();
+  fd.append('gif',f);
+  btn.disabled=true;btn.textContent='Converting...';
+  x.onload=function(){
+    btn.disabled=false;btn.textContent='Upload & Play';
+    var r={};try{r=JSON.parse(x.responseText)}catch(e){}
+    if(x.status!==200){toast(r.error||'Upload failed',true);return}
+    toast(r.frames+' frames loaded');
+    post('/api/effect','value=19');
+  };
+  x.onerror=function(){btn.disabled=false;btn.textContent='Upload & Play';toast('Upload failed',true)};
+  x.open('POST','/api/gif');
+  x.send(fd);
+}
+
+// Live status: the WebSocket pushes a full snapshot, then only the fields
+// that change. /api/status is polled only while the socket is down.
+var st={},sliderT=null;
+function el(id){return document.getElementById(id)}
+function upText(s){return Math.floor(s/86400)+'d '+Math.floor(s%86400/3600)+'h '+Math.floor(s%3600/60)+'m'}
+function showSliders(){
+  if(Date.now()-lastTouch<3000){clearTimeout(sliderT);sliderT=setTimeout(showSliders,3000);return}
+  brSlider.value=st.brightness;brVal.textContent=st.brightness;
+  skillSlider.value=st.aiSkillPct;skillVal.textContent=st.aiSkillPct+'%';
+  speedSlider.value=st.dropStartMs;speedVal.textContent=st.dropStartMs;
+  el('bgR').value=st.bgR;el('bgG').value=st.bgG;el('bgB').value=st.bgB;
+}
+function show(d){
+  for(var k in d)st[k]=d[k];
+  if('uptimeS' in d)el('uptime').textContent=upText(d.uptimeS);
+  if(d.uptime)el('uptime').textContent=d.uptime;
+  if('freeHeap' in d)el('heap').textContent=Math.round(d.freeHeap/1024)+'KB';
+  if(d.ip)el('ip').textContent=d.ip;
+  if('mqttConnected' in d)el('mqtt').textContent=d.mqttConnected?'up':'down';
+  if('deadlineMisses' in d)el('late').textContent=d.deadlineMisses;
+  if('clipFrames' in d)el('clipInfo').textContent=d.clipFrames?d.clipFrames+' frames stored':'No clip stored';
+  if('effect' in d){
     var games=[0,17];
-    for(var i=0;i<18;i++){
-      var el=document.getElementById('eff'+i);
-      if(el){
+    for(var i=0;i<24;i++){
+      var b=el('eff'+i);
+      if(b){
         var cls='btn-effect';
         if(games.indexOf(i)>=0)cls+=' btn-game';
         if(d.effect===i)cls+=' active';
-        el.className=cls;
+        b.className=cls;
       }
     }
-    var pb=document.getElementById('playBtn');
-    if(pb){
-      pb.style.display=(games.indexOf(d.effect)>=0)?'block':'none';
-    }
-  }).catch(function(){});
+    var pb=el('playBtn');
+    if(pb)pb.style.display=(games.indexOf(d.effect)>=0)?'block':'none';
+  }
+  if(st.brightness!==undefined)showSliders();
 }
-setInterval(poll,3000);
-poll();
+
+function poll(){
+  fetch('/api/status').then(function(r){
+    if(r.status===401){location.href='/login';return}
+    return r.json();
+  }).then(function(d){if(d)show(d)}).catch(function(){});
+}
+var pollT=null;
+function startPoll(){if(!pollT){poll();pollT=setInterval(poll,3000)}}
+function stopPoll(){clearInterval(pollT);pollT=null}
+
+var ws=null,wsToken='';
+function setDot(c){el('wsDot').className='dot dot-'+c}
+function connect(){
+  if(!wsToken){
+    fetch('/api/ws-token').then(function(r){
+      if(r.status===401){location.href='/login';return}
+      return r.json();
+    }).then(function(d){
+      if(d&&d.token){wsToken=d.token;connect()}
+    }).catch(function(){startPoll();setTimeout(connect,5000)});
+    return;
+  }
+  ws=new WebSocket('ws://'+location.hostname+':81/');
+  ws.onopen=function(){setDot('amber');ws.send(JSON.stringify({cmd:'auth',token:wsToken}))};
+  ws.onmessage=function(e){
+    var d;try{d=JSON.parse(e.data)}catch(ex){return}
+    if(d.auth===true){ws.send(JSON.stringify({cmd:'status'}));return}
+    if(d.auth===false){wsToken='';ws.close();return}
+    if(d.status){setDot('green');stopPoll();show(d.status)}
+  };
+  ws.onclose=function(){setDot('red');startPoll();setTimeout(connect,5000)};
+  ws.onerror=function(){ws.close()};
+}
+connect();
 </script>
 </body></html>
 )rawliteral";
@@ -721,9 +791,9 @@ static const char UPDATE_PAGE[] PROGMEM = R"rawliteral(
 <div class="container">
 <h1><a href="/settings" style="text-decoration:none">←</a> Firmware Update</h1>
 <div class="card">
-<p style="color:#8888aa;margin-bottom:12px">Select a .bin firmware file to upload.</p>
+<p style="color:#8888aa;margin-bottom:12px">Select a .bin firmware file, or the smaller .bin.hs that build.sh makes of it.</p>
 <form method="POST" action="/update" enctype="multipart/form-data" id="uploadForm">
-<input type="file" name="firmware" accept=".bin" id="fileInput"
+<input type="file" name="firmware" accept=".bin,.hs" id="fileInput"
   style="margin-bottom:12px;color:#e0e0e8">
 <button type="submit" class="btn-primary btn-full" id="uploadBtn">Upload</button>
 </form>
@@ -752,8 +822,10 @@ document.getElementById('uploadForm').onsubmit=function(e){
     }
   };
   xhr.onload=function(){
-    document.getElementById('pctText').textContent='Done! Rebooting...';
-    setTimeout(function(){location.href='/'},5000);
+    var d=document.createElement('div');d.innerHTML=xhr.responseText;
+    var h=d.querySelector('h2'),p=d.querySelector('p');
+    document.getElementById('pctText').textContent=(h?h.textContent:'Upload failed')+(p?' '+p.textContent:'');
+    if(xhr.status==200)setTimeout(function(){location.href='/'},5000);
   };
   xhr.open('POST','/update');
   xhr.send(fd);
@@ -0,0 +1,102 @@
+#include "json_stream.h"
+
+JsonStream::JsonStream(WebServer &server) : server(server) {
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "application/json", "");
+}
+
+// ─── Structure ─────────────────────────────────────────────────────────────
+
+void JsonStream::member(const char *key) {
+    uint32_t bit = 1UL << depth;
+    if (hasItems & bit) put(',');
+    hasItems |= bit;
+    if (key) {
+        putString(key);
+        put(':');
+    }
+}
+
+void JsonStream::open(const char *key, char c) {
+    if (depth > 0) member(key);
+    put(c);
+    if (depth < 31) depth++;
+    hasItems &= ~(1UL << depth);
+}
+
+void JsonStream::close(char c) {
+    put(c);
+    if (depth > 0) depth--;
+}
+
+void JsonStream::beginObject(const char *key) { open(key, '{'); }
+void JsonStream::endObject()                  { close('}'); }
+void JsonStream::beginArray(const char *key)  { open(key, '['); }
+void JsonStream::endArray()                   { close(']'); }
+
+// ─── Values ────────────────────────────────────────────────────────────────
+
+void JsonStream::add(const char *key, const char *value) {
+    member(key);
+    putString(value ? value : "");
+}
+
+void JsonStream::add(const char *key, bool value) {
+    member(key);
+    put(value ? "true" : "false");
+}
+
+void JsonStream::addSigned(const char *key, long value) {
+    char num[12];
+    snprintf(num, sizeof(num), "%ld", value);
+    member(key);
+    put(num);
+}
+
+void JsonStream::addUnsigned(const char *key, unsigned long value) {
+    char num[12];
+    snprintf(num, sizeof(num), "%lu", value);
+    member(key);
+    put(num);
+}
+
+// ─── Output ────────────────────────────────────────────────────────────────
+
+void JsonStream::put(char c) {
+    if (len == sizeof(buf)) flush();
+    buf[len++] = c;
+}
+
+void JsonStream::put(const char *s) {
+    while (*s) put(*s++);
+}
+
+void JsonStream::putString(const char *s) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    put('"');
+    for (; *s; s++) {
+        uint8_t c = *s;
+        if (c == '"' || c == '\\') {
+            put('\\');
+            put((char)c);
+        } else if (c < 0x20) {
+            put("\\u00");
+            put(HEX_DIGITS[c >> 4]);
+            put(HEX_DIGITS[c & 0x0F]);
+        } else {
+            put((char)c);
+        }
+    }
+    put('"');
+}
+
+void JsonStream::flush() {
+    if (len == 0) return;
+    server.sendContent(buf, len);
+    len = 0;
+}
+
+void JsonStream::finish() {
+    flush();
+    server.sendContent("");     // zero-length chunk ends the response
+}
@@ -0,0 +1,71 @@
+#ifndef JSON_STREAM_H
+#define JSON_STREAM_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+
+// ─── Streaming JSON Responses ──────────────────────────────────────────────
+// Writes a JSON response straight to the client as it is built. Output
+// collects in a JSON_STREAM_CHUNK buffer that goes out as one HTTP chunk
+// each time it fills, so a response of any size needs only that buffer,
+// and the first bytes leave before the last ones are formatted.
+//
+//   JsonStream json(server);             // 200, application/json
+//   json.beginObject();
+//   json.add("brightness", cfg.brightness);
+//   json.beginArray("hist");
+//   for (...) json.add(count);           // array elements take no key
+//   json.endArray();
+//   json.endObject();
+//   json.finish();
+//
+// Strings are escaped. Containers nest up to 30 deep.
+
+#define JSON_STREAM_CHUNK 512
+
+class JsonStream {
+public:
+    explicit JsonStream(WebServer &server);
+
+    void beginObject(const char *key = nullptr);
+    void endObject();
+    void beginArray(const char *key = nullptr);
+    void endArray();
+
+    // Object members
+    void add(const char *key, const char *value);
+    void add(const char *key, bool value);
+    void add(const char *key, int value)           { addSigned(key, value); }
+    void add(const char *key, long value)          { addSigned(key, value); }
+    void add(const char *key, unsigned int value)  { addUnsigned(key, value); }
+    void add(const char *key, unsigned long value) { addUnsigned(key, value); }
+
+    // Array elements
+    void add(const char *value)   { add(nullptr, value); }
+    void add(int value)           { addSigned(nullptr, value); }
+    void add(long value)          { addSigned(nullptr, value); }
+    void add(unsigned int value)  { addUnsigned(nullptr, value); }
+    void add(unsigned long value) { addUnsigned(nullptr, value); }
+
+    // Send what is buffered and end the response.
+    void finish();
+
+private:
+    WebServer &server;
+    char       buf[JSON_STREAM_CHUNK];
+    uint16_t   len      = 0;
+    uint8_t    depth    = 0;
+    uint32_t   hasItems = 0;   // bit d: the container at depth d has an element
+
+    void addSigned(const char *key, long value);
+    void addUnsigned(const char *key, unsigned long value);
+    void member(const char *key);          // separator and "key":
+    void open(const char *key, char c);
+    void close(char c);
+    void put(char c);
+    void put(const char *s);
+    void putString(const char *s);
+    void flush();
+};
+
+#endif // JSON_STREAM_H
@@ -4,19 +4,51 @@
 #include <Arduino.h>
 #include <Adafruit_NeoPixel.h>
 #include "config.h"
+#include <pixel_kernels.h>
+#include <layer_compositor.h>
+#include <game_controller.h>
+
+// Effects draw into compositor.base; overlays and the one show() per frame
+// happen in compositor.composite().
+typedef LayerCompositor<ScreenGeometry> Compositor;
+typedef Compositor::Canvas Canvas;
+
+extern Compositor compositor;
+
+// The Tetris and Snake engines, specialised on this sketch's grid.
+typedef GameController<GridGeometry> Games;
+
+extern Games games;
+
+// The game an effect plays, LED_GAME_NONE for the rest.
+inline LedGame gameFor(Effect effect) {
+    return effect == EFFECT_TETRIS ? LED_GAME_TETRIS :
+           effect == EFFECT_SNAKE  ? LED_GAME_SNAKE  : LED_GAME_NONE;
+}
 
 // Initialise the LED strip.
 void initLeds(Adafruit_NeoPixel &strip);
 
-// Run one frame of the current effect. Call from loop() at LED_UPDATE_INTERVAL_MS.
-void updateEffect(Adafruit_NeoPixel &strip, Effect effect);
+// Seed every effect's PRNG (and the Tetris/Snake engines). A fixed seed
+// makes frame output deterministic; setup() passes esp_random().
+void seedEffects(uint32_t seed);
+
+// Run one frame of the current effect into the compositor's base layer.
+// Call from loop() at LED_UPDATE_INTERVAL_MS.
+void updateEffect(Canvas &strip, Effect effect);
 
-// Convert (x, y) grid coordinates to the linear LED index,
-// accounting for serpentine wiring.
-uint16_t xyToIndex(uint8_t x, uint8_t y);
+// Convert (x, y) grid coordinates to the linear LED index, accounting for
+// wiring and mounting (GridGeometry in config.h). Inline so constant
+// coordinates fold at compile time.
+inline uint16_t xyToIndex(uint8_t x, uint8_t y) {
+    return GridGeometry::index(x, y);
+}
 
-// HSV-like colour wheel: 0-255 maps to full hue rotation (R→G→B→R)
-uint32_t colourWheel(uint8_t pos);
+// Convert screen coordinates (top-left as the viewer sees it) to the
+// linear LED index (ScreenGeometry in config.h). Used by overlays and text.
+inline uint16_t screenToIndex(uint8_t x, uint8_t y) {
+    return ScreenGeometry::index(x, y);
+}
 
 // Cycle to the next effect. Returns the new effect.
 Effect nextEffect(Effect current);
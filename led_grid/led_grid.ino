@@ -25,12 +25,17 @@
 #include "config.h"
 #include "persistence.h"
 #include "led_effects.h"
-#include "tetris_effect.h"
-#include "snake_game.h"
+#include <LedCore.h>
 #include "wifi_setup.h"
 #include "web_server.h"
 #include "websocket_handler.h"
 #include "mqtt_client.h"
+#include "udp_input.h"
+#include "gif_player.h"
+#include "power_limit.h"
+#include "perf_stats.h"
+#include "trace_log.h"
+#include "render_task.h"
 
 // ─── Hardware ──────────────────────────────────────────────────────────────
 Adafruit_NeoPixel strip(NUM_LEDS, LED_PIN, LED_TYPE);
@@ -72,27 +77,35 @@ void setup() {
     // Initialise the LED strip
     initLeds(strip);
     strip.setBrightness(gridConfig.brightness);
+    initPowerLimit();
+
+    // Seed effect/game PRNGs from the hardware RNG (fixed seeds replay frames)
+    seedEffects(esp_random());
 
     // Apply config to game engines and clock
-    setTetrisConfig(gridConfig);
-    resetTetris();
+    games.configure(gridConfig);
+    games.tetris.reset();
+    games.snake.reset();
     setClockUse24Hour(gridConfig.use24Hour);
     setClockTransition(gridConfig.clockTransition);
     setClockFadeMs(gridConfig.clockFadeMs);
     setClockMinMarker(gridConfig.clockMinMarker);
     setClockDigitColour(gridConfig.clockDigitColour);
     setClockTrail(gridConfig.clockTrail);
-    setSnakeConfig(gridConfig);
-    resetSnake();
     setWsActiveEffect(gridConfig.currentEffect);
+    setupClipPlayer();
 
     // WiFi setup (shows animation on grid during AP mode)
     setupWiFi(strip);
 
     // Web server + WebSocket + MQTT
     setupWebServer(gridConfig);
-    setupWebSocket();
+    setupWebSocket(gridConfig);
     setupMqtt(gridConfig);
+    if (UDP_INPUT) setupUdpInput();
+
+    // Rendering runs in its own task from here on; loop() only posts to it
+    startRenderTask(strip, gridConfig);
 
     Serial.printf("Grid: %dx%d (%d LEDs), brightness: %d\n",
                   GRID_WIDTH, GRID_HEIGHT, NUM_LEDS, gridConfig.brightness);
@@ -102,21 +115,27 @@ void setup() {
 }
 
 // ─── Loop ──────────────────────────────────────────────────────────────────
+// Network and persistence only: effects, overlays and strip.show() run in
+// the render task (render_task.cpp), which picks up changes from here.
 void loop() {
-    static unsigned long lastUpdateMs = 0;
-    static uint8_t lastBrightness = 0;
     unsigned long now = millis();
+    uint32_t loopStartUs = micros();
+    uint32_t loopStartCycles = tracePassStart(TRACE_LANE_LOOP);
 
     // Handle web server + WebSocket + MQTT
+    uint32_t t = loopStartUs;
     loopWebServer();
+    t = perfLap(PERF_WEB, t);
     loopWebSocket();
+    t = perfLap(PERF_WEBSOCKET, t);
     loopMqtt();
+    perfLap(PERF_MQTT, t);
 
-    // Apply brightness changes from web UI
-    if (gridConfig.brightness != lastBrightness) {
-        strip.setBrightness(gridConfig.brightness);
-        lastBrightness = gridConfig.brightness;
-    }
+    // Hand brightness/tuning/clock changes from the handlers to the renderer
+    syncRenderSettings(gridConfig);
+
+    // Write settings to NVS once they have settled
+    loopPersistence();
 
     // Check for button press (debounced)
     if (buttonFlag) {
@@ -124,24 +143,13 @@ void loop() {
         if (now - lastButtonMs > 300) {
             lastButtonMs = now;
             gridConfig.currentEffect = nextEffect(gridConfig.currentEffect);
-            strip.clear();
-            strip.show();
             setWsActiveEffect(gridConfig.currentEffect);
-            if (gridConfig.currentEffect == EFFECT_TETRIS) {
-                setManualMode(false);
-                resetTetris();
-            } else if (gridConfig.currentEffect == EFFECT_SNAKE) {
-                setSnakeManualMode(false);
-                resetSnake();
-            }
+            renderSetEffect(gridConfig.currentEffect, true);
             mqttPublishState();
             Serial.printf("Effect: %d/%d\n", gridConfig.currentEffect, EFFECT_COUNT);
         }
     }
 
-    // Update LEDs at target frame rate
-    if (now - lastUpdateMs >= LED_UPDATE_INTERVAL_MS) {
-        lastUpdateMs = now;
-        updateEffect(strip, gridConfig.currentEffect);
-    }
+    uint32_t loopEndUs = perfLap(PERF_LOOP, loopStartUs);
+    if (loopEndUs - loopStartUs >= TRACE_STALL_MS * 1000UL) traceStall(loopStartCycles);
 }
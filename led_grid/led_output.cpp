@@ -0,0 +1,122 @@
+#include "led_output.h"
+#include "led_effects.h"
+#include <driver/rmt_tx.h>
+#include <driver/rmt_encoder.h>
+
+static_assert(sizeof(WALL_LAYOUT) / sizeof(WALL_LAYOUT[0]) == NUM_TILES,
+              "WALL_LAYOUT needs one entry per panel (TILES_X * TILES_Y)");
+
+// ─── WS2812 Timing ─────────────────────────────────────────────────────────
+// 40 MHz RMT tick (25 ns). Same bit timings Adafruit_NeoPixel uses.
+#define RMT_RESOLUTION_HZ  40000000
+#define RMT_T0H            16      // 400 ns
+#define RMT_T0L            34      // 850 ns
+#define RMT_T1H            32      // 800 ns
+#define RMT_T1L            18      // 450 ns
+#define RMT_MEM_SYMBOLS    48      // one memory block per channel (C3: 2 x 48)
+#define RMT_LATCH_US       300     // low time between frames (WS2812B latch)
+
+// Bytes per pixel on the wire: RGBW types give white its own byte offset
+// (same test as Adafruit_NeoPixel::updateType()).
+#define OUTPUT_BPP  ((((LED_TYPE) >> 6 & 3) == ((LED_TYPE) >> 4 & 3)) ? 3 : 4)
+
+// ─── Channel State ─────────────────────────────────────────────────────────
+
+static rmt_channel_handle_t channels[NUM_OUTPUTS];
+static rmt_encoder_handle_t encoders[NUM_OUTPUTS];
+static uint16_t spanFirst[NUM_OUTPUTS];   // strip span per output
+static uint16_t spanCount[NUM_OUTPUTS];
+
+// Wire-order copy of the frame being transmitted, so the strip buffer is
+// free for the next frame while the RMT is still reading this one.
+static uint8_t  txBuf[NUM_LEDS * OUTPUT_BPP];
+static bool     outputReady = false;
+static bool     txBusy      = false;
+static uint32_t txDoneUs    = 0;
+
+// Block until the previous frame has left every channel.
+static void waitIdle() {
+    if (!txBusy) return;
+    for (uint8_t o = 0; o < NUM_OUTPUTS; o++) {
+        if (channels[o]) rmt_tx_wait_all_done(channels[o], 100);
+    }
+    txBusy   = false;
+    txDoneUs = micros();
+}
+
+static bool claimChannel(uint8_t o, const rmt_bytes_encoder_config_t &enc) {
+    rmt_tx_channel_config_t cfg = {};
+    cfg.gpio_num          = (gpio_num_t)OUTPUT_PINS[o];
+    cfg.clk_src           = RMT_CLK_SRC_DEFAULT;
+    cfg.resolution_hz     = RMT_RESOLUTION_HZ;
+    cfg.mem_block_symbols = RMT_MEM_SYMBOLS;
+    cfg.trans_queue_depth = 1;
+
+    if (rmt_new_tx_channel(&cfg, &channels[o]) != ESP_OK) {
+        channels[o] = nullptr;
+        return false;
+    }
+    if (rmt_new_bytes_encoder(&enc, &encoders[o]) != ESP_OK ||
+        rmt_enable(channels[o]) != ESP_OK) {
+        if (encoders[o]) rmt_del_encoder(encoders[o]);
+        rmt_del_channel(channels[o]);
+        channels[o] = nullptr;
+        encoders[o] = nullptr;
+        return false;
+    }
+    return true;
+}
+
+// ─── Public API ────────────────────────────────────────────────────────────
+
+void initOutput(Adafruit_NeoPixel &strip) {
+    (void)strip;
+    if (NUM_TILES <= 1) return;
+
+    WallGeometry::build(WALL_LAYOUT);
+
+    rmt_bytes_encoder_config_t enc = {};
+    enc.bit0.level0    = 1;
+    enc.bit0.duration0 = RMT_T0H;
+    enc.bit0.level1    = 0;
+    enc.bit0.duration1 = RMT_T0L;
+    enc.bit1.level0    = 1;
+    enc.bit1.duration0 = RMT_T1H;
+    enc.bit1.level1    = 0;
+    enc.bit1.duration1 = RMT_T1L;
+    enc.flags.msb_first = 1;
+
+    for (uint8_t o = 0; o < NUM_OUTPUTS; o++) {
+        WallGeometry::outputSpan(WALL_LAYOUT, o, spanFirst[o], spanCount[o]);
+        if (spanCount[o] == 0) continue;
+        if (!claimChannel(o, enc)) {
+            Serial.printf("Output %u: no RMT channel for GPIO%u\n", o, OUTPUT_PINS[o]);
+            continue;
+        }
+        Serial.printf("Output %u: GPIO%u, LEDs %u-%u\n", o, OUTPUT_PINS[o],
+                      spanFirst[o], spanFirst[o] + spanCount[o] - 1);
+    }
+
+    outputReady = true;
+    compositor.setFramePresenter(showOutput);
+}
+
+void showOutput(Adafruit_NeoPixel &strip) {
+    if (!outputReady) {
+        strip.show();
+        return;
+    }
+
+    waitIdle();
+    memcpy(txBuf, strip.getPixels(), sizeof(txBuf));
+    while (micros() - txDoneUs < RMT_LATCH_US) {}
+
+    // Queue every channel before waiting on any: they transmit concurrently
+    rmt_transmit_config_t tx = {};
+    for (uint8_t o = 0; o < NUM_OUTPUTS; o++) {
+        if (!channels[o]) continue;
+        rmt_transmit(channels[o], encoders[o], txBuf + (size_t)spanFirst[o] * OUTPUT_BPP,
+                     (size_t)spanCount[o] * OUTPUT_BPP, &tx);
+    }
+    txBusy = true;
+}
@@ -0,0 +1,25 @@
+#ifndef LED_OUTPUT_H
+#define LED_OUTPUT_H
+
+#include <Arduino.h>
+#include <Adafruit_NeoPixel.h>
+#include "config.h"
+
+// ─── Parallel Output ───────────────────────────────────────────────────────
+// Drives a tiled wall (config.h Panel Tiling). The strip object still holds
+// the whole frame; each OUTPUT_PINS entry gets its own RMT TX channel and
+// sends its span of the strip buffer. All channels start together, so a
+// frame takes as long as the longest chain rather than the sum of them, and
+// the data is copied out first so the next frame can be drawn while the
+// previous one is still on the wire.
+//
+// With a single panel this is a no-op and the strip drives LED_PIN itself.
+
+// Compile the wall layout and claim the RMT channels. Call before the
+// first frame; installs the compositor's frame presenter.
+void initOutput(Adafruit_NeoPixel &strip);
+
+// Send the strip's current pixel buffer on every output.
+void showOutput(Adafruit_NeoPixel &strip);
+
+#endif // LED_OUTPUT_H
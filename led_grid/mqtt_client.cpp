@@ -1,11 +1,14 @@
 #include "mqtt_client.h"
 #include "persistence.h"
 #include "led_effects.h"
-#include "tetris_effect.h"
-#include "snake_game.h"
+#include "render_task.h"
+#include "power_limit.h"
+#include "perf_stats.h"
+#include "trace_log.h"
 #include <WiFi.h>
 #include <PubSubClient.h>
 #include <ArduinoJson.h>
+#include <LedCore.h>
 
 // ─── State ────────────────────────────────────────────────────────────────
 static WiFiClient   mqttWifi;
@@ -21,12 +24,21 @@ static char topicState[40];      // ledgrid/<ID>/light/state
 static char topicCmd[40];        // ledgrid/<ID>/light/set
 static char topicDiscovery[64];  // homeassistant/light/ledgrid_<ID>/config
 static char topicDiagnostics[40]; // ledgrid/<ID>/diagnostics
+static char topicOverlay[40];    // ledgrid/<ID>/overlay/set
+static char topicFrame[40];      // ledgrid/<ID>/frame
 
 // Reconnection with exponential backoff
 static unsigned long lastReconnectMs = 0;
 static unsigned long reconnectInterval = 5000;
 static const unsigned long RECONNECT_CAP = 60000;
 
+// Connect bookkeeping; announceNext is the next post-connect publish
+// (ANNOUNCE_DONE once the device is fully announced)
+static const uint8_t ANNOUNCE_DONE = 0xFF;
+static uint8_t       announceNext = ANNOUNCE_DONE;
+static unsigned long connectStartMs = 0;
+static MqttStats     stats;
+
 // Heartbeat
 static unsigned long lastHeartbeatMs = 0;
 static const unsigned long HEARTBEAT_INTERVAL = 60000;
@@ -40,10 +52,6 @@ static bool    forcePublish      = false;
 // "OFF" stores previous brightness so ON can restore it
 static uint8_t priorBrightness = 0;
 
-// Debounced persistence for MQTT-driven changes
-static bool          mqttDirty    = false;
-static unsigned long lastDirtyMs  = 0;
-
 // ─── Helpers ──────────────────────────────────────────────────────────────
 
 static void buildDeviceId() {
@@ -58,6 +66,8 @@ static void buildTopics() {
     snprintf(topicCmd,         sizeof(topicCmd),          "ledgrid/%s/light/set",     deviceId);
     snprintf(topicDiscovery,   sizeof(topicDiscovery),   "homeassistant/light/ledgrid_%s/config", deviceId);
     snprintf(topicDiagnostics, sizeof(topicDiagnostics), "ledgrid/%s/diagnostics",   deviceId);
+    snprintf(topicOverlay,     sizeof(topicOverlay),     "ledgrid/%s/overlay/set",   deviceId);
+    snprintf(topicFrame,       sizeof(topicFrame),       "ledgrid/%s/frame",         deviceId);
 }
 
 // ─── Publish ──────────────────────────────────────────────────────────────
@@ -75,20 +85,18 @@ static void publishStateInternal() {
         return;
     }
     forcePublish = false;
+    TraceScope trace(TRACE_MQTT_PUBLISH, TRACE_PUB_STATE);
 
     const char *effectName = "Tetris";
     if (cfgPtr->currentEffect < EFFECT_COUNT) {
         effectName = EFFECT_NAMES[cfgPtr->currentEffect];
     }
 
-    JsonDocument doc;
-    doc["state"]      = isOn ? "ON" : "OFF";
-    doc["brightness"] = cfgPtr->brightness;
-    doc["color_mode"] = "brightness";
-    doc["effect"]     = effectName;
-
+    // Effect names need no escaping, so no JsonDocument (and no heap) here
     char buf[160];
-    serializeJson(doc, buf, sizeof(buf));
+    snprintf(buf, sizeof(buf),
+             "{\"state\":\"%s\",\"brightness\":%u,\"color_mode\":\"brightness\",\"effect\":\"%s\"}",
+             isOn ? "ON" : "OFF", cfgPtr->brightness, effectName);
     mqttClient.publish(topicState, buf, true);
 
     lastPubBrightness = cfgPtr->brightness;
@@ -97,6 +105,38 @@ static void publishStateInternal() {
 }
 
 // ─── HA Auto-Discovery ───────────────────────────────────────────────────
+// The discovery payloads depend only on the device ID, so they are built
+// once (by setupMqtt(), at boot and after an MQTT settings change) into
+// discoveryCache as packed topic/payload strings. A connect then only has
+// to copy them out, one per loopMqtt() pass (see announceStep()).
+
+struct DiscoveryEntry {
+    uint16_t topicAt;          // offsets into discoveryCache
+    uint16_t payloadAt;
+    uint16_t payloadLen;
+};
+
+// Sensors that read one field of the diagnostics topic
+static const struct {
+    const char *key;           // uniq_id / topic suffix
+    const char *name;
+    const char *field;         // in the diagnostics JSON
+    const char *unit;
+    const char *devClass;
+    const char *icon;
+} DIAG_SENSORS[] = {
+    {"ip",      "IP Address",  "ip",      nullptr, nullptr,   "mdi:ip-network"},
+    {"uptime",  "Uptime",      "uptime",  nullptr, nullptr,   "mdi:clock-outline"},
+    {"heap",    "Free Heap",   "heap",    "KB",    nullptr,   "mdi:memory"},
+    {"current", "LED Current", "powerMa", "mA",    "current", "mdi:current-dc"},
+};
+
+#define DISCOVERY_ENTRIES (1 + sizeof(DIAG_SENSORS) / sizeof(DIAG_SENSORS[0]))
+
+static char           discoveryCache[MQTT_DISCOVERY_CACHE];
+static DiscoveryEntry discovery[DISCOVERY_ENTRIES];
+static uint8_t        discoveryCount = 0;
+static size_t         discoveryUsed  = 0;
 
 // Shared device block for all discovery payloads
 static void addDeviceBlock(JsonObject &dev) {
@@ -110,9 +150,32 @@ static void addDeviceBlock(JsonObject &dev) {
     dev["sw"]   = FW_VERSION;
 }
 
-static void publishDiscovery() {
-    char buf[MQTT_BUFFER_SIZE];
-    size_t len;
+static void cacheDiscovery(const char *topic, JsonDocument &doc) {
+    size_t topicLen   = strlen(topic) + 1;
+    size_t payloadLen = measureJson(doc);
+
+    // PubSubClient sends topic and payload from its own buffer, after a
+    // fixed header of up to 5 bytes and the 2-byte topic length
+    if (payloadLen + topicLen + 7 > MQTT_BUFFER_SIZE ||
+        discoveryUsed + topicLen + payloadLen + 1 > sizeof(discoveryCache) ||
+        discoveryCount >= DISCOVERY_ENTRIES) {
+        Serial.printf("MQTT: Discovery for %s doesn't fit, skipped\n", topic);
+        return;
+    }
+
+    DiscoveryEntry &e = discovery[discoveryCount++];
+    e.topicAt = discoveryUsed;
+    memcpy(discoveryCache + discoveryUsed, topic, topicLen);
+    discoveryUsed += topicLen;
+
+    e.payloadAt  = discoveryUsed;
+    e.payloadLen = serializeJson(doc, discoveryCache + discoveryUsed, payloadLen + 1);
+    discoveryUsed += e.payloadLen + 1;
+}
+
+static void buildDiscovery() {
+    discoveryCount = 0;
+    discoveryUsed  = 0;
 
     // ── Light entity ─────────────────────────────────────────────────
     {
@@ -141,53 +204,26 @@ static void publishDiscovery() {
         JsonObject dev = doc["dev"].to<JsonObject>();
         addDeviceBlock(dev);
 
-        len = serializeJson(doc, buf, sizeof(buf));
-        if (len >= sizeof(buf)) {
-            Serial.println(F("MQTT: Light discovery truncated!"));
-        } else {
-            mqttClient.publish(topicDiscovery, (const uint8_t*)buf, len, true);
-        }
+        cacheDiscovery(topicDiscovery, doc);
     }
 
-    // ── IP Address sensor ────────────────────────────────────────────
-    {
+    // ── Diagnostic sensors ───────────────────────────────────────────
+    for (const auto &sensor : DIAG_SENSORS) {
         JsonDocument doc;
-        doc["name"]    = "IP Address";
+        doc["name"]    = sensor.name;
 
         char uniqId[32];
-        snprintf(uniqId, sizeof(uniqId), "ledgrid_%s_ip", deviceId);
+        snprintf(uniqId, sizeof(uniqId), "ledgrid_%s_%s", deviceId, sensor.key);
         doc["uniq_id"] = uniqId;
         doc["stat_t"]  = topicDiagnostics;
-        doc["val_tpl"] = "{{ value_json.ip }}";
-        doc["avty_t"]  = topicAvail;
-        doc["ic"]      = "mdi:ip-network";
-        doc["ent_cat"] = "diagnostic";
-
-        JsonObject dev = doc["dev"].to<JsonObject>();
-        addDeviceBlock(dev);
 
-        char topic[80];
-        snprintf(topic, sizeof(topic),
-                 "homeassistant/sensor/ledgrid_%s/ip/config", deviceId);
-
-        len = serializeJson(doc, buf, sizeof(buf));
-        if (len < sizeof(buf)) {
-            mqttClient.publish(topic, (const uint8_t*)buf, len, true);
-        }
-    }
-
-    // ── Uptime sensor ────────────────────────────────────────────────
-    {
-        JsonDocument doc;
-        doc["name"]    = "Uptime";
-
-        char uniqId[32];
-        snprintf(uniqId, sizeof(uniqId), "ledgrid_%s_uptime", deviceId);
-        doc["uniq_id"] = uniqId;
-        doc["stat_t"]  = topicDiagnostics;
-        doc["val_tpl"] = "{{ value_json.uptime }}";
+        char valTpl[40];
+        snprintf(valTpl, sizeof(valTpl), "{{ value_json.%s }}", sensor.field);
+        doc["val_tpl"] = valTpl;
+        if (sensor.unit)     doc["unit_of_meas"] = sensor.unit;
+        if (sensor.devClass) doc["dev_cla"]      = sensor.devClass;
         doc["avty_t"]  = topicAvail;
-        doc["ic"]      = "mdi:clock-outline";
+        doc["ic"]      = sensor.icon;
         doc["ent_cat"] = "diagnostic";
 
         JsonObject dev = doc["dev"].to<JsonObject>();
@@ -195,47 +231,26 @@ static void publishDiscovery() {
 
         char topic[80];
         snprintf(topic, sizeof(topic),
-                 "homeassistant/sensor/ledgrid_%s/uptime/config", deviceId);
-
-        len = serializeJson(doc, buf, sizeof(buf));
-        if (len < sizeof(buf)) {
-            mqttClient.publish(topic, (const uint8_t*)buf, len, true);
-        }
+                 "homeassistant/sensor/ledgrid_%s/%s/config", deviceId, sensor.key);
+        cacheDiscovery(topic, doc);
     }
 
-    // ── Free Heap sensor ─────────────────────────────────────────────
-    {
-        JsonDocument doc;
-        doc["name"]    = "Free Heap";
-
-        char uniqId[32];
-        snprintf(uniqId, sizeof(uniqId), "ledgrid_%s_heap", deviceId);
-        doc["uniq_id"] = uniqId;
-        doc["stat_t"]  = topicDiagnostics;
-        doc["val_tpl"] = "{{ value_json.heap }}";
-        doc["unit_of_meas"] = "KB";
-        doc["avty_t"]  = topicAvail;
-        doc["ic"]      = "mdi:memory";
-        doc["ent_cat"] = "diagnostic";
-
-        JsonObject dev = doc["dev"].to<JsonObject>();
-        addDeviceBlock(dev);
-
-        char topic[80];
-        snprintf(topic, sizeof(topic),
-                 "homeassistant/sensor/ledgrid_%s/heap/config", deviceId);
+    Serial.printf("MQTT: %u discovery payloads cached (%u bytes)\n",
+                  discoveryCount, (unsigned)discoveryUsed);
+}
 
-        len = serializeJson(doc, buf, sizeof(buf));
-        if (len < sizeof(buf)) {
-            mqttClient.publish(topic, (const uint8_t*)buf, len, true);
-        }
-    }
+static void publishDiscovery(uint8_t i) {
+    TraceScope trace(TRACE_MQTT_PUBLISH, TRACE_PUB_DISCOVERY);
+    const DiscoveryEntry &e = discovery[i];
+    mqttClient.publish(discoveryCache + e.topicAt,
+                       (const uint8_t*)discoveryCache + e.payloadAt, e.payloadLen, true);
 }
 
 // ─── Diagnostics Publish ─────────────────────────────────────────────────
 
 static void publishDiagnostics() {
     if (!mqttClient.connected()) return;
+    TraceScope trace(TRACE_MQTT_PUBLISH, TRACE_PUB_DIAGNOSTICS);
 
     unsigned long up = millis() / 1000;
     unsigned long days  = up / 86400;
@@ -250,79 +265,227 @@ static void publishDiagnostics() {
     doc["uptime"] = uptimeBuf;
     doc["heap"]   = (unsigned long)(ESP.getFreeHeap() / 1024);
 
-    char buf[128];
+    const PowerStats &power = powerStats();
+    doc["powerMa"]         = (unsigned long)power.estimatedMa;
+    doc["powerBrightness"] = power.brightness;
+    doc["powerLimited"]    = power.limiting;
+    doc["powerLimitedPct"] = power.frames ? (unsigned)(power.limitedFrames * 100ULL / power.frames) : 0U;
+
+    // Timing summary; the full breakdown is at /api/perf
+    const PerfStats &perf = perfStats();
+    const PerfCounter &loopT = perf.sections[PERF_LOOP];
+    JsonObject p = doc["perf"].to<JsonObject>();
+    p["loopAvgUs"]      = perfAvgUs(loopT.totalUs, loopT.count);
+    p["loopMaxUs"]      = loopT.maxUs;
+    p["renderAvgUs"]    = perfAvgUs(perf.sections[PERF_RENDER].totalUs, perf.sections[PERF_RENDER].count);
+    p["showAvgUs"]      = perfAvgUs(perf.sections[PERF_SHOW].totalUs, perf.sections[PERF_SHOW].count);
+    p["webMaxUs"]       = perf.sections[PERF_WEB].maxUs;
+    p["mqttMaxUs"]      = perf.sections[PERF_MQTT].maxUs;
+    p["deadlineMisses"] = perf.deadlineMisses;
+    p["worstGapMs"]     = perf.worstGapMs;
+
+    JsonObject m = doc["mqtt"].to<JsonObject>();
+    m["connects"]     = stats.connects;
+    m["connectMs"]    = stats.connectUs / 1000;
+    m["readyMs"]      = stats.readyMs;
+    m["stepMaxUs"]    = stats.stepMaxUs;
+    m["frames"]       = stats.frames;
+    m["frameDrops"]   = stats.frameDrops;
+    m["frameInvalid"] = stats.frameInvalid;
+
+    char buf[640];
     serializeJson(doc, buf, sizeof(buf));
     mqttClient.publish(topicDiagnostics, buf, true);
 }
 
+// ─── Overlay Command ─────────────────────────────────────────────────────
+// {"slot":0,"type":"text","text":"21.5C","colour":"#FFA000","x":0,"y":0,
+//  "w":16,"h":5,"alpha":200,"blend":"normal","scroll":80,"duration":10000}
+// "type":"none" clears the slot; "slot":"all" with "type":"none" clears all.
+// Sprites pass "sprite":[rows...] with bit 15 as the leftmost pixel.
+
+static void handleOverlayCommand(byte *payload, unsigned int length) {
+    JsonDocument doc;
+    DeserializationError err = deserializeJson(doc, payload, length);
+    if (err) return;
+
+    OverlayType type = overlayTypeFromName(doc["type"] | "none");
+    if (doc["slot"].is<const char*>()) {
+        if (type == OVERLAY_NONE && strcmp(doc["slot"], "all") == 0) renderClearOverlays();
+        return;
+    }
+
+    uint8_t slot = doc["slot"] | 0;
+    if (slot >= MAX_OVERLAYS) return;
+    if (type == OVERLAY_NONE) {
+        renderClearOverlay(slot);
+        return;
+    }
+
+    Overlay ov;
+    compositor.overlayDefaults(ov);
+    ov.type       = type;
+    ov.x          = constrain(doc["x"] | 0, -GRID_WIDTH, GRID_WIDTH);
+    ov.y          = constrain(doc["y"] | 0, -GRID_HEIGHT, GRID_HEIGHT);
+    ov.w          = constrain(doc["w"] | (int)GRID_WIDTH, 0, GRID_WIDTH);
+    ov.h          = constrain(doc["h"] | (int)GRID_HEIGHT, 0, GRID_HEIGHT);
+    ov.alpha      = doc["alpha"] | 255;
+    ov.blend      = blendModeFromName(doc["blend"] | "normal");
+    ov.scrollMs   = constrain(doc["scroll"] | 0, 0, 2000);
+    ov.durationMs = constrain(doc["duration"] | 0L, 0L, 3600000L);
+
+    const char *colour = doc["colour"] | "#FFFFFF";
+    if (*colour == '#') colour++;
+    ov.colour = strtoul(colour, nullptr, 16) & 0xFFFFFF;
+
+    strncpy(ov.text, doc["text"] | "", sizeof(ov.text) - 1);
+    ov.text[sizeof(ov.text) - 1] = '\0';
+
+    JsonArrayConst rows = doc["sprite"];
+    if (!rows.isNull()) {
+        uint8_t n = 0;
+        for (JsonVariantConst row : rows) {
+            if (n >= OVERLAY_SPRITE_MAX) break;
+            ov.sprite[n++] = row.as<uint16_t>();
+        }
+        if (!doc.containsKey("h")) ov.h = n;
+        if (!doc.containsKey("w")) ov.w = OVERLAY_SPRITE_MAX;
+    }
+
+    renderSetOverlay(slot, ov);
+}
+
+// ─── Frame Input ─────────────────────────────────────────────────────────
+// Binary frames for EFFECT_LIVE, e.g. dashboards rendered by a home
+// automation server:
+//
+//   RGB:     NUM_LEDS x (r, g, b), screen order from the top-left
+//   palette: count (0 = 256) | count x (r, g, b) | NUM_LEDS indices
+//
+// told apart by length. Each frame is decoded in one pass from
+// PubSubClient's buffer into a frame buffer borrowed from the render task,
+// which shows it between two renders; nothing re-reads the payload.
+
+static_assert((2 * NUM_LEDS - 1) % 3 != 0 || (2 * NUM_LEDS - 1) / 3 > 256,
+              "an RGB frame and a palette frame must differ in length");
+
+static unsigned long lastFrameMs = 0;
+
+static void handleFrame(const byte *payload, unsigned int length) {
+    if (cfgPtr->currentEffect != EFFECT_LIVE) return;
+
+    unsigned long now = millis();
+    if (now - lastFrameMs < MQTT_FRAME_MIN_INTERVAL_MS) {
+        stats.frameDrops++;
+        return;
+    }
+
+    bool rgb = length == MQTT_FRAME_RGB_BYTES;
+    uint16_t colours = length ? (payload[0] ? payload[0] : 256) : 0;
+    if (!rgb && (length == 0 || length != 1 + colours * 3U + NUM_LEDS)) {
+        stats.frameInvalid++;
+        return;
+    }
+
+    uint32_t *frame = renderBorrowFrame();
+    if (!frame) {                      // render task still has both buffers
+        stats.frameDrops++;
+        return;
+    }
+
+    const byte *palette = payload + 1;
+    const byte *src = rgb ? payload : palette + colours * 3;
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        for (uint8_t x = 0; x < GRID_WIDTH; x++) {
+            const byte *c;
+            if (rgb) {
+                c = src;
+                src += 3;
+            } else {
+                uint8_t i = *src++;
+                if (i >= colours) { frame[screenToIndex(x, y)] = 0; continue; }
+                c = palette + i * 3;
+            }
+            frame[screenToIndex(x, y)] = ((uint32_t)c[0] << 16) | ((uint32_t)c[1] << 8) | c[2];
+        }
+    }
+
+    if (renderPostFrame()) {
+        stats.frames++;
+        lastFrameMs = now;
+    } else {
+        stats.frameDrops++;
+    }
+}
+
 // ─── Command Callback ────────────────────────────────────────────────────
+// Light commands are parsed in place by parseLightCommand() (LedCore's
+// light_command.h), with no JsonDocument.
 
 static void mqttCallback(char *topic, byte *payload, unsigned int length) {
+    if (strcmp(topic, topicFrame) == 0) {
+        handleFrame(payload, length);
+        return;
+    }
+    if (strcmp(topic, topicOverlay) == 0) {
+        handleOverlayCommand(payload, length);
+        return;
+    }
     if (strcmp(topic, topicCmd) != 0) return;
 
-    JsonDocument doc;
-    DeserializationError err = deserializeJson(doc, payload, length);
-    if (err) return;
+    LightCommand cmd;
+    if (!parseLightCommand(payload, length, cmd)) return;
 
     bool changed = false;
 
     // Handle on/off
-    if (doc.containsKey("state")) {
-        const char *state = doc["state"];
-        if (state != nullptr) {
-            if (strcmp(state, "OFF") == 0 && cfgPtr->brightness > 0) {
-                priorBrightness = cfgPtr->brightness;
-                cfgPtr->brightness = 0;
-                changed = true;
-            } else if (strcmp(state, "ON") == 0 && cfgPtr->brightness == 0) {
-                cfgPtr->brightness = priorBrightness > 0 ? priorBrightness : DEFAULT_BRIGHTNESS;
-                changed = true;
-            }
-        }
+    if (cmd.state == 0 && cfgPtr->brightness > 0) {
+        priorBrightness = cfgPtr->brightness;
+        cfgPtr->brightness = 0;
+        changed = true;
+    } else if (cmd.state == 1 && cfgPtr->brightness == 0) {
+        cfgPtr->brightness = priorBrightness > 0 ? priorBrightness : DEFAULT_BRIGHTNESS;
+        changed = true;
     }
 
     // Handle brightness
-    if (doc.containsKey("brightness")) {
-        uint8_t b = doc["brightness"].as<uint8_t>();
-        if (b != cfgPtr->brightness) {
-            cfgPtr->brightness = b;
-            if (b > 0) priorBrightness = b;
-            changed = true;
-        }
+    if (cmd.brightness >= 0 && cmd.brightness != cfgPtr->brightness) {
+        cfgPtr->brightness = cmd.brightness;
+        if (cmd.brightness > 0) priorBrightness = cmd.brightness;
+        changed = true;
     }
 
     // Handle effect
-    if (doc.containsKey("effect")) {
-        const char *name = doc["effect"];
-        if (name != nullptr) {
-            for (int i = 0; i < EFFECT_COUNT; i++) {
-                if (strcmp(name, EFFECT_NAMES[i]) == 0) {
-                    if (cfgPtr->currentEffect != (Effect)i) {
-                        cfgPtr->currentEffect = (Effect)i;
-                        if (cfgPtr->currentEffect == EFFECT_TETRIS) {
-                            resetTetris();
-                        } else if (cfgPtr->currentEffect == EFFECT_SNAKE) {
-                            resetSnake();
-                        }
-                        changed = true;
-                    }
-                    break;
+    if (cmd.effect[0]) {
+        for (int i = 0; i < EFFECT_COUNT; i++) {
+            if (strcmp(cmd.effect, EFFECT_NAMES[i]) == 0) {
+                if (cfgPtr->currentEffect != (Effect)i) {
+                    cfgPtr->currentEffect = (Effect)i;
+                    renderSetEffect(cfgPtr->currentEffect);
+                    changed = true;
                 }
+                break;
             }
         }
     }
 
     if (changed) {
-        mqttDirty   = true;
-        lastDirtyMs = millis();
+        saveGridConfig(*cfgPtr);     // write-behind: slider drags coalesce
         publishStateInternal();
     }
 }
 
 // ─── Connect ─────────────────────────────────────────────────────────────
+// connectToBroker() only does the blocking part: the MQTT CONNECT, the
+// availability message and the subscriptions. Discovery, state and
+// diagnostics follow one per loopMqtt() pass, so web and WebSocket
+// requests get serviced in between.
 
 static bool connectToBroker() {
     if (cfgPtr->mqtt.host[0] == '\0') return false;
+    TraceScope trace(TRACE_MQTT_RECONNECT);
+    uint32_t startUs = micros();
+    connectStartMs = millis();
 
     mqttClient.setServer(cfgPtr->mqtt.host, cfgPtr->mqtt.port);
 
@@ -341,32 +504,61 @@ static bool connectToBroker() {
                                 topicAvail, 1, true, "offline");
     }
 
+    trace.arg = ok;
     if (ok) {
         Serial.println(F("MQTT: Connected"));
         reconnectInterval = 5000;
 
         mqttClient.publish(topicAvail, "online", true);
         mqttClient.subscribe(topicCmd, 1);
+        mqttClient.subscribe(topicOverlay, 0);
+        mqttClient.subscribe(topicFrame, 0);
 
-        publishDiscovery();
-        forcePublish = true;
-        publishStateInternal();
-        publishDiagnostics();
+        stats.connects++;
+        stats.stepMaxUs = 0;
+        announceNext = 0;
     } else {
         Serial.printf("MQTT: Connect failed (rc=%d)\n", mqttClient.state());
     }
+    stats.connectUs = micros() - startUs;
     return ok;
 }
 
+// One post-connect publish: each discovery payload, then state, then
+// diagnostics. The connect counts as ready once the last one is out.
+static void announceStep() {
+    uint32_t startUs = micros();
+    uint8_t step = announceNext++;
+
+    if (step < discoveryCount) {
+        publishDiscovery(step);
+    } else if (step == discoveryCount) {
+        forcePublish = true;
+        publishStateInternal();
+    } else {
+        announceNext = ANNOUNCE_DONE;
+        stats.readyMs = millis() - connectStartMs;
+        lastHeartbeatMs = millis();
+        publishDiagnostics();
+    }
+
+    uint32_t us = micros() - startUs;
+    if (us > stats.stepMaxUs) stats.stepMaxUs = us;
+}
+
 // ─── Public API ──────────────────────────────────────────────────────────
 
 void setupMqtt(GridConfig &cfg) {
     cfgPtr = &cfg;
     buildDeviceId();
     buildTopics();
+    buildDiscovery();
 
+    // First attempt on the next loopMqtt(), not here: the caller may be
+    // an HTTP handler that still has to answer
     reconnectInterval = 5000;
-    lastReconnectMs   = 0;
+    lastReconnectMs   = millis() - reconnectInterval;
+    announceNext      = ANNOUNCE_DONE;
 
     mqttClient.setBufferSize(MQTT_BUFFER_SIZE);
     mqttClient.setCallback(mqttCallback);
@@ -374,8 +566,7 @@ void setupMqtt(GridConfig &cfg) {
     priorBrightness = cfg.brightness > 0 ? cfg.brightness : DEFAULT_BRIGHTNESS;
 
     if (cfg.mqtt.enabled && cfg.mqtt.host[0] != '\0') {
-        Serial.printf("MQTT: Connecting to %s:%d\n", cfg.mqtt.host, cfg.mqtt.port);
-        connectToBroker();
+        Serial.printf("MQTT: Broker %s:%d\n", cfg.mqtt.host, cfg.mqtt.port);
     } else {
         Serial.println(F("MQTT: Disabled"));
     }
@@ -387,6 +578,11 @@ void loopMqtt() {
     if (mqttClient.connected()) {
         mqttClient.loop();
 
+        if (announceNext != ANNOUNCE_DONE) {
+            announceStep();
+            return;
+        }
+
         unsigned long now = millis();
 
         // Heartbeat — re-publish state + diagnostics periodically
@@ -396,12 +592,6 @@ void loopMqtt() {
             publishStateInternal();
             publishDiagnostics();
         }
-
-        // Debounced save for MQTT-driven changes (avoid NVS wear)
-        if (mqttDirty && (now - lastDirtyMs > 5000)) {
-            saveGridConfig(*cfgPtr);
-            mqttDirty = false;
-        }
         return;
     }
 
@@ -433,3 +623,7 @@ void mqttDisconnect() {
 bool isMqttConnected() {
     return mqttClient.connected();
 }
+
+const MqttStats &mqttStats() {
+    return stats;
+}
@@ -3,6 +3,17 @@
 
 #include "config.h"
 
+// Connect timing and frame input, for diagnostics
+struct MqttStats {
+    uint32_t connects;       // successful broker connects since boot
+    uint32_t connectUs;      // time loop() was blocked in the last connect attempt
+    uint32_t readyMs;        // last connect: attempt start to discovery, state and diagnostics all sent
+    uint32_t stepMaxUs;      // longest single post-connect publish since the last connect
+    uint32_t frames;         // ledgrid/<ID>/frame frames passed to the render task
+    uint32_t frameDrops;     // over the rate limit, or both frame buffers busy
+    uint32_t frameInvalid;   // neither RGB nor palette length
+};
+
 // Initialise MQTT client with current configuration.
 void setupMqtt(GridConfig &cfg);
 
@@ -18,4 +29,6 @@ void mqttDisconnect();
 // Returns true if connected to the MQTT broker.
 bool isMqttConnected();
 
+const MqttStats &mqttStats();
+
 #endif // MQTT_CLIENT_H
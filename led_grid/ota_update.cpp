@@ -0,0 +1,146 @@
+#include "ota_update.h"
+#include <Update.h>
+#include <LedCore.h>
+
+#define ESP_IMAGE_MAGIC 0xE9
+
+static OtaStatus status = {OTA_IDLE, false, 0, 0, 0, 0, nullptr};
+static HeatshrinkDecoder<OTA_HS_WINDOW_BITS, OTA_HS_LOOKAHEAD_BITS> decoder;
+static bool          feeding     = false;   // this request's data goes into the session
+static unsigned long startedMs   = 0;       // start of this request's data
+static unsigned long suspendedMs = 0;
+
+// ─── Session ───────────────────────────────────────────────────────────────
+
+static void fail(const char *error) {
+    if (Update.isRunning()) Update.abort();
+    status.state = OTA_FAILED;
+    status.error = error;
+    feeding = false;
+    Serial.printf("OTA: failed: %s\n", error);
+}
+
+static void expireSuspended() {
+    if (status.state == OTA_SUSPENDED && millis() - suspendedMs > OTA_RESUME_MS) {
+        fail("Resume timed out");
+    }
+}
+
+static void writeImage(const uint8_t *data, size_t len) {
+    if (status.state != OTA_RECEIVING) return;
+    if (Update.write((uint8_t *)data, len) != len) {
+        fail(Update.errorString());
+        return;
+    }
+    status.written += len;
+}
+
+static void begin(uint32_t size, const char *md5) {
+    if (Update.isRunning()) Update.abort();
+    status = {OTA_RECEIVING, false, 0, 0, size, 0, nullptr};
+
+    if (!Update.begin(size ? size : UPDATE_SIZE_UNKNOWN)) {
+        fail(Update.errorString());
+        return;
+    }
+    if (md5[0] && !Update.setMD5(md5)) {
+        fail("Bad md5 argument");
+        return;
+    }
+    decoder.reset();
+    feeding = true;
+}
+
+static void resume(uint32_t offset) {
+    expireSuspended();
+    if (status.state != OTA_SUSPENDED) {
+        status.error = "Nothing to resume";
+        return;
+    }
+    if (offset != status.received) {
+        status.error = "Resume offset doesn't match bytes received";
+        return;
+    }
+    status.state = OTA_RECEIVING;
+    status.error = nullptr;
+    feeding = true;
+}
+
+static void receive(const uint8_t *data, size_t len) {
+    if (status.received == 0 && len > 0) status.compressed = data[0] != ESP_IMAGE_MAGIC;
+    status.received += len;
+
+    if (status.compressed) decoder.feed(data, len, writeImage);
+    else                   writeImage(data, len);
+}
+
+static void stopClock() {
+    status.elapsedMs += millis() - startedMs;
+}
+
+static void finish() {
+    if (status.compressed) decoder.finish(writeImage);
+    if (status.state != OTA_RECEIVING) return;
+
+    // A given size must be filled exactly; without one, whatever arrived is the image
+    if (!Update.end(status.size == 0)) {
+        fail(Update.errorString());
+        return;
+    }
+    status.state = OTA_DONE;
+    Serial.printf("OTA: %lu -> %lu bytes in %lu ms (%lu KB/s)\n",
+                  (unsigned long)status.received, (unsigned long)status.written,
+                  (unsigned long)status.elapsedMs, (unsigned long)otaKBps());
+}
+
+// ─── Upload ────────────────────────────────────────────────────────────────
+
+void otaUpload(HTTPUpload &upload, uint32_t offset, uint32_t size, const char *md5) {
+    if (upload.status == UPLOAD_FILE_START) {
+        Serial.printf("OTA: %s from %lu\n", upload.filename.c_str(), (unsigned long)offset);
+        feeding = false;
+        if (offset == 0) begin(size, md5);
+        else             resume(offset);
+        startedMs = millis();
+        return;
+    }
+    if (!feeding) return;
+
+    if (upload.status == UPLOAD_FILE_WRITE) {
+        receive(upload.buf, upload.currentSize);
+    } else if (upload.status == UPLOAD_FILE_END) {
+        stopClock();
+        feeding = false;
+        finish();
+    } else if (upload.status == UPLOAD_FILE_ABORTED) {
+        stopClock();
+        feeding = false;
+        if (status.state != OTA_RECEIVING) return;
+        status.state = OTA_SUSPENDED;
+        suspendedMs = millis();
+        Serial.printf("OTA: interrupted at %lu bytes, resumable\n", (unsigned long)status.received);
+    }
+}
+
+// ─── Status ────────────────────────────────────────────────────────────────
+
+uint32_t otaKBps() {
+    uint32_t ms = status.elapsedMs + (feeding ? millis() - startedMs : 0);
+    return ms ? (uint32_t)((uint64_t)status.received * 1000 / 1024 / ms) : 0;
+}
+
+const char *otaStateName(OtaState state) {
+    switch (state) {
+        case OTA_IDLE:      return "idle";
+        case OTA_RECEIVING: return "receiving";
+        case OTA_SUSPENDED: return "suspended";
+        case OTA_DONE:      return "done";
+        case OTA_FAILED:    return "failed";
+    }
+    return "";
+}
+
+const OtaStatus &otaStatus() {
+    expireSuspended();
+    return status;
+}
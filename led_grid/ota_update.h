@@ -0,0 +1,55 @@
+#ifndef OTA_UPDATE_H
+#define OTA_UPDATE_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include "config.h"
+
+// ─── OTA Update ────────────────────────────────────────────────────────────
+// Firmware arrives as a POST /update upload, either the plain .bin or the
+// .bin.hs that compress_ota.py makes of it. The first byte tells them
+// apart: an ESP image always starts with 0xE9, a heatshrink stream never
+// does. Compressed uploads are decoded as they arrive through a 2 KB
+// window (OTA_HS_WINDOW_BITS) and written to flash in window-sized pieces,
+// so only the compressed bytes cross the network.
+//
+// Optional query arguments:
+//   size=N     image size; Update reserves exactly that and the image must fill it
+//   md5=HEX    image MD5; Update refuses to boot an image that doesn't match
+//   offset=N   resume an interrupted upload N upload bytes in
+//
+// An upload cut off mid-way is kept open for OTA_RESUME_MS: GET /api/ota
+// reports how many bytes were taken (`received`), and posting the rest of
+// the file with offset=received carries on where it stopped. Starting again
+// from offset 0 discards it.
+
+enum OtaState : uint8_t {
+    OTA_IDLE,
+    OTA_RECEIVING,
+    OTA_SUSPENDED,    // upload interrupted, waiting to be resumed
+    OTA_DONE,         // image written and verified; restart to boot it
+    OTA_FAILED,
+};
+
+struct OtaStatus {
+    OtaState    state;
+    bool        compressed;
+    uint32_t    received;     // upload bytes taken (compressed, for a .hs)
+    uint32_t    written;      // image bytes written to flash
+    uint32_t    size;         // expected image size, 0 if not given
+    uint32_t    elapsedMs;    // time spent receiving, over all resumes
+    const char *error;        // why the last upload failed or was refused
+};
+
+// Feed one upload callback to the OTA session. Call from the /update
+// upload handler with that request's query arguments.
+void otaUpload(HTTPUpload &upload, uint32_t offset, uint32_t size, const char *md5);
+
+// Upload throughput over the whole transfer, in KB/s.
+uint32_t otaKBps();
+
+const char *otaStateName(OtaState state);
+
+const OtaStatus &otaStatus();
+
+#endif // OTA_UPDATE_H
@@ -0,0 +1,81 @@
+#include "perf_stats.h"
+
+#define PERF_FIRST_BOUND_SHIFT  6     // bucket 0: under 64 µs
+
+static PerfStats stats = {};
+static bool      firstRender = true;  // boot: no previous render to measure a gap from
+
+static const char *const SECTION_NAMES[PERF_SECTIONS] = {
+    "loop", "render", "show", "web", "websocket", "mqtt", "udp"
+};
+
+static bool renderSection(uint8_t s) {
+    return s == PERF_RENDER || s == PERF_SHOW || s == PERF_UDP;
+}
+
+static inline uint8_t bucketFor(uint32_t us) {
+    uint32_t v = us >> PERF_FIRST_BOUND_SHIFT;
+    if (v == 0) return 0;
+    uint8_t b = 32 - __builtin_clz(v);
+    return b < PERF_BUCKETS ? b : PERF_BUCKETS - 1;
+}
+
+void perfRecord(PerfSection s, uint32_t us) {
+    if (!PERF_STATS) return;
+    PerfCounter &c = stats.sections[s];
+    c.count++;
+    c.totalUs += us;
+    if (us > c.maxUs) c.maxUs = us;
+    c.hist[bucketFor(us)]++;
+}
+
+void perfRecordRender(Effect effect, uint32_t us, uint32_t gapMs) {
+    if (!PERF_STATS) return;
+    perfRecord(PERF_RENDER, us);
+    if (effect < EFFECT_COUNT) {
+        PerfEffect &e = stats.effects[effect];
+        e.count++;
+        e.totalUs += us;
+        if (us > e.maxUs) e.maxUs = us;
+    }
+
+    stats.frames++;
+    if (firstRender) {
+        firstRender = false;
+        return;
+    }
+    if (gapMs > stats.worstGapMs) stats.worstGapMs = gapMs;
+    // A gap of two or more intervals means whole frame slots went by
+    if (gapMs >= 2 * LED_UPDATE_INTERVAL_MS) {
+        stats.deadlineMisses += gapMs / LED_UPDATE_INTERVAL_MS - 1;
+    }
+}
+
+void perfResetLoop() {
+    for (uint8_t s = 0; s < PERF_SECTIONS; s++) {
+        if (!renderSection(s)) memset(&stats.sections[s], 0, sizeof(stats.sections[s]));
+    }
+    stats.sinceMs = millis();
+}
+
+void perfResetRender() {
+    for (uint8_t s = 0; s < PERF_SECTIONS; s++) {
+        if (renderSection(s)) memset(&stats.sections[s], 0, sizeof(stats.sections[s]));
+    }
+    memset(stats.effects, 0, sizeof(stats.effects));
+    stats.frames         = 0;
+    stats.deadlineMisses = 0;
+    stats.worstGapMs     = 0;
+}
+
+const PerfStats &perfStats() {
+    return stats;
+}
+
+const char *perfSectionName(PerfSection s) {
+    return s < PERF_SECTIONS ? SECTION_NAMES[s] : "";
+}
+
+uint32_t perfBucketLimitUs(uint8_t b) {
+    return (b + 1 < PERF_BUCKETS) ? (1UL << (PERF_FIRST_BOUND_SHIFT + b)) : 0;
+}
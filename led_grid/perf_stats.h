@@ -0,0 +1,84 @@
+#ifndef PERF_STATS_H
+#define PERF_STATS_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// ─── Loop Timing ───────────────────────────────────────────────────────────
+// Counters and log2 histograms for the main loop, the render task and each
+// subsystem they call, plus render time per effect and missed frame slots.
+// Everything is recorded with micros() and a few adds — no allocation, no
+// locking (each section is written by one task only) — so it can stay on
+// in normal builds (PERF_STATS).
+//
+// Histogram bucket 0 counts times under 64 µs; bucket b counts times under
+// 64 << b µs; the last bucket counts everything longer.
+
+#define PERF_BUCKETS  12              // last bound: 64 << 10 = 65.5 ms
+
+enum PerfSection : uint8_t {
+    PERF_LOOP,          // one whole loop() iteration (network side)
+    PERF_RENDER,        // updateEffect(), all effects         (render task)
+    PERF_SHOW,          // composite + blit + strip.show(), frames pushed only (render task)
+    PERF_WEB,           // loopWebServer()
+    PERF_WEBSOCKET,     // loopWebSocket()
+    PERF_MQTT,          // loopMqtt()
+    PERF_UDP,           // loopUdpInput()                      (render task)
+    PERF_SECTIONS
+};
+
+struct PerfCounter {
+    uint32_t count;
+    uint64_t totalUs;
+    uint32_t maxUs;
+    uint32_t hist[PERF_BUCKETS];
+};
+
+struct PerfEffect {
+    uint32_t count;
+    uint64_t totalUs;
+    uint32_t maxUs;
+};
+
+// The effects and the frame counts are the render task's too.
+struct PerfStats {
+    uint32_t    sinceMs;              // millis() at boot or the last reset
+    PerfCounter sections[PERF_SECTIONS];
+    PerfEffect  effects[EFFECT_COUNT];
+    uint32_t    frames;               // effect renders
+    uint32_t    deadlineMisses;       // frame slots that passed without a render
+    uint32_t    worstGapMs;           // longest time between two renders
+};
+
+void perfRecord(PerfSection s, uint32_t us);
+
+// Record the section that started at `sinceUs`; returns now, ready to
+// time the next one.
+inline uint32_t perfLap(PerfSection s, uint32_t sinceUs) {
+    uint32_t now = micros();
+    perfRecord(s, now - sinceUs);
+    return now;
+}
+
+// One updateEffect() call: its time and the gap since the previous render.
+void perfRecordRender(Effect effect, uint32_t us, uint32_t gapMs);
+
+// A reset is done by each task for what it writes: loop() clears its
+// sections with perfResetLoop() and posts renderResetPerf(), and the render
+// task calls perfResetRender() between two passes.
+void perfResetLoop();
+void perfResetRender();
+
+const PerfStats &perfStats();
+
+const char *perfSectionName(PerfSection s);
+
+// Upper bound of histogram bucket b in µs (0 for the open-ended last one).
+uint32_t perfBucketLimitUs(uint8_t b);
+
+// Mean in µs, 0 when nothing has been recorded.
+inline uint32_t perfAvgUs(uint64_t totalUs, uint32_t count) {
+    return count ? (uint32_t)(totalUs / count) : 0;
+}
+
+#endif // PERF_STATS_H
@@ -1,19 +1,25 @@
 #include "persistence.h"
+#include "trace_log.h"
+#include <LedCore.h>
 #include <Preferences.h>
 
-#define NVS_NAMESPACE "ledgrid"
+#define NVS_NAMESPACE   "ledgrid"
+#define CONFIG_KEY      "cfg"
+#define CONFIG_MAGIC    0x4347          // "GC"
 
 const char* const EFFECT_NAMES[] = {
     "Tetris", "Rainbow Wave", "Colour Wash", "Diagonal Rainbow",
     "Rain", "Clock", "Fire", "Aurora",
     "Lava", "Candle", "Twinkle", "Matrix",
     "Fireworks", "Life", "Plasma", "Spiral",
-    "Valentines", "Snake"
+    "Valentines", "Snake", "Live", "GIF",
+    "Noise Fire", "Noise Aurora", "Noise Lava", "Noise Candle"
 };
 static_assert(sizeof(EFFECT_NAMES) / sizeof(EFFECT_NAMES[0]) == EFFECT_COUNT,
               "EFFECT_NAMES must match Effect enum count");
 
 void initDefaultConfig(GridConfig &cfg) {
+    memset(&cfg, 0, sizeof(cfg));    // padding too: saves are diffed with memcmp
     cfg.brightness    = DEFAULT_BRIGHTNESS;
     cfg.bgR           = 0;
     cfg.bgG           = 0;
@@ -47,12 +53,8 @@ void initDefaultConfig(GridConfig &cfg) {
     cfg.mqtt.password[0] = '\0';
 }
 
-void loadGridConfig(GridConfig &cfg) {
-    initDefaultConfig(cfg);
-
-    Preferences p;
-    if (!p.begin(NVS_NAMESPACE, true)) return;
-
+// Schema 0: one NVS key per field (firmware 0.5.0 and earlier).
+static void loadLegacyKeys(Preferences &p, GridConfig &cfg) {
     cfg.brightness     = p.getUChar("brightness", cfg.brightness);
     cfg.bgR            = p.getUChar("bgR", cfg.bgR);
     cfg.bgG            = p.getUChar("bgG", cfg.bgG);
@@ -97,43 +99,161 @@ void loadGridConfig(GridConfig &cfg) {
         strncpy(cfg.mqtt.password, mp.c_str(), sizeof(cfg.mqtt.password) - 1);
         cfg.mqtt.password[sizeof(cfg.mqtt.password) - 1] = '\0';
     }
+}
+
+// ─── Blob ──────────────────────────────────────────────────────────────────
+
+struct ConfigBlobHeader {
+    uint16_t magic;
+    uint16_t version;        // CONFIG_SCHEMA_VERSION when written
+    uint16_t length;         // payload bytes
+    uint16_t reserved;
+    uint32_t crc;            // CRC-32 of the payload
+};
+
+// The payload is the GridConfig image. A layout change must come with a new
+// schema version and a migration from the old one.
+static_assert(sizeof(GridConfig) == 220, "GridConfig layout changed: bump CONFIG_SCHEMA_VERSION and migrate");
 
+static const char *const LEGACY_KEYS[] = {
+    "brightness", "bgR", "bgG", "bgB", "dropStart", "dropMin", "moveInt", "rotInt",
+    "aiSkill", "jitter", "use24Hour", "clkTrans", "clkFadeMs", "clkMinMark", "clkDigCol",
+    "clkTrail", "effect", "authPass", "mqttOn", "mqttHost", "mqttPort", "mqttUser", "mqttPass",
+};
+
+static GridConfig    committed;           // what the blob in flash holds
+static GridConfig    pending;             // queued by saveGridConfig()
+static bool          dirty        = false;
+static unsigned long firstDirtyMs = 0;
+static unsigned long lastDirtyMs  = 0;
+static uint32_t      retryDelayMs = 0;    // after a failed write; 0 when none failed
+static unsigned long retryAtMs    = 0;
+
+static bool commitConfig(const GridConfig &cfg) {
+    TraceScope trace(TRACE_NVS_SAVE);
+    struct {
+        ConfigBlobHeader h;
+        GridConfig       cfg;
+    } blob;
+    memset(&blob.h, 0, sizeof(blob.h));
+    blob.h.magic   = CONFIG_MAGIC;
+    blob.h.version = CONFIG_SCHEMA_VERSION;
+    blob.h.length  = sizeof(GridConfig);
+    blob.h.crc     = crc32Update(0, &cfg, sizeof(cfg));
+    blob.cfg       = cfg;
+
+    Preferences p;
+    if (!p.begin(NVS_NAMESPACE, false)) return false;
+    bool ok = p.putBytes(CONFIG_KEY, &blob, sizeof(blob)) == sizeof(blob);
     p.end();
+    if (ok) committed = cfg;
+    return ok;
 }
 
-void saveGridConfig(const GridConfig &cfg) {
+// Read the blob into buf. Returns its schema version with *len set to the
+// payload size, 0 if there is no blob, or -1 if it is unreadable.
+static int readConfigBlob(Preferences &p, uint8_t *buf, size_t size, size_t *len) {
+    size_t n = p.getBytesLength(CONFIG_KEY);
+    if (n == 0) return 0;
+
+    ConfigBlobHeader h;
+    if (n < sizeof(h) || n > size || p.getBytes(CONFIG_KEY, buf, n) != n) return -1;
+    memcpy(&h, buf, sizeof(h));
+    if (h.magic != CONFIG_MAGIC || h.version == 0 || h.length != n - sizeof(h) ||
+        crc32Update(0, buf + sizeof(h), h.length) != h.crc) return -1;
+
+    *len = h.length;
+    return h.version;
+}
+
+// Turn a config stored at schema `version` into the current GridConfig.
+// Each older version converts straight to the current layout; returns
+// false for one this firmware does not know (written after a downgrade).
+static bool migrateConfig(Preferences &p, int version, const uint8_t *payload, size_t len,
+                          GridConfig &cfg) {
+    switch (version) {
+        case 0:
+            loadLegacyKeys(p, cfg);
+            return true;
+        case CONFIG_SCHEMA_VERSION:
+            if (len != sizeof(cfg)) return false;
+            memcpy(&cfg, payload, len);
+            return true;
+        default:
+            return false;
+    }
+}
+
+void loadGridConfig(GridConfig &cfg) {
+    initDefaultConfig(cfg);
+    committed = cfg;
+
     Preferences p;
-    if (!p.begin(NVS_NAMESPACE, false)) return;
+    if (!p.begin(NVS_NAMESPACE, true)) return;
+    uint8_t buf[sizeof(ConfigBlobHeader) + sizeof(GridConfig)];
+    size_t len = 0;
+    int version = readConfigBlob(p, buf, sizeof(buf), &len);
+    bool ok = version >= 0 && migrateConfig(p, version, buf + sizeof(ConfigBlobHeader), len, cfg);
+    p.end();
 
-    p.putUChar("brightness", cfg.brightness);
-    p.putUChar("bgR", cfg.bgR);
-    p.putUChar("bgG", cfg.bgG);
-    p.putUChar("bgB", cfg.bgB);
+    if (!ok) {
+        Serial.println(F("Config: stored settings unreadable, using defaults"));
+        initDefaultConfig(cfg);
+        memset(&committed, 0xFF, sizeof(committed));   // the next save always writes
+        return;
+    }
 
-    p.putUShort("dropStart", cfg.dropStartMs);
-    p.putUShort("dropMin", cfg.dropMinMs);
-    p.putUShort("moveInt", cfg.moveIntervalMs);
-    p.putUShort("rotInt", cfg.rotIntervalMs);
+    if (cfg.currentEffect >= EFFECT_COUNT) cfg.currentEffect = EFFECT_TETRIS;
+    cfg.authPassword[sizeof(cfg.authPassword) - 1] = '\0';
+    cfg.mqtt.host[sizeof(cfg.mqtt.host) - 1]         = '\0';
+    cfg.mqtt.username[sizeof(cfg.mqtt.username) - 1] = '\0';
+    cfg.mqtt.password[sizeof(cfg.mqtt.password) - 1] = '\0';
 
-    p.putUChar("aiSkill", cfg.aiSkillPct);
-    p.putUChar("jitter", cfg.jitterPct);
+    if (version == CONFIG_SCHEMA_VERSION) {
+        committed = cfg;
+        return;
+    }
 
-    p.putBool("use24Hour", cfg.use24Hour);
-    p.putUChar("clkTrans", cfg.clockTransition);
-    p.putUShort("clkFadeMs", cfg.clockFadeMs);
-    p.putBool("clkMinMark", cfg.clockMinMarker);
-    p.putUChar("clkDigCol", cfg.clockDigitColour);
-    p.putBool("clkTrail", cfg.clockTrail);
+    // Migrated: store the current layout, then drop the old keys
+    Serial.printf("Config: migrated schema %d -> %d\n", version, CONFIG_SCHEMA_VERSION);
+    if (commitConfig(cfg) && version == 0 && p.begin(NVS_NAMESPACE, false)) {
+        for (const char *key : LEGACY_KEYS) p.remove(key);
+        p.end();
+    }
+}
 
-    p.putUChar("effect", (uint8_t)cfg.currentEffect);
+void saveGridConfig(const GridConfig &cfg) {
+    if (memcmp(&cfg, dirty ? &pending : &committed, sizeof(cfg)) == 0) return;
 
-    p.putString("authPass", cfg.authPassword);
+    unsigned long now = millis();
+    if (!dirty) firstDirtyMs = now;
+    lastDirtyMs = now;
+    pending     = cfg;
+    dirty       = true;
+}
 
-    p.putBool("mqttOn",     cfg.mqtt.enabled);
-    p.putString("mqttHost", cfg.mqtt.host);
-    p.putUShort("mqttPort", cfg.mqtt.port);
-    p.putString("mqttUser", cfg.mqtt.username);
-    p.putString("mqttPass", cfg.mqtt.password);
+void loopPersistence() {
+    if (!dirty) return;
+    unsigned long now = millis();
+    if (retryDelayMs) {
+        if ((long)(now - retryAtMs) < 0) return;
+    } else if (now - lastDirtyMs < CONFIG_SAVE_DELAY_MS && now - firstDirtyMs < CONFIG_SAVE_MAX_DELAY_MS) {
+        return;
+    }
+    flushGridConfig();
+}
 
-    p.end();
+bool flushGridConfig() {
+    if (!dirty) return true;
+    if (memcmp(&pending, &committed, sizeof(pending)) != 0 && !commitConfig(pending)) {   // else changed back
+        // Keep it queued and back off
+        retryDelayMs = retryDelayMs ? retryDelayMs * 2 : CONFIG_SAVE_RETRY_MS;
+        if (retryDelayMs > CONFIG_SAVE_RETRY_MAX_MS) retryDelayMs = CONFIG_SAVE_RETRY_MAX_MS;
+        retryAtMs = millis() + retryDelayMs;
+        Serial.printf("Config: NVS write failed, retrying in %lu s\n", (unsigned long)(retryDelayMs / 1000));
+        return false;
+    }
+    dirty        = false;
+    retryDelayMs = 0;
+    return true;
 }
@@ -3,8 +3,30 @@
 
 #include "config.h"
 
+// ─── Config Store ──────────────────────────────────────────────────────────
+// GridConfig lives in NVS as one blob: a small header (schema version,
+// length, CRC-32) and the struct image. Boot is a single read; a config
+// written by older firmware is migrated forward by schema version, and one
+// that fails its CRC falls back to defaults.
+//
+// Saves are write-behind: saveGridConfig() only records what to store. The
+// blob is committed from loop() once changes have settled for
+// CONFIG_SAVE_DELAY_MS (or CONFIG_SAVE_MAX_DELAY_MS after the first one),
+// and not at all if it matches what is already in flash. A write that
+// fails stays queued and is retried after CONFIG_SAVE_RETRY_MS, backing
+// off to CONFIG_SAVE_RETRY_MAX_MS.
+
 void initDefaultConfig(GridConfig &cfg);
 void loadGridConfig(GridConfig &cfg);
+
+// Queue cfg (as it is now) to be written.
 void saveGridConfig(const GridConfig &cfg);
 
+// Commit a queued save when it is due. Call every loop().
+void loopPersistence();
+
+// Commit a queued save now (before a restart). Returns false if the write
+// failed; the save is still queued.
+bool flushGridConfig();
+
 #endif // PERSISTENCE_H
@@ -0,0 +1,64 @@
+#include "power_limit.h"
+#include "led_effects.h"
+
+static uint8_t    requested = DEFAULT_BRIGHTNESS;
+static uint8_t    applied   = DEFAULT_BRIGHTNESS;
+static PowerStats stats     = {};
+
+// Adafruit_NeoPixel scales each channel by (brightness + 1) / 256, and a
+// channel at 255 draws POWER_MA_PER_CHANNEL.
+static uint32_t estimateMa(uint32_t channelSum, uint8_t brightness) {
+    uint64_t dynamic = (uint64_t)channelSum * (brightness + 1) * POWER_MA_PER_CHANNEL / (256UL * 255UL);
+    return (uint32_t)dynamic + (uint32_t)NUM_LEDS * POWER_IDLE_MA_PER_LED;
+}
+
+// Highest brightness ≤ requested that keeps channelSum within the budget.
+static uint8_t budgetBrightness(uint32_t channelSum) {
+    if (POWER_BUDGET_MA == 0 || channelSum == 0) return requested;
+    const uint32_t idle = (uint32_t)NUM_LEDS * POWER_IDLE_MA_PER_LED;
+    if (POWER_BUDGET_MA <= idle) return 0;
+
+    uint64_t scale = (uint64_t)(POWER_BUDGET_MA - idle) * 256UL * 255UL /
+                     ((uint64_t)channelSum * POWER_MA_PER_CHANNEL);
+    if (scale == 0) return 0;
+    return (scale - 1 < requested) ? (uint8_t)(scale - 1) : requested;
+}
+
+static uint8_t governBrightness(const uint32_t *px) {
+    uint32_t sum = 0;
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        uint32_t c = px[i];
+        sum += (c >> 16 & 0xFF) + (c >> 8 & 0xFF) + (c & 0xFF);
+    }
+
+    uint8_t target = budgetBrightness(sum);
+    if (target <= applied) {
+        applied = target;                             // over budget: cut now
+    } else {
+        uint8_t step = (target - applied) >> POWER_RELEASE_SHIFT;
+        applied += step ? step : 1;                   // recover gradually
+    }
+
+    stats.estimatedMa = estimateMa(sum, applied);
+    stats.demandMa    = estimateMa(sum, requested);
+    stats.brightness  = applied;
+    stats.limiting    = applied < requested;
+    stats.frames++;
+    if (stats.limiting) stats.limitedFrames++;
+    return applied;
+}
+
+// ─── Public API ────────────────────────────────────────────────────────────
+
+void initPowerLimit() {
+    compositor.setBrightnessGovernor(governBrightness);
+    if (POWER_BUDGET_MA) Serial.printf("Power: limit %u mA\n", (unsigned)POWER_BUDGET_MA);
+}
+
+void setPowerBrightness(uint8_t b) {
+    requested = b;
+}
+
+const PowerStats &powerStats() {
+    return stats;
+}
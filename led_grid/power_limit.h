@@ -0,0 +1,34 @@
+#ifndef POWER_LIMIT_H
+#define POWER_LIMIT_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// ─── Power Limit ───────────────────────────────────────────────────────────
+// Estimates each frame's LED current from the composited (unscaled) pixels
+// and lowers the strip brightness just enough to keep it under
+// POWER_BUDGET_MA. The estimate is the summed channel values times
+// POWER_MA_PER_CHANNEL, plus a fixed idle draw per LED.
+//
+// Brightness drops at once when a frame would exceed the budget, and climbs
+// back towards the requested level over a few frames once it no longer
+// does, so flashing content doesn't make the whole grid pump.
+
+struct PowerStats {
+    uint32_t estimatedMa;     // last frame, at the applied brightness
+    uint32_t demandMa;        // last frame, at the requested brightness
+    uint8_t  brightness;      // applied brightness
+    bool     limiting;        // applied < requested
+    uint32_t frames;
+    uint32_t limitedFrames;   // frames shown below the requested brightness
+};
+
+// Install the brightness governor on the compositor. Call once after initLeds().
+void initPowerLimit();
+
+// The user's brightness (0-255); the governor never goes above it.
+void setPowerBrightness(uint8_t requested);
+
+const PowerStats &powerStats();
+
+#endif // POWER_LIMIT_H
@@ -0,0 +1,357 @@
+#include "render_task.h"
+#include "led_effects.h"
+#include "udp_input.h"
+#include "gif_player.h"
+#include "power_limit.h"
+#include "perf_stats.h"
+#include "trace_log.h"
+#include "websocket_handler.h"
+#include <LedCore.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
+
+static_assert((RENDER_QUEUE_LEN & (RENDER_QUEUE_LEN - 1)) == 0, "RENDER_QUEUE_LEN must be a power of two");
+
+// Everything the render task takes from GridConfig. Built zeroed so a
+// memcmp against the last one posted finds real changes only.
+struct RenderSettings {
+    uint8_t  brightness;
+    uint8_t  bgR, bgG, bgB;
+    uint16_t dropStartMs, dropMinMs, moveIntervalMs, rotIntervalMs;
+    uint8_t  aiSkillPct, jitterPct;
+    bool     use24Hour;
+    uint8_t  clockTransition;
+    uint16_t clockFadeMs;
+    bool     clockMinMarker;
+    uint8_t  clockDigitColour;
+    bool     clockTrail;
+};
+
+enum RenderOp : uint8_t {
+    RENDER_SETTINGS,
+    RENDER_EFFECT,
+    RENDER_GAME_INPUT,         // slot = LedGame
+    RENDER_OVERLAY,
+    RENDER_OVERLAY_CLEAR,      // slot, or every slot when slot == MAX_OVERLAYS
+    RENDER_CLIP_INSTALL,
+    RENDER_FRAME,              // slot = frameBufs index
+    RENDER_PERF_RESET,         // the render task's PerfStats sections
+    RENDER_TRACE_RESUME,       // the render lane, then recording
+};
+
+struct RenderCommand {
+    RenderOp op;
+    uint8_t  slot;
+    Effect   effect;           // RENDER_EFFECT
+    uint8_t  arg;              // restart flag / GameInput
+    union {
+        RenderSettings settings;
+        Overlay        overlay;
+    };
+};
+
+static SpscQueue<RenderCommand, RENDER_QUEUE_LEN> queue;
+static uint32_t queueDrops = 0;            // producer side only
+
+static Adafruit_NeoPixel *stripPtr = nullptr;
+static GridConfig         renderCfg;       // render task's copy of the settings
+static Effect             renderEffect = EFFECT_TETRIS;
+static RenderSettings     postedSettings;  // loop() side: last snapshot queued
+
+// External frames (MQTT) travel in two strip-order buffers: loop() borrows
+// a free one, fills it and posts it; the render task copies it into the
+// base layer and hands it back through freeFrames.
+static uint32_t                frameBufs[2][NUM_LEDS];
+static SpscQueue<uint8_t, 2>   freeFrames;         // render task -> loop()
+static int8_t                  borrowedFrame = -1; // loop() side
+static bool                    frameHeld = false;  // render side: Live shows an external frame
+static uint32_t                frameShownMs = 0;
+
+// loop() sets PENDING before posting an install; the render task stores
+// the result once it has run it.
+static std::atomic<uint8_t>    clipInstall{CLIP_INSTALL_IDLE};
+
+static void snapshotSettings(const GridConfig &cfg, RenderSettings &s) {
+    memset(&s, 0, sizeof(s));
+    s.brightness       = cfg.brightness;
+    s.bgR              = cfg.bgR;
+    s.bgG              = cfg.bgG;
+    s.bgB              = cfg.bgB;
+    s.dropStartMs      = cfg.dropStartMs;
+    s.dropMinMs        = cfg.dropMinMs;
+    s.moveIntervalMs   = cfg.moveIntervalMs;
+    s.rotIntervalMs    = cfg.rotIntervalMs;
+    s.aiSkillPct       = cfg.aiSkillPct;
+    s.jitterPct        = cfg.jitterPct;
+    s.use24Hour        = cfg.use24Hour;
+    s.clockTransition  = cfg.clockTransition;
+    s.clockFadeMs      = cfg.clockFadeMs;
+    s.clockMinMarker   = cfg.clockMinMarker;
+    s.clockDigitColour = cfg.clockDigitColour;
+    s.clockTrail       = cfg.clockTrail;
+}
+
+static bool post(const RenderCommand &cmd) {
+    if (queue.push(cmd)) return true;
+    queueDrops++;
+    return false;
+}
+
+// ─── Render side ───────────────────────────────────────────────────────────
+
+static void applySettings(const RenderSettings &s) {
+    if (s.brightness != renderCfg.brightness) setPowerBrightness(s.brightness);
+    if (s.use24Hour != renderCfg.use24Hour) setClockUse24Hour(s.use24Hour);
+    if (s.clockTransition != renderCfg.clockTransition) setClockTransition(s.clockTransition);
+    if (s.clockFadeMs != renderCfg.clockFadeMs) setClockFadeMs(s.clockFadeMs);
+    if (s.clockMinMarker != renderCfg.clockMinMarker) setClockMinMarker(s.clockMinMarker);
+    if (s.clockDigitColour != renderCfg.clockDigitColour) setClockDigitColour(s.clockDigitColour);
+    if (s.clockTrail != renderCfg.clockTrail) setClockTrail(s.clockTrail);
+
+    renderCfg.brightness       = s.brightness;
+    renderCfg.bgR              = s.bgR;
+    renderCfg.bgG              = s.bgG;
+    renderCfg.bgB              = s.bgB;
+    renderCfg.dropStartMs      = s.dropStartMs;
+    renderCfg.dropMinMs        = s.dropMinMs;
+    renderCfg.moveIntervalMs   = s.moveIntervalMs;
+    renderCfg.rotIntervalMs    = s.rotIntervalMs;
+    renderCfg.aiSkillPct       = s.aiSkillPct;
+    renderCfg.jitterPct        = s.jitterPct;
+    renderCfg.use24Hour        = s.use24Hour;
+    renderCfg.clockTransition  = s.clockTransition;
+    renderCfg.clockFadeMs      = s.clockFadeMs;
+    renderCfg.clockMinMarker   = s.clockMinMarker;
+    renderCfg.clockDigitColour = s.clockDigitColour;
+    renderCfg.clockTrail       = s.clockTrail;
+
+    games.configure(renderCfg);
+}
+
+static void applyEffect(Effect effect, bool restart) {
+    renderEffect = effect;
+    frameHeld    = false;
+    if (restart) {
+        compositor.base.clear();
+        compositor.base.show();
+    }
+    games.restart(gameFor(effect), restart);
+}
+
+static void showFrame(uint8_t slot) {
+    if (renderEffect == EFFECT_LIVE) {
+        compositor.base.setPixels(frameBufs[slot]);
+        compositor.base.show();
+        frameHeld    = true;
+        frameShownMs = millis();
+    }
+    freeFrames.push(slot);
+}
+
+// Blank Live once the last external frame has been held for
+// MQTT_FRAME_HOLD_MS, unless UDP input has drawn over it since.
+static void expireFrame(uint32_t now) {
+    if (!frameHeld || now - frameShownMs < MQTT_FRAME_HOLD_MS) return;
+    frameHeld = false;
+    uint32_t udpMs = udpInputStats().lastPacketMs;
+    if (udpMs != 0 && (int32_t)(udpMs - frameShownMs) >= 0) return;
+    compositor.base.clear();
+    compositor.base.show();
+}
+
+static void drainCommands() {
+    RenderCommand cmd;
+    while (queue.pop(cmd)) {
+        switch (cmd.op) {
+            case RENDER_SETTINGS:
+                applySettings(cmd.settings);
+                break;
+            case RENDER_EFFECT:
+                applyEffect(cmd.effect, cmd.arg != 0);
+                break;
+            case RENDER_GAME_INPUT:
+                games.input((LedGame)cmd.slot, (GameInput)cmd.arg);
+                break;
+            case RENDER_OVERLAY:
+                compositor.setOverlay(cmd.slot, cmd.overlay);
+                break;
+            case RENDER_OVERLAY_CLEAR:
+                if (cmd.slot >= MAX_OVERLAYS) compositor.clearOverlays();
+                else                          compositor.clearOverlay(cmd.slot);
+                break;
+            case RENDER_CLIP_INSTALL:
+                clipInstall.store(installClip() ? CLIP_INSTALL_OK : CLIP_INSTALL_FAILED);
+                break;
+            case RENDER_FRAME:
+                showFrame(cmd.slot);
+                break;
+            case RENDER_PERF_RESET:
+                perfResetRender();
+                break;
+            case RENDER_TRACE_RESUME:
+                traceResume(TRACE_LANE_RENDER);
+                break;
+        }
+    }
+}
+
+static void renderTask(void *) {
+    uint32_t lastUpdateMs = millis();
+
+    for (;;) {
+        uint32_t passStartCycles = tracePassStart(TRACE_LANE_RENDER);
+        uint32_t passStartUs = micros();
+        drainCommands();
+
+        uint32_t t = micros();
+        if (UDP_INPUT) {
+            loopUdpInput(compositor.base, renderEffect == EFFECT_LIVE);
+            perfLap(PERF_UDP, t);
+        }
+
+        // Render the base effect at its own frame rate
+        uint32_t now = millis();
+        expireFrame(now);
+        if (now - lastUpdateMs >= LED_UPDATE_INTERVAL_MS) {
+            uint32_t gapMs = now - lastUpdateMs;
+            lastUpdateMs = now;
+            uint32_t c = traceClock();
+            t = micros();
+            updateEffect(compositor.base, renderEffect);
+            perfRecordRender(renderEffect, micros() - t, gapMs);
+            traceSpan(TRACE_FRAME, c, renderEffect, TRACE_LANE_RENDER);
+        }
+
+        // Blend overlays over the latest base frame; shows only when something changed
+        uint32_t c = traceClock();
+        t = micros();
+        if (compositor.composite(*stripPtr)) {
+            perfLap(PERF_SHOW, t);
+            traceSpan(TRACE_SHOW, c, 0, TRACE_LANE_RENDER);
+        }
+
+        // The frame is finished: the board is whole for the WebSocket
+        publishGameBoard();
+
+        if (micros() - passStartUs >= TRACE_STALL_MS * 1000UL) traceStall(passStartCycles, TRACE_LANE_RENDER);
+
+        // One tick lets loop() and the idle task run between passes
+        vTaskDelay(1);
+    }
+}
+
+// ─── Public API ────────────────────────────────────────────────────────────
+
+void startRenderTask(Adafruit_NeoPixel &strip, const GridConfig &cfg) {
+    stripPtr     = &strip;
+    renderCfg    = cfg;
+    renderEffect = cfg.currentEffect;
+    snapshotSettings(cfg, postedSettings);
+    freeFrames.push(0);
+    freeFrames.push(1);
+    traceSyncLanes();
+
+    if (xTaskCreate(renderTask, "render", RENDER_TASK_STACK, nullptr,
+                    RENDER_TASK_PRIORITY, nullptr) != pdPASS) {
+        Serial.println(F("Render: task create failed"));
+    }
+}
+
+void syncRenderSettings(const GridConfig &cfg) {
+    RenderCommand cmd;
+    snapshotSettings(cfg, cmd.settings);
+    if (memcmp(&cmd.settings, &postedSettings, sizeof(postedSettings)) == 0) return;
+
+    cmd.op = RENDER_SETTINGS;
+    if (post(cmd)) postedSettings = cmd.settings;   // else retried next loop()
+}
+
+bool renderSetEffect(Effect effect, bool restart) {
+    RenderCommand cmd;
+    cmd.op     = RENDER_EFFECT;
+    cmd.effect = effect;
+    cmd.arg    = restart;
+    return post(cmd);
+}
+
+bool renderGameInput(LedGame game, GameInput input) {
+    RenderCommand cmd;
+    cmd.op   = RENDER_GAME_INPUT;
+    cmd.slot = game;
+    cmd.arg  = input;
+    return post(cmd);
+}
+
+bool renderSetOverlay(uint8_t slot, const Overlay &ov) {
+    if (slot >= MAX_OVERLAYS) return false;
+    RenderCommand cmd;
+    cmd.op      = RENDER_OVERLAY;
+    cmd.slot    = slot;
+    cmd.overlay = ov;
+    return post(cmd);
+}
+
+bool renderClearOverlay(uint8_t slot) {
+    if (slot >= MAX_OVERLAYS) return false;
+    RenderCommand cmd;
+    cmd.op   = RENDER_OVERLAY_CLEAR;
+    cmd.slot = slot;
+    return post(cmd);
+}
+
+bool renderClearOverlays() {
+    RenderCommand cmd;
+    cmd.op   = RENDER_OVERLAY_CLEAR;
+    cmd.slot = MAX_OVERLAYS;
+    return post(cmd);
+}
+
+bool renderInstallClip() {
+    if (clipInstall.load() == CLIP_INSTALL_PENDING) return false;
+    clipInstall.store(CLIP_INSTALL_PENDING);
+    RenderCommand cmd;
+    cmd.op = RENDER_CLIP_INSTALL;
+    if (post(cmd)) return true;
+    clipInstall.store(CLIP_INSTALL_IDLE);
+    return false;
+}
+
+ClipInstall renderClipInstall() {
+    return (ClipInstall)clipInstall.load();
+}
+
+uint32_t *renderBorrowFrame() {
+    if (borrowedFrame < 0) {
+        uint8_t slot;
+        if (!freeFrames.pop(slot)) return nullptr;
+        borrowedFrame = slot;
+    }
+    return frameBufs[borrowedFrame];
+}
+
+bool renderPostFrame() {
+    if (borrowedFrame < 0) return false;
+    RenderCommand cmd;
+    cmd.op   = RENDER_FRAME;
+    cmd.slot = borrowedFrame;
+    if (!post(cmd)) return false;      // stays borrowed for the next frame
+    borrowedFrame = -1;
+    return true;
+}
+
+bool renderResetPerf() {
+    RenderCommand cmd;
+    cmd.op = RENDER_PERF_RESET;
+    return post(cmd);
+}
+
+bool renderResumeTrace() {
+    RenderCommand cmd;
+    cmd.op = RENDER_TRACE_RESUME;
+    return post(cmd);
+}
+
+uint32_t renderQueueDrops() {
+    return queueDrops;
+}
@@ -0,0 +1,71 @@
+#ifndef RENDER_TASK_H
+#define RENDER_TASK_H
+
+#include <Arduino.h>
+#include <Adafruit_NeoPixel.h>
+#include "config.h"
+#include "led_effects.h"
+
+// ─── Render Task ───────────────────────────────────────────────────────────
+// Effects, games, overlays, UDP input and strip.show() all run in one
+// FreeRTOS task at RENDER_TASK_PRIORITY, above loop(). The network side
+// (web server, WebSocket, MQTT, the BOOT button) stays in loop() and never
+// touches render state: it posts commands into an SPSC queue that the
+// render task drains at the start of every pass. A slow HTTP request or
+// MQTT reconnect then delays the next command, not the next frame, and a
+// change is applied whole between two frames.
+//
+// loop() is the queue's only producer and the render task its only
+// consumer, so neither side locks. The post functions return false (and
+// count a drop) when the queue is full.
+
+// Start rendering `cfg.currentEffect` onto strip with the settings in cfg.
+// Call once, at the end of setup(); everything setup() did to render state
+// before this is seen by the task.
+void startRenderTask(Adafruit_NeoPixel &strip, const GridConfig &cfg);
+
+// Post the render-side settings (brightness, background, Tetris tuning,
+// clock options) if they changed since the last call. Call every loop();
+// handlers just edit the config.
+void syncRenderSettings(const GridConfig &cfg);
+
+// Switch effects. `restart` also blanks the base layer and hands the new
+// game back to the AI (the BOOT button).
+bool renderSetEffect(Effect effect, bool restart = false);
+
+// A phone control for `game`; anything but Snake drives Tetris.
+bool renderGameInput(LedGame game, GameInput input);
+
+bool renderSetOverlay(uint8_t slot, const Overlay &ov);
+bool renderClearOverlay(uint8_t slot);
+bool renderClearOverlays();
+
+// Swap CLIP_TMP_PATH in as the clip between two frames. False if the queue
+// is full or the last install hasn't run yet; the caller must not touch
+// CLIP_TMP_PATH until renderClipInstall() is no longer CLIP_INSTALL_PENDING.
+enum ClipInstall : uint8_t {
+    CLIP_INSTALL_IDLE,         // none posted since boot
+    CLIP_INSTALL_PENDING,      // queued, the render task hasn't run it yet
+    CLIP_INSTALL_OK,
+    CLIP_INSTALL_FAILED,       // installClip() failed: rename or invalid clip
+};
+bool renderInstallClip();
+ClipInstall renderClipInstall();
+
+// Frames pushed from loop() (MQTT). Borrow one of two strip-order
+// buffers, fill it and post it; the render task shows it if EFFECT_LIVE
+// is selected and frees the buffer again. nullptr while both are in
+// flight. A buffer that isn't posted stays borrowed for the next frame.
+uint32_t *renderBorrowFrame();
+bool renderPostFrame();
+
+// Clear what the render task records itself, between two passes: its
+// PerfStats sections (perfResetRender()) and its trace lane, which also
+// restarts a frozen trace (traceResume()). loop() clears its own part.
+bool renderResetPerf();
+bool renderResumeTrace();
+
+// Commands dropped because the queue was full, since boot.
+uint32_t renderQueueDrops();
+
+#endif // RENDER_TASK_H
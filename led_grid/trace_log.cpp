@@ -0,0 +1,196 @@
+#include "trace_log.h"
+
+#define TRACE_CLOCK_BITS     40              // 32-bit cycle count + 8 bits of wraps
+#define TRACE_TIMELINE_BASE  (1ULL << 41)   // the anchor's place on the unwrapped timeline
+#define TRACE_JSON_SPAN_MAX  200           // longest single event in the export
+#define TRACE_PAUSE_WAIT_MS  100           // export: longest wait for the render lane to go quiet
+
+TraceRecord traceRing[TRACE_LANES][TRACE_EVENTS];
+uint32_t    traceHead[TRACE_LANES];
+uint32_t    traceStopAt[TRACE_LANES];
+std::atomic<bool>     traceRecording{true};
+std::atomic<uint32_t> tracePasses[TRACE_LANES];
+uint32_t              traceLastClock[TRACE_LANES];
+uint8_t               traceWraps[TRACE_LANES];
+
+struct TraceEventInfo {
+    const char *name;
+    const char *category;
+    const char *argName;     // nullptr: arg unused
+};
+
+static const TraceEventInfo EVENT_INFO[TRACE_EVENT_COUNT] = {
+    {"frame",          "render", "effect"},
+    {"show",           "render", nullptr},
+    {"ws.receive",     "ws",     "client"},
+    {"ws.broadcast",   "ws",     "bytes"},
+    {"http",           "http",   nullptr},
+    {"mqtt.publish",   "mqtt",   "kind"},
+    {"mqtt.reconnect", "mqtt",   "connected"},
+    {"nvs.save",       "nvs",    nullptr},
+    {"stall",          "loop",   nullptr},
+};
+
+static const char *const PUBLISH_KINDS[] = {"state", "diagnostics", "discovery"};
+static const char *const LANE_NAMES[TRACE_LANES] = {"loop", "render"};
+
+static bool freezePending() {
+    for (uint8_t l = 0; l < TRACE_LANES; l++) {
+        if (traceStopAt[l]) return true;
+    }
+    return false;
+}
+
+void traceStall(uint32_t start, TraceLane lane) {
+    if (!TRACE_ENABLED || !traceRecording.load()) return;
+    traceSpan(TRACE_STALL, start, 0, lane);
+    if (!freezePending()) {
+        traceStopAt[lane] = traceHead[lane] + TRACE_EVENTS / 4;
+        if (traceStopAt[lane] == 0) traceStopAt[lane] = 1;
+    }
+}
+
+void traceSyncLanes() {
+    uint32_t now = traceClock();
+    for (uint8_t l = 0; l < TRACE_LANES; l++) {
+        traceLastClock[l] = now;
+        traceWraps[l]     = 0;
+    }
+}
+
+void traceResume(TraceLane lane) {
+    traceHead[lane]   = 0;
+    traceStopAt[lane] = 0;
+    if (lane == TRACE_LANE_RENDER) traceRecording.store(true);
+}
+
+// ─── Export ────────────────────────────────────────────────────────────────
+
+static inline uint32_t spanEnd(const TraceRecord &r) {
+    return r.start + r.cycles;
+}
+
+// Place r's end on the export timeline: its 40-bit end time, taken as the
+// nearest value to the anchor (good for spans up to 2^39 cycles, 57 min at
+// 160 MHz, either side of it).
+static uint64_t unwrappedEnd(const TraceExport &ex, const TraceRecord &r) {
+    const uint64_t mask = (1ULL << TRACE_CLOCK_BITS) - 1;
+    uint64_t end = ((uint64_t)r.wraps << 32) | spanEnd(r);
+    uint64_t d   = (end - ex.anchor) & mask;
+    if (d & (1ULL << (TRACE_CLOCK_BITS - 1))) d -= 1ULL << TRACE_CLOCK_BITS;   // before the anchor
+    return TRACE_TIMELINE_BASE + d;
+}
+
+// Microseconds with three decimals (Chrome's "ts" and "dur" unit).
+static int formatUs(char *buf, size_t size, uint64_t cycles, uint32_t mhz) {
+    uint32_t whole = (uint32_t)(cycles / mhz);
+    uint32_t frac  = (uint32_t)((cycles % mhz) * 1000 / mhz);
+    return snprintf(buf, size, "%lu.%03lu", (unsigned long)whole, (unsigned long)frac);
+}
+
+// After recording is switched off: wait for the render task to start a
+// pass. A span it had begun before then is written by now, and every span
+// after sees the switch off. Gives up after TRACE_PAUSE_WAIT_MS (a render
+// task that isn't running writes nothing anyway).
+static void waitRenderQuiet() {
+    uint32_t pass  = tracePasses[TRACE_LANE_RENDER].load();
+    uint32_t start = millis();
+    while (tracePasses[TRACE_LANE_RENDER].load() == pass && millis() - start < TRACE_PAUSE_WAIT_MS) {
+        delay(1);
+    }
+}
+
+void traceExportBegin(TraceExport &ex) {
+    ex.wasRecording = traceRecording.load();
+    traceRecording.store(false);
+    waitRenderQuiet();
+
+    ex.mhz   = getCpuFrequencyMhz();
+    ex.stage = 0;
+    ex.lane  = 0;
+    ex.comma = false;
+
+    // The newest span of the first lane that has one anchors the timeline;
+    // the earliest start fixes ts = 0
+    bool haveAnchor = false;
+    ex.origin = TRACE_TIMELINE_BASE;
+    for (uint8_t l = 0; l < TRACE_LANES; l++) {
+        uint32_t head  = traceHead[l];
+        uint32_t count = head < TRACE_EVENTS ? head : TRACE_EVENTS;
+        ex.first[l] = head - count;
+        ex.end[l]   = head;
+        if (count && !haveAnchor) {
+            const TraceRecord &newest = traceRing[l][(head - 1) & (TRACE_EVENTS - 1)];
+            ex.anchor  = ((uint64_t)newest.wraps << 32) | spanEnd(newest);
+            haveAnchor = true;
+        }
+        for (uint32_t i = ex.first[l]; i != head; i++) {
+            const TraceRecord &r = traceRing[l][i & (TRACE_EVENTS - 1)];
+            uint64_t start = unwrappedEnd(ex, r) - r.cycles;
+            if (start < ex.origin) ex.origin = start;
+        }
+    }
+    ex.next = ex.first[0];
+}
+
+size_t traceExportNext(TraceExport &ex, char *buf, size_t size) {
+    size_t len = 0;
+
+    if (ex.stage == 0) {
+        uint32_t spans  = 0;
+        bool     frozen = false;
+        for (uint8_t l = 0; l < TRACE_LANES; l++) {
+            spans += ex.end[l] - ex.first[l];
+            if (traceStopAt[l] && traceHead[l] == traceStopAt[l]) frozen = true;
+        }
+        len = snprintf(buf, size, "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"cpuMHz\":%lu,"
+                       "\"spans\":%lu,\"frozen\":%s},\"traceEvents\":[",
+                       (unsigned long)ex.mhz, (unsigned long)spans, frozen ? "true" : "false");
+        for (uint8_t l = 0; l < TRACE_LANES; l++) {
+            len += snprintf(buf + len, size - len,
+                            "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                            "\"args\":{\"name\":\"%s\"}}",
+                            ex.comma ? "," : "", l + 1, LANE_NAMES[l]);
+            ex.comma = true;
+        }
+        ex.stage = 1;
+    }
+
+    while (ex.stage == 1 && size - len >= TRACE_JSON_SPAN_MAX) {
+        if (ex.next == ex.end[ex.lane]) {
+            if (++ex.lane == TRACE_LANES) {
+                ex.stage = 2;
+                break;
+            }
+            ex.next = ex.first[ex.lane];
+            continue;
+        }
+        const TraceRecord &r = traceRing[ex.lane][ex.next & (TRACE_EVENTS - 1)];
+        const TraceEventInfo &info = EVENT_INFO[r.event < TRACE_EVENT_COUNT ? r.event : (uint8_t)TRACE_STALL];
+        uint64_t start = unwrappedEnd(ex, r) - r.cycles - ex.origin;
+
+        char ts[16], dur[16];
+        formatUs(ts, sizeof(ts), start, ex.mhz);
+        formatUs(dur, sizeof(dur), r.cycles, ex.mhz);
+        len += snprintf(buf + len, size - len,
+                        "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                        "\"ts\":%s,\"dur\":%s",
+                        ex.comma ? "," : "", info.name, info.category, ex.lane + 1, ts, dur);
+        if (r.event == TRACE_MQTT_PUBLISH && r.arg < sizeof(PUBLISH_KINDS) / sizeof(PUBLISH_KINDS[0])) {
+            len += snprintf(buf + len, size - len, ",\"args\":{\"kind\":\"%s\"}}", PUBLISH_KINDS[r.arg]);
+        } else if (info.argName) {
+            len += snprintf(buf + len, size - len, ",\"args\":{\"%s\":%u}}", info.argName, r.arg);
+        } else {
+            len += snprintf(buf + len, size - len, "}");
+        }
+        ex.comma = true;
+        ex.next++;
+    }
+
+    if (ex.stage == 2 && size - len >= 3) {
+        len += snprintf(buf + len, size - len, "]}");
+        ex.stage = 3;
+        traceRecording.store(ex.wasRecording);
+    }
+    return len;
+}
@@ -0,0 +1,152 @@
+#ifndef TRACE_LOG_H
+#define TRACE_LOG_H
+
+#include <Arduino.h>
+#include "config.h"
+#include <atomic>
+
+// ─── Event Trace ───────────────────────────────────────────────────────────
+// A fixed ring of the last TRACE_EVENTS timed spans — frames, shows,
+// WebSocket traffic, HTTP requests, MQTT publishes and reconnects, NVS
+// saves — exported by /api/trace as Chrome trace-event JSON (load it in
+// chrome://tracing or ui.perfetto.dev).
+//
+// A span is written once, when it ends: start and length in CPU cycles, so
+// recording is a cycle-counter read and a 12-byte store into the ring. Each
+// task records into its own lane (a ring of its own, one trace-viewer
+// thread each), so the rings need no locking. Each lane also counts
+// cycle-counter wraps (every 26.8 s at 160 MHz) and stamps them on its
+// spans, which puts every span end on one 40-bit timeline (1.9 h).
+//
+// A loop() iteration or render pass longer than TRACE_STALL_MS is recorded
+// as a "stall" span; recording then continues for a quarter of a ring and
+// stops, so the stall and what led up to it survive until someone fetches
+// the trace.
+//
+// Only the switch itself, traceRecording, is shared. Everything else in a
+// lane is written by its own task, including clearing it: loop() resumes
+// its lane and posts renderResumeTrace() for the render task's.
+
+enum TraceEvent : uint8_t {
+    TRACE_FRAME,             // updateEffect()            arg: effect
+    TRACE_SHOW,              // composite + strip.show()
+    TRACE_WS_RECEIVE,        // WebSocket command         arg: client
+    TRACE_WS_BROADCAST,      // game state to the client  arg: bytes
+    TRACE_HTTP,              // handleClient() that served a request
+    TRACE_MQTT_PUBLISH,      // state/diagnostics/discovery  arg: TracePublish
+    TRACE_MQTT_RECONNECT,    // broker connect attempt    arg: 1 = connected
+    TRACE_NVS_SAVE,          // saveGridConfig()
+    TRACE_STALL,             // loop() or render pass over TRACE_STALL_MS
+    TRACE_EVENT_COUNT
+};
+
+enum TracePublish : uint8_t {
+    TRACE_PUB_STATE,
+    TRACE_PUB_DIAGNOSTICS,
+    TRACE_PUB_DISCOVERY,
+};
+
+enum TraceLane : uint8_t {
+    TRACE_LANE_LOOP,         // loop(): network, persistence
+    TRACE_LANE_RENDER,       // render task: frames and shows
+    TRACE_LANES
+};
+
+struct TraceRecord {
+    uint32_t start;          // cycle counter at the start
+    uint32_t cycles;         // length
+    uint8_t  event;
+    uint8_t  wraps;          // lane's counter wraps at the end, mod 256
+    uint16_t arg;
+};
+
+static_assert((TRACE_EVENTS & (TRACE_EVENTS - 1)) == 0, "TRACE_EVENTS must be a power of two");
+
+extern TraceRecord traceRing[TRACE_LANES][TRACE_EVENTS];
+extern uint32_t    traceHead[TRACE_LANES];     // spans written since boot / resume
+extern uint32_t    traceStopAt[TRACE_LANES];   // freeze when traceHead reaches this (0 = never)
+extern std::atomic<bool>     traceRecording;
+extern std::atomic<uint32_t> tracePasses[TRACE_LANES];   // passes started, per lane
+extern uint32_t              traceLastClock[TRACE_LANES];
+extern uint8_t               traceWraps[TRACE_LANES];
+
+inline uint32_t traceClock() {
+    return ESP.getCycleCount();
+}
+
+// traceClock() for a lane's own task, counting wraps. Each task calls it at
+// least once per pass so an idle lane still sees every wrap.
+inline uint32_t traceTick(TraceLane lane) {
+    uint32_t now = traceClock();
+    if (now < traceLastClock[lane]) traceWraps[lane]++;
+    traceLastClock[lane] = now;
+    return now;
+}
+
+// traceTick() at the start of a task's pass. The count tells
+// traceExportBegin() when a span the task began before a pause is over.
+inline uint32_t tracePassStart(TraceLane lane) {
+    tracePasses[lane].store(tracePasses[lane].load(std::memory_order_relaxed) + 1);
+    return traceTick(lane);
+}
+
+// Record a span that started at `start` (a traceClock() value) and ends now.
+// Only the lane's own task may write to it.
+inline void traceSpan(TraceEvent e, uint32_t start, uint16_t arg = 0,
+                      TraceLane lane = TRACE_LANE_LOOP) {
+    if (!TRACE_ENABLED || !traceRecording.load()) return;
+    TraceRecord &r = traceRing[lane][traceHead[lane]++ & (TRACE_EVENTS - 1)];
+    r.start  = start;
+    r.cycles = traceTick(lane) - start;
+    r.event  = e;
+    r.wraps  = traceWraps[lane];
+    r.arg    = arg;
+    if (traceHead[lane] == traceStopAt[lane]) traceRecording.store(false);
+}
+
+// Spans a block of loop-task code: { TraceScope trace(TRACE_NVS_SAVE); ... }
+struct TraceScope {
+    TraceEvent event;
+    uint16_t   arg;
+    uint32_t   start;
+    explicit TraceScope(TraceEvent e, uint16_t a = 0) : event(e), arg(a), start(traceClock()) {}
+    ~TraceScope() { traceSpan(event, start, arg); }
+};
+
+// Record a stall span from `start` and freeze every lane once this one has
+// recorded another quarter-ring (unless a freeze is already pending).
+void traceStall(uint32_t start, TraceLane lane = TRACE_LANE_LOOP);
+
+// Start every lane's wrap count from now. Call just before a second
+// recording task starts, so the lanes agree on the timeline.
+void traceSyncLanes();
+
+// Clear `lane`'s ring, from its own task. Resuming the render lane also
+// starts recording again after a freeze, once both lanes are clear.
+void traceResume(TraceLane lane);
+
+// ─── Export ────────────────────────────────────────────────────────────────
+// Chrome JSON is produced in chunks so the whole trace never has to sit in
+// RAM: traceExportBegin() pauses recording and waits (up to
+// TRACE_PAUSE_WAIT_MS) for the render task to start a new pass, so no span
+// of its is still being written; then each traceExportNext() fills `buf`
+// with whole events until it returns 0 (recording resumes once the last
+// chunk is out). Call them from loop().
+
+struct TraceExport {
+    uint32_t first[TRACE_LANES];     // oldest span in each ring
+    uint32_t end[TRACE_LANES];
+    uint8_t  lane;                   // lane being written
+    uint32_t next;                   // its next ring position
+    uint64_t anchor;                 // a span end all others are placed against
+    uint64_t origin;                 // earliest start on the unwrapped timeline
+    uint32_t mhz;
+    uint8_t  stage;                  // header, events, footer, done
+    bool     wasRecording;
+    bool     comma;                  // an event has been written
+};
+
+void   traceExportBegin(TraceExport &ex);
+size_t traceExportNext(TraceExport &ex, char *buf, size_t size);   // needs size >= 256
+
+#endif // TRACE_LOG_H
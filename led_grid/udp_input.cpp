@@ -0,0 +1,343 @@
+#include "udp_input.h"
+#include "led_effects.h"
+#include <WiFiUdp.h>
+
+// ─── Protocol Constants ────────────────────────────────────────────────────
+
+#define DDP_HEADER_LEN       10
+#define DDP_TIMECODE_LEN     4
+#define DDP_VERSION_MASK     0xC0
+#define DDP_VERSION_1        0x40
+#define DDP_FLAG_TIMECODE    0x10
+#define DDP_FLAG_QUERY       0x02
+#define DDP_FLAG_PUSH        0x01
+#define DDP_ID_DISPLAY       1       // default output device
+
+#define E131_FRAMING_AT      44      // bytes up to and including the framing vector
+#define E131_HEADER_LEN      126     // through the DMX start code
+#define E131_SYNC_LEN        49
+#define E131_ROOT_DATA       0x00000004
+#define E131_ROOT_EXTENDED   0x00000008
+#define E131_FRAME_DATA      0x00000002
+#define E131_FRAME_SYNC      0x00000001
+#define E131_OPT_PREVIEW     0x80
+#define E131_OPT_TERMINATED  0x40
+
+#define ARTNET_OP_AT         10      // bytes up to and including the opcode
+#define ARTNET_HEADER_LEN    18      // ArtDmx through the length field
+#define ARTNET_OP_DMX        0x5000
+#define ARTNET_OP_SYNC       0x5200
+
+// ─── Frame Layout ──────────────────────────────────────────────────────────
+
+#define UNIVERSE_CHANNELS    (UDP_PIXELS_PER_UNIVERSE * 3)
+#define GRID_CHANNELS        ((uint32_t)NUM_LEDS * 3)
+#define UDP_UNIVERSES        ((NUM_LEDS + UDP_PIXELS_PER_UNIVERSE - 1) / UDP_PIXELS_PER_UNIVERSE)
+#define ALL_UNIVERSES        ((uint32_t)((1ULL << UDP_UNIVERSES) - 1))
+#define SYNC_TIMEOUT_MS      4000    // no sync for this long → frame by universes
+#define READ_CHUNK           48      // bytes per read when discarding a packet
+
+static_assert(UDP_UNIVERSES <= 32, "universe bitmask holds 32 universes");
+
+static const uint8_t ACN_ID[12]    = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+static const uint8_t ARTNET_ID[8]  = {'A', 'r', 't', '-', 'N', 'e', 't', 0};
+
+static inline uint16_t be16(const uint8_t *p) { return ((uint16_t)p[0] << 8) | p[1]; }
+static inline uint32_t be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+// ─── State ─────────────────────────────────────────────────────────────────
+
+static WiFiUDP ddpUdp;
+static WiFiUDP e131Udp;
+static WiFiUDP artnetUdp;
+
+static UdpInputStats stats = {0, 0, 0, 0, 0, 0, 0, ""};
+
+// The frame being received, in screen order as it arrives. It reaches the
+// base layer only when presented, so overlay ticks in between composite
+// the last whole frame rather than half of the next one.
+static uint8_t  staging[GRID_CHANNELS];
+
+static bool     framePending  = false;   // pixels written since the last present
+static uint32_t frameStartMs  = 0;       // first packet of the pending frame
+static uint32_t universesSeen = 0;       // universes written into the pending frame
+static bool     syncSeen      = false;   // sender frames with sync packets
+static uint32_t lastSyncMs    = 0;
+
+// Last sequence number per universe, per protocol.
+struct SeqTrack {
+    uint8_t  seq[UDP_UNIVERSES];
+    uint32_t seen;                       // bit u set once universe u has a sequence
+};
+static SeqTrack e131Seq   = {{0}, 0};
+static SeqTrack artnetSeq = {{0}, 0};
+static uint8_t  ddpLastSeq = 0;          // 1-15, 0 = none yet
+
+static bool syncMode(uint32_t now) {
+    return syncSeen && now - lastSyncMs < SYNC_TIMEOUT_MS;
+}
+
+static void noteSync(uint32_t now) {
+    syncSeen   = true;
+    lastSyncMs = now;
+}
+
+// ─── Framebuffer Writes ────────────────────────────────────────────────────
+
+// Read `len` payload bytes from the socket into the staging frame at
+// channel `ch` of the screen-order stream. Bytes past the end of the grid
+// are left for skipPacket().
+static void streamPixels(WiFiUDP &udp, uint32_t ch, uint16_t len) {
+    if (ch >= GRID_CHANNELS) return;
+    if (len > GRID_CHANNELS - ch) len = GRID_CHANNELS - ch;
+    while (len > 0) {
+        int n = udp.read(staging + ch, len);
+        if (n <= 0) break;
+        ch  += n;
+        len -= n;
+    }
+}
+
+// Discard whatever is left of the current packet.
+static void skipPacket(WiFiUDP &udp) {
+    uint8_t junk[READ_CHUNK];
+    while (udp.read(junk, sizeof(junk)) > 0) {}
+}
+
+static void beginFrame(uint32_t now) {
+    if (framePending) return;
+    framePending = true;
+    frameStartMs = now;
+}
+
+// Hand the pending frame to the compositor. `complete` = every expected
+// packet (or a push/sync) arrived; otherwise it is counted late.
+static void presentLive(Canvas &canvas, bool complete) {
+    if (!framePending) return;
+    const uint8_t *p = staging;
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        for (uint8_t x = 0; x < GRID_WIDTH; x++, p += 3) {
+            canvas.setPixelColor(screenToIndex(x, y), p[0], p[1], p[2]);
+        }
+    }
+    canvas.show();
+    stats.frames++;
+    if (!complete) stats.late++;
+    framePending  = false;
+    universesSeen = 0;
+}
+
+// ─── Sequencing ────────────────────────────────────────────────────────────
+
+// Check a universe's sequence number. Returns false for a stale packet,
+// which is discarded (E1.31: -20 < diff <= 0). Art-Net skips 0 on wrap.
+static bool acceptSequence(SeqTrack &t, uint8_t u, uint8_t seq, bool skipsZero) {
+    if (t.seen & (1UL << u)) {
+        int16_t diff = (int8_t)(seq - t.seq[u]);
+        if (skipsZero && seq < t.seq[u]) diff--;
+        if (diff <= 0 && diff > -20) {
+            stats.outOfOrder++;
+            return false;
+        }
+        if (diff > 1) stats.dropped += diff - 1;
+    }
+    t.seq[u]  = seq;
+    t.seen   |= 1UL << u;
+    return true;
+}
+
+// Write one E1.31/Art-Net universe's payload and present the frame once
+// every universe is in (unless the sender syncs).
+static void applyUniverse(Canvas &canvas, WiFiUDP &udp, uint8_t u, uint16_t len, uint32_t now) {
+    bool synced = syncMode(now);
+
+    // A universe repeating before the frame completed means another was lost
+    if (!synced && (universesSeen & (1UL << u))) presentLive(canvas, false);
+
+    beginFrame(now);
+    if (len > UNIVERSE_CHANNELS) len = UNIVERSE_CHANNELS;
+    streamPixels(udp, (uint32_t)u * UNIVERSE_CHANNELS, len);
+    universesSeen |= 1UL << u;
+    stats.packets++;
+    stats.lastPacketMs = now;
+
+    if (!synced && universesSeen == ALL_UNIVERSES) presentLive(canvas, true);
+}
+
+// ─── Protocol Handlers ─────────────────────────────────────────────────────
+
+static void handleDdp(Canvas &canvas, int size, uint32_t now) {
+    uint8_t hdr[DDP_HEADER_LEN + DDP_TIMECODE_LEN];
+    if (size < DDP_HEADER_LEN || ddpUdp.read(hdr, DDP_HEADER_LEN) != DDP_HEADER_LEN ||
+        (hdr[0] & DDP_VERSION_MASK) != DDP_VERSION_1) {
+        stats.invalid++;
+        return;
+    }
+    // Queries, status and config IDs aren't answered
+    if ((hdr[0] & DDP_FLAG_QUERY) || (hdr[3] != DDP_ID_DISPLAY && hdr[3] != 0)) return;
+
+    int hdrLen = DDP_HEADER_LEN;
+    if (hdr[0] & DDP_FLAG_TIMECODE) {
+        if (ddpUdp.read(hdr + DDP_HEADER_LEN, DDP_TIMECODE_LEN) != DDP_TIMECODE_LEN) {
+            stats.invalid++;
+            return;
+        }
+        hdrLen += DDP_TIMECODE_LEN;
+    }
+
+    // Sequence cycles 1-15; 0 means the sender doesn't number packets
+    uint8_t seq = hdr[1] & 0x0F;
+    if (seq && ddpLastSeq) {
+        uint8_t diff = (uint8_t)((seq + 15 - ddpLastSeq) % 15);
+        if (diff == 0 || diff > 7) {
+            stats.outOfOrder++;
+            return;
+        }
+        stats.dropped += diff - 1;
+    }
+    if (seq) ddpLastSeq = seq;
+
+    uint32_t offset = be32(hdr + 4);
+    uint16_t len    = be16(hdr + 8);
+    if (len > size - hdrLen) len = size - hdrLen;
+
+    beginFrame(now);
+    streamPixels(ddpUdp, offset, len);
+    stats.packets++;
+    stats.lastPacketMs = now;
+    stats.protocol     = "ddp";
+
+    if (hdr[0] & DDP_FLAG_PUSH) presentLive(canvas, true);
+}
+
+static void handleE131(Canvas &canvas, int size, uint32_t now) {
+    uint8_t hdr[E131_HEADER_LEN];
+    if (size < E131_SYNC_LEN || e131Udp.read(hdr, E131_FRAMING_AT) != E131_FRAMING_AT ||
+        memcmp(hdr + 4, ACN_ID, sizeof(ACN_ID)) != 0) {
+        stats.invalid++;
+        return;
+    }
+
+    uint32_t rootVec  = be32(hdr + 18);
+    uint32_t frameVec = be32(hdr + 40);
+    if (rootVec == E131_ROOT_EXTENDED && frameVec == E131_FRAME_SYNC) {
+        noteSync(now);
+        presentLive(canvas, true);
+        return;
+    }
+    if (rootVec != E131_ROOT_DATA || frameVec != E131_FRAME_DATA || size < E131_HEADER_LEN ||
+        e131Udp.read(hdr + E131_FRAMING_AT, E131_HEADER_LEN - E131_FRAMING_AT)
+            != E131_HEADER_LEN - E131_FRAMING_AT) {
+        stats.invalid++;
+        return;
+    }
+
+    // DMP set-property with the null start code only; no preview or
+    // stream-terminated packets
+    uint8_t options = hdr[112];
+    if (hdr[117] != 0x02 || hdr[125] != 0) return;
+    if (options & (E131_OPT_PREVIEW | E131_OPT_TERMINATED)) return;
+
+    uint16_t universe = be16(hdr + 113);
+    int u = (int)universe - E131_START_UNIVERSE;
+    if (u < 0 || u >= UDP_UNIVERSES) return;
+
+    if (be16(hdr + 109) != 0) noteSync(now);   // sync address: sender will follow up
+    if (!acceptSequence(e131Seq, u, hdr[111], false)) return;
+
+    uint16_t count = be16(hdr + 123);            // start code + channels
+    uint16_t len   = count ? count - 1 : 0;
+    if (len > size - E131_HEADER_LEN) len = size - E131_HEADER_LEN;
+
+    stats.protocol = "e131";
+    applyUniverse(canvas, e131Udp, u, len, now);
+}
+
+static void handleArtNet(Canvas &canvas, int size, uint32_t now) {
+    uint8_t hdr[ARTNET_HEADER_LEN];
+    if (size < ARTNET_OP_AT || artnetUdp.read(hdr, ARTNET_OP_AT) != ARTNET_OP_AT ||
+        memcmp(hdr, ARTNET_ID, sizeof(ARTNET_ID)) != 0) {
+        stats.invalid++;
+        return;
+    }
+
+    uint16_t op = hdr[8] | ((uint16_t)hdr[9] << 8);   // little-endian
+    if (op == ARTNET_OP_SYNC) {
+        noteSync(now);
+        presentLive(canvas, true);
+        return;
+    }
+    if (op != ARTNET_OP_DMX) return;                    // ArtPoll etc. not answered
+
+    if (size < ARTNET_HEADER_LEN ||
+        artnetUdp.read(hdr + ARTNET_OP_AT, ARTNET_HEADER_LEN - ARTNET_OP_AT)
+            != ARTNET_HEADER_LEN - ARTNET_OP_AT) {
+        stats.invalid++;
+        return;
+    }
+
+    uint16_t universe = hdr[14] | ((uint16_t)(hdr[15] & 0x7F) << 8);  // net:subnet:universe
+    int u = (int)universe - ARTNET_START_UNIVERSE;
+    if (u < 0 || u >= UDP_UNIVERSES) return;
+
+    // Sequence 0 = sender doesn't number packets
+    if (hdr[12] && !acceptSequence(artnetSeq, u, hdr[12], true)) return;
+
+    uint16_t len = be16(hdr + 16);
+    if (len > size - ARTNET_HEADER_LEN) len = size - ARTNET_HEADER_LEN;
+
+    stats.protocol = "artnet";
+    applyUniverse(canvas, artnetUdp, u, len, now);
+}
+
+// ─── Public API ────────────────────────────────────────────────────────────
+
+void setupUdpInput() {
+    ddpUdp.begin(DDP_PORT);
+    e131Udp.begin(E131_PORT);
+    artnetUdp.begin(ARTNET_PORT);
+    Serial.printf("UDP input: DDP %d, E1.31 %d (universe %d+), Art-Net %d (universe %d+)\n",
+                  DDP_PORT, E131_PORT, E131_START_UNIVERSE, ARTNET_PORT, ARTNET_START_UNIVERSE);
+}
+
+void loopUdpInput(Canvas &canvas, bool live) {
+    uint32_t now    = millis();
+    uint8_t  budget = UDP_MAX_PACKETS_PER_LOOP;
+
+    if (!live) framePending = false;
+
+    while (budget > 0) {
+        bool any = false;
+        int size;
+        if ((size = ddpUdp.parsePacket()) > 0) {
+            if (live) handleDdp(canvas, size, now);
+            skipPacket(ddpUdp);
+            budget--;
+            any = true;
+        }
+        if (budget > 0 && (size = e131Udp.parsePacket()) > 0) {
+            if (live) handleE131(canvas, size, now);
+            skipPacket(e131Udp);
+            budget--;
+            any = true;
+        }
+        if (budget > 0 && (size = artnetUdp.parsePacket()) > 0) {
+            if (live) handleArtNet(canvas, size, now);
+            skipPacket(artnetUdp);
+            budget--;
+            any = true;
+        }
+        if (!any) break;
+    }
+
+    // Lost packet or missing sync: don't hold a partial frame forever
+    if (framePending && now - frameStartMs >= UDP_FRAME_DEADLINE_MS) {
+        presentLive(canvas, false);
+    }
+}
+
+const UdpInputStats &udpInputStats() {
+    return stats;
+}
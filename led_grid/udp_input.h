@@ -0,0 +1,46 @@
+#ifndef UDP_INPUT_H
+#define UDP_INPUT_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "led_effects.h"
+
+// ─── UDP Pixel Input ───────────────────────────────────────────────────────
+// Live frames from a lighting controller over DDP (port 4048), E1.31/sACN
+// (5568, unicast) or Art-Net (6454). Pixel data is RGB in screen order —
+// row by row from the top-left as the viewer sees it — and is read from
+// the socket straight into a staging frame (768 bytes for 16x16), which is
+// copied into the base layer when presented. Until then the compositor
+// keeps showing the last whole frame, under any overlays and through the
+// current limiter.
+//
+// A frame is presented on a DDP push flag, an E1.31 sync packet or an
+// ArtSync, or once every universe of the grid has arrived when the sender
+// isn't syncing. A frame still incomplete UDP_FRAME_DEADLINE_MS after its
+// first packet is presented as it stands and counted late.
+//
+// Packets are only applied while EFFECT_LIVE is showing; otherwise they
+// are drained and ignored. Each call handles at most UDP_MAX_PACKETS_PER_LOOP
+// packets so a flood can't starve the web server.
+
+struct UdpInputStats {
+    uint32_t packets;        // pixel packets applied
+    uint32_t frames;         // frames presented
+    uint32_t dropped;        // packets missing from the sequence
+    uint32_t late;           // frames presented incomplete at the deadline
+    uint32_t outOfOrder;     // stale sequence numbers (discarded)
+    uint32_t invalid;        // malformed or unsupported packets
+    uint32_t lastPacketMs;   // millis() of the last pixel packet, 0 = none
+    const char *protocol;    // "ddp", "e131", "artnet" or "" before the first packet
+};
+
+// Open the listening sockets. Call once WiFi is up.
+void setupUdpInput();
+
+// Drain pending packets and present completed frames. Call every render
+// pass (from the render task).
+void loopUdpInput(Canvas &canvas, bool live);
+
+const UdpInputStats &udpInputStats();
+
+#endif // UDP_INPUT_H
@@ -1,15 +1,22 @@
 #include "web_server.h"
 #include "html_pages_gz.h"
 #include "persistence.h"
-#include "tetris_effect.h"
-#include "snake_game.h"
 #include "led_effects.h"
 #include "websocket_handler.h"
 #include "mqtt_client.h"
+#include "udp_input.h"
+#include "gif_import.h"
+#include "gif_player.h"
+#include "power_limit.h"
+#include "perf_stats.h"
+#include "trace_log.h"
+#include "render_task.h"
+#include "json_stream.h"
+#include "ota_update.h"
 #include <WebServer.h>
 #include <Preferences.h>
 #include <WiFi.h>
-#include <Update.h>
+#include <LittleFS.h>
 #include <Adafruit_NeoPixel.h>
 
 static WebServer server(80);
@@ -71,8 +78,22 @@ static void redirectLogin() {
 }
 
 // ─── Gzip Page Helper ─────────────────────────────────────────────────────
+// Every page carries the content-hash ETag compress_html.py gave it. The
+// browser keeps its copy but must ask again on each visit ("no-cache"), so
+// the session check still runs; an unchanged page costs a bodyless 304
+// instead of the full download. "private" keeps shared caches out.
+
+static void sendGzPage(const uint8_t *data, size_t len, const char *etag) {
+    server.sendHeader("ETag", etag);
+    server.sendHeader("Cache-Control", "private, no-cache");
+
+    // If-None-Match may list several tags; any match (or *) will do
+    String match = server.header("If-None-Match");
+    if (match.length() > 0 && (match.indexOf(etag) >= 0 || match == "*")) {
+        server.send(304);
+        return;
+    }
 
-static void sendGzPage(const uint8_t *data, size_t len) {
     server.sendHeader("Content-Encoding", "gzip");
     server.send_P(200, "text/html", (const char *)data, len);
 }
@@ -80,7 +101,7 @@ static void sendGzPage(const uint8_t *data, size_t len) {
 // ─── Route Handlers ────────────────────────────────────────────────────────
 
 static void handleLoginPage() {
-    sendGzPage(LOGIN_PAGE_GZ, LOGIN_PAGE_GZ_LEN);
+    sendGzPage(LOGIN_PAGE_GZ, LOGIN_PAGE_GZ_LEN, LOGIN_PAGE_GZ_ETAG);
 }
 
 static void handleLoginPost() {
@@ -123,17 +144,17 @@ static void handleLogout() {
 
 static void handleDashboard() {
     if (!isAuthenticated()) { redirectLogin(); return; }
-    sendGzPage(DASHBOARD_PAGE_GZ, DASHBOARD_PAGE_GZ_LEN);
+    sendGzPage(DASHBOARD_PAGE_GZ, DASHBOARD_PAGE_GZ_LEN, DASHBOARD_PAGE_GZ_ETAG);
 }
 
 static void handleSettings() {
     if (!isAuthenticated()) { redirectLogin(); return; }
-    sendGzPage(SETTINGS_PAGE_GZ, SETTINGS_PAGE_GZ_LEN);
+    sendGzPage(SETTINGS_PAGE_GZ, SETTINGS_PAGE_GZ_LEN, SETTINGS_PAGE_GZ_ETAG);
 }
 
 static void handleTetrisPage() {
     if (!isAuthenticated()) { redirectLogin(); return; }
-    sendGzPage(TETRIS_PAGE_GZ, TETRIS_PAGE_GZ_LEN);
+    sendGzPage(TETRIS_PAGE_GZ, TETRIS_PAGE_GZ_LEN, TETRIS_PAGE_GZ_ETAG);
 }
 
 // ─── API Handlers ──────────────────────────────────────────────────────────
@@ -145,75 +166,66 @@ static void handleApiStatus() {
     unsigned long days = up / 86400;
     unsigned long hours = (up % 86400) / 3600;
     unsigned long mins = (up % 3600) / 60;
-
-    char buf[768];
-    int written = snprintf(buf, sizeof(buf),
-        "{\"version\":\"%s\","
-        "\"uptime\":\"%lud %luh %lum\","
-        "\"freeHeap\":%lu,"
-        "\"effect\":%d,"
-        "\"brightness\":%d,"
-        "\"manualMode\":%s,"
-        "\"bgR\":%d,\"bgG\":%d,\"bgB\":%d,"
-        "\"dropStartMs\":%d,"
-        "\"dropMinMs\":%d,"
-        "\"moveIntervalMs\":%d,"
-        "\"rotIntervalMs\":%d,"
-        "\"aiSkillPct\":%d,"
-        "\"jitterPct\":%d,"
-        "\"use24Hour\":%s,"
-        "\"clockTransition\":%d,"
-        "\"clockFadeMs\":%d,"
-        "\"clockMinMarker\":%s,"
-        "\"clockDigitColour\":%d,"
-        "\"clockTrail\":%s,"
-        "\"ssid\":\"%s\","
-        "\"ip\":\"%s\","
-        "\"mqttEnabled\":%s,"
-        "\"mqttConnected\":%s,"
-        "\"mqttHost\":\"%s\","
-        "\"mqttPort\":%d,"
-        "\"mqttUsername\":\"%s\"}",
-        FW_VERSION,
-        days, hours, mins,
-        (unsigned long)ESP.getFreeHeap(),
-        (int)cfgPtr->currentEffect,
-        cfgPtr->brightness,
-        cfgPtr->manualMode ? "true" : "false",
-        cfgPtr->bgR, cfgPtr->bgG, cfgPtr->bgB,
-        cfgPtr->dropStartMs,
-        cfgPtr->dropMinMs,
-        cfgPtr->moveIntervalMs,
-        cfgPtr->rotIntervalMs,
-        cfgPtr->aiSkillPct,
-        cfgPtr->jitterPct,
-        cfgPtr->use24Hour ? "true" : "false",
-        cfgPtr->clockTransition,
-        cfgPtr->clockFadeMs,
-        cfgPtr->clockMinMarker ? "true" : "false",
-        cfgPtr->clockDigitColour,
-        cfgPtr->clockTrail ? "true" : "false",
-        WiFi.SSID().c_str(),
-        WiFi.localIP().toString().c_str(),
-        cfgPtr->mqtt.enabled ? "true" : "false",
-        isMqttConnected() ? "true" : "false",
-        cfgPtr->mqtt.host,
-        cfgPtr->mqtt.port,
-        cfgPtr->mqtt.username);
-
-    if (written >= (int)sizeof(buf)) {
-        server.send(500, "text/plain", "Response too large");
-        return;
-    }
-
-    server.send(200, "application/json", buf);
+    char uptime[24];
+    snprintf(uptime, sizeof(uptime), "%lud %luh %lum", days, hours, mins);
+
+    const UdpInputStats &udp = udpInputStats();
+    const PowerStats &power = powerStats();
+
+    JsonStream json(server);
+    json.beginObject();
+    json.add("version",            FW_VERSION);
+    json.add("uptime",             uptime);
+    json.add("freeHeap",           (unsigned long)ESP.getFreeHeap());
+    json.add("effect",             (int)cfgPtr->currentEffect);
+    json.add("brightness",         cfgPtr->brightness);
+    json.add("manualMode",         cfgPtr->manualMode);
+    json.add("bgR",                cfgPtr->bgR);
+    json.add("bgG",                cfgPtr->bgG);
+    json.add("bgB",                cfgPtr->bgB);
+    json.add("dropStartMs",        cfgPtr->dropStartMs);
+    json.add("dropMinMs",          cfgPtr->dropMinMs);
+    json.add("moveIntervalMs",     cfgPtr->moveIntervalMs);
+    json.add("rotIntervalMs",      cfgPtr->rotIntervalMs);
+    json.add("aiSkillPct",         cfgPtr->aiSkillPct);
+    json.add("jitterPct",          cfgPtr->jitterPct);
+    json.add("use24Hour",          cfgPtr->use24Hour);
+    json.add("clockTransition",    cfgPtr->clockTransition);
+    json.add("clockFadeMs",        cfgPtr->clockFadeMs);
+    json.add("clockMinMarker",     cfgPtr->clockMinMarker);
+    json.add("clockDigitColour",   cfgPtr->clockDigitColour);
+    json.add("clockTrail",         cfgPtr->clockTrail);
+    json.add("ssid",               WiFi.SSID().c_str());
+    json.add("ip",                 WiFi.localIP().toString().c_str());
+    json.add("mqttEnabled",        cfgPtr->mqtt.enabled);
+    json.add("mqttConnected",      isMqttConnected());
+    json.add("mqttHost",           cfgPtr->mqtt.host);
+    json.add("mqttPort",           cfgPtr->mqtt.port);
+    json.add("mqttUsername",       cfgPtr->mqtt.username);
+    json.add("udpProtocol",        udp.protocol);
+    json.add("udpPackets",         (unsigned long)udp.packets);
+    json.add("udpFrames",          (unsigned long)udp.frames);
+    json.add("udpDropped",         (unsigned long)udp.dropped);
+    json.add("udpLate",            (unsigned long)udp.late);
+    json.add("udpOutOfOrder",      (unsigned long)udp.outOfOrder);
+    json.add("udpInvalid",         (unsigned long)udp.invalid);
+    json.add("clipFrames",         clipFrameCount());
+    json.add("powerMa",            (unsigned long)power.estimatedMa);
+    json.add("powerDemandMa",      (unsigned long)power.demandMa);
+    json.add("powerBudgetMa",      (unsigned)POWER_BUDGET_MA);
+    json.add("powerBrightness",    power.brightness);
+    json.add("powerLimited",       power.limiting);
+    json.add("powerLimitedFrames", (unsigned long)power.limitedFrames);
+    json.add("renderQueueDrops",   (unsigned long)renderQueueDrops());
+    json.endObject();
+    json.finish();
 }
 
 static void handleApiBrightness() {
     if (!isAuthenticated()) { server.send(401, "text/plain", "Auth required"); return; }
     int val = server.arg("value").toInt();
     cfgPtr->brightness = constrain(val, 0, 255);
-    // Brightness is applied in the main loop via strip.setBrightness()
+    // Brightness reaches the render task via syncRenderSettings()
     mqttPublishState();
     server.send(200, "application/json", "{\"ok\":true}");
 }
@@ -224,11 +236,7 @@ static void handleApiEffect() {
     if (val >= 0 && val < EFFECT_COUNT) {
         cfgPtr->currentEffect = (Effect)val;
         setWsActiveEffect(cfgPtr->currentEffect);
-        if (cfgPtr->currentEffect == EFFECT_TETRIS) {
-            resetTetris();
-        } else if (cfgPtr->currentEffect == EFFECT_SNAKE) {
-            resetSnake();
-        }
+        renderSetEffect(cfgPtr->currentEffect);
         mqttPublishState();
     }
     server.send(200, "application/json", "{\"ok\":true}");
@@ -250,32 +258,20 @@ static void handleApiTuning() {
     if (server.hasArg("jitterPct"))
         cfgPtr->jitterPct = constrain(server.arg("jitterPct").toInt(), 0, 50);
 
-    if (server.hasArg("use24Hour")) {
+    if (server.hasArg("use24Hour"))
         cfgPtr->use24Hour = server.arg("use24Hour") == "1";
-        setClockUse24Hour(cfgPtr->use24Hour);
-    }
-    if (server.hasArg("clockTransition")) {
+    if (server.hasArg("clockTransition"))
         cfgPtr->clockTransition = constrain(server.arg("clockTransition").toInt(), 0, 1);
-        setClockTransition(cfgPtr->clockTransition);
-    }
-    if (server.hasArg("clockFadeMs")) {
+    if (server.hasArg("clockFadeMs"))
         cfgPtr->clockFadeMs = constrain(server.arg("clockFadeMs").toInt(), 200, 2000);
-        setClockFadeMs(cfgPtr->clockFadeMs);
-    }
-    if (server.hasArg("clockMinMarker")) {
+    if (server.hasArg("clockMinMarker"))
         cfgPtr->clockMinMarker = server.arg("clockMinMarker") == "1";
-        setClockMinMarker(cfgPtr->clockMinMarker);
-    }
-    if (server.hasArg("clockDigitColour")) {
+    if (server.hasArg("clockDigitColour"))
         cfgPtr->clockDigitColour = constrain(server.arg("clockDigitColour").toInt(), 0, 5);
-        setClockDigitColour(cfgPtr->clockDigitColour);
-    }
-    if (server.hasArg("clockTrail")) {
+    if (server.hasArg("clockTrail"))
         cfgPtr->clockTrail = server.arg("clockTrail") == "1";
-        setClockTrail(cfgPtr->clockTrail);
-    }
 
-    setTetrisConfig(*cfgPtr);
+    // Applied by the render task via syncRenderSettings()
     server.send(200, "application/json", "{\"ok\":true}");
 }
 
@@ -286,7 +282,6 @@ static void handleApiBackground() {
     if (server.hasArg("g")) cfgPtr->bgG = constrain(server.arg("g").toInt(), 0, 40);
     if (server.hasArg("b")) cfgPtr->bgB = constrain(server.arg("b").toInt(), 0, 40);
 
-    setTetrisConfig(*cfgPtr);
     server.send(200, "application/json", "{\"ok\":true}");
 }
 
@@ -308,7 +303,6 @@ static void handleApiSave() {
 static void handleApiDefaults() {
     if (!isAuthenticated()) { server.send(401, "text/plain", "Auth required"); return; }
     initDefaultConfig(*cfgPtr);
-    setTetrisConfig(*cfgPtr);
     saveGridConfig(*cfgPtr);
     server.send(200, "application/json", "{\"ok\":true}");
 }
@@ -355,50 +349,271 @@ static void handleApiMqtt() {
     server.send(200, "application/json", "{\"ok\":true}");
 }
 
+static void handleApiOverlay() {
+    if (!isAuthenticated()) { server.send(401, "text/plain", "Auth required"); return; }
+
+    // slot=all&type=none clears every overlay
+    if (server.arg("slot") == "all") {
+        renderClearOverlays();
+        server.send(200, "application/json", "{\"ok\":true}");
+        return;
+    }
+
+    int slot = server.hasArg("slot") ? server.arg("slot").toInt() : 0;
+    if (slot < 0 || slot >= MAX_OVERLAYS) {
+        server.send(400, "text/plain", "Bad slot");
+        return;
+    }
+
+    Overlay ov;
+    compositor.overlayDefaults(ov);
+    ov.type = overlayTypeFromName(server.arg("type").c_str());
+    if (ov.type == OVERLAY_NONE) {
+        renderClearOverlay(slot);
+        server.send(200, "application/json", "{\"ok\":true}");
+        return;
+    }
+
+    if (server.hasArg("x"))        ov.x = constrain(server.arg("x").toInt(), -GRID_WIDTH, GRID_WIDTH);
+    if (server.hasArg("y"))        ov.y = constrain(server.arg("y").toInt(), -GRID_HEIGHT, GRID_HEIGHT);
+    if (server.hasArg("w"))        ov.w = constrain(server.arg("w").toInt(), 0, GRID_WIDTH);
+    if (server.hasArg("h"))        ov.h = constrain(server.arg("h").toInt(), 0, GRID_HEIGHT);
+    if (server.hasArg("alpha"))    ov.alpha = constrain(server.arg("alpha").toInt(), 0, 255);
+    if (server.hasArg("blend"))    ov.blend = blendModeFromName(server.arg("blend").c_str());
+    if (server.hasArg("scroll"))   ov.scrollMs = constrain(server.arg("scroll").toInt(), 0, 2000);
+    if (server.hasArg("duration")) ov.durationMs = constrain(server.arg("duration").toInt(), 0, 3600000);
+    if (server.hasArg("colour")) {
+        String c = server.arg("colour");
+        if (c.startsWith("#")) c = c.substring(1);
+        ov.colour = strtoul(c.c_str(), nullptr, 16) & 0xFFFFFF;
+    }
+    if (server.hasArg("text")) {
+        String t = server.arg("text");
+        strncpy(ov.text, t.c_str(), sizeof(ov.text) - 1);
+        ov.text[sizeof(ov.text) - 1] = '\0';
+    }
+    if (server.hasArg("sprite")) {
+        // Comma-separated hex rows, bit 15 = leftmost pixel
+        String rows = server.arg("sprite");
+        const char *p = rows.c_str();
+        uint8_t n = 0;
+        while (*p && n < OVERLAY_SPRITE_MAX) {
+            char *end;
+            ov.sprite[n++] = (uint16_t)strtoul(p, &end, 16);
+            if (*end != ',') break;
+            p = end + 1;
+        }
+        if (!server.hasArg("h")) ov.h = n;
+        if (!server.hasArg("w")) ov.w = OVERLAY_SPRITE_MAX;
+    }
+
+    renderSetOverlay(slot, ov);
+    server.send(200, "application/json", "{\"ok\":true}");
+}
+
+// ─── Performance Counters ──────────────────────────────────────────────────
+// GET /api/perf — counters since boot or the last reset; ?reset=1 clears
+// them after this report.
+
+static void handleApiPerf() {
+    if (!isAuthenticated()) { server.send(401, "text/plain", "Auth required"); return; }
+
+    const PerfStats &p = perfStats();
+    JsonStream json(server);
+    json.beginObject();
+    json.add("enabled",         PERF_STATS);
+    json.add("periodMs",        (unsigned long)(millis() - p.sinceMs));
+    json.add("frames",          (unsigned long)p.frames);
+    json.add("deadlineMisses",  (unsigned long)p.deadlineMisses);
+    json.add("worstGapMs",      (unsigned long)p.worstGapMs);
+    json.add("frameIntervalMs", LED_UPDATE_INTERVAL_MS);
+    json.beginArray("bucketsUs");
+    for (uint8_t b = 0; b + 1 < PERF_BUCKETS; b++) {
+        json.add((unsigned long)perfBucketLimitUs(b));
+    }
+    json.endArray();
+
+    json.beginObject("sections");
+    for (uint8_t i = 0; i < PERF_SECTIONS; i++) {
+        const PerfCounter &c = p.sections[i];
+        json.beginObject(perfSectionName((PerfSection)i));
+        json.add("count", (unsigned long)c.count);
+        json.add("avgUs", (unsigned long)perfAvgUs(c.totalUs, c.count));
+        json.add("maxUs", (unsigned long)c.maxUs);
+        json.beginArray("hist");
+        for (uint8_t b = 0; b < PERF_BUCKETS; b++) {
+            json.add((unsigned long)c.hist[b]);
+        }
+        json.endArray();
+        json.endObject();
+    }
+    json.endObject();
+
+    json.beginObject("effects");
+    for (uint8_t i = 0; i < EFFECT_COUNT; i++) {
+        const PerfEffect &e = p.effects[i];
+        if (e.count == 0) continue;
+        json.beginObject(EFFECT_NAMES[i]);
+        json.add("count", (unsigned long)e.count);
+        json.add("avgUs", (unsigned long)perfAvgUs(e.totalUs, e.count));
+        json.add("maxUs", (unsigned long)e.maxUs);
+        json.endObject();
+    }
+    json.endObject();
+    json.endObject();
+    json.finish();
+
+    if (server.arg("reset") == "1") {
+        perfResetLoop();
+        renderResetPerf();
+    }
+}
+
+// ─── Event Trace ───────────────────────────────────────────────────────────
+// GET /api/trace — Chrome trace-event JSON, streamed in chunks. ?resume=1
+// clears the ring and restarts recording after a stall froze it.
+
+static void handleApiTrace() {
+    if (!isAuthenticated()) { server.send(401, "text/plain", "Auth required"); return; }
+
+    TraceExport ex;
+    traceExportBegin(ex);
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.sendHeader("Content-Disposition", "attachment; filename=\"ledgrid-trace.json\"");
+    server.send(200, "application/json", "");
+
+    char chunk[1024];
+    size_t n;
+    while ((n = traceExportNext(ex, chunk, sizeof(chunk))) > 0) {
+        server.sendContent(chunk, n);
+    }
+    server.sendContent("");
+
+    if (server.arg("resume") == "1") {
+        traceResume(TRACE_LANE_LOOP);
+        renderResumeTrace();
+    }
+}
+
+// A queued save would be lost with the restart: give a failed write a
+// couple more tries first.
+static void flushBeforeRestart() {
+    for (uint8_t attempt = 0; attempt < 3 && !flushGridConfig(); attempt++) delay(100);
+}
+
 static void handleApiRestart() {
     if (!isAuthenticated()) { server.send(401, "text/plain", "Auth required"); return; }
     server.send(200, "application/json", "{\"ok\":true}");
+    flushBeforeRestart();
     delay(500);
     ESP.restart();
 }
 
+// ─── GIF Upload ────────────────────────────────────────────────────────────
+// The upload is spooled to LittleFS as it arrives, then decoded into the
+// clip file in one pass once complete.
+
+#define GIF_UPLOAD_PATH  "/upload.gif"
+
+static File gifUpload;
+static bool gifTooLarge = false;
+
+static void handleGifResult() {
+    if (!isAuthenticated()) { server.send(401, "text/plain", "Auth required"); return; }
+    if (gifTooLarge) {
+        LittleFS.remove(GIF_UPLOAD_PATH);
+        server.send(413, "application/json", "{\"ok\":false,\"error\":\"GIF too large\"}");
+        return;
+    }
+
+    const char *err = nullptr;
+    uint16_t frames = importGifClip(GIF_UPLOAD_PATH, &err);
+    LittleFS.remove(GIF_UPLOAD_PATH);
+
+    char buf[96];
+    if (frames == 0) {
+        snprintf(buf, sizeof(buf), "{\"ok\":false,\"error\":\"%s\"}", err ? err : "Import failed");
+        server.send(400, "application/json", buf);
+        return;
+    }
+    snprintf(buf, sizeof(buf), "{\"ok\":true,\"frames\":%u}", frames);
+    server.send(200, "application/json", buf);
+}
+
+static void handleGifUpload() {
+    if (!isAuthenticated()) return;
+    HTTPUpload &upload = server.upload();
+
+    if (upload.status == UPLOAD_FILE_START) {
+        Serial.printf("GIF: %s\n", upload.filename.c_str());
+        gifTooLarge = false;
+        gifUpload = LittleFS.open(GIF_UPLOAD_PATH, "w");
+    } else if (upload.status == UPLOAD_FILE_WRITE) {
+        if (upload.totalSize + upload.currentSize > GIF_MAX_UPLOAD) gifTooLarge = true;
+        if (gifUpload && !gifTooLarge) gifUpload.write(upload.buf, upload.currentSize);
+    } else if (upload.status == UPLOAD_FILE_END || upload.status == UPLOAD_FILE_ABORTED) {
+        if (gifUpload) gifUpload.close();
+    }
+}
+
 // ─── OTA Update ────────────────────────────────────────────────────────────
 
 static void handleUpdatePage() {
     if (!isAuthenticated()) { redirectLogin(); return; }
-    sendGzPage(UPDATE_PAGE_GZ, UPDATE_PAGE_GZ_LEN);
+    sendGzPage(UPDATE_PAGE_GZ, UPDATE_PAGE_GZ_LEN, UPDATE_PAGE_GZ_ETAG);
 }
 
 static void handleUpdateResult() {
     if (!isAuthenticated()) { server.send(401, "text/plain", "Auth required"); return; }
-    server.send(200, "text/html",
-        Update.hasError()
-            ? "<html><body><h2>Update failed!</h2><a href='/'>Back</a></body></html>"
-            : "<html><body><h2>Update OK! Rebooting...</h2></body></html>");
+    const OtaStatus &ota = otaStatus();
+    bool ok = ota.state == OTA_DONE;
+
+    char buf[200];
+    if (ok) {
+        snprintf(buf, sizeof(buf),
+            "<html><body><h2>Update OK! Rebooting...</h2>"
+            "<p>%lu KB sent for a %lu KB image in %lu.%lu s (%lu KB/s)</p></body></html>",
+            (unsigned long)(ota.received / 1024), (unsigned long)(ota.written / 1024),
+            (unsigned long)(ota.elapsedMs / 1000), (unsigned long)(ota.elapsedMs % 1000 / 100),
+            (unsigned long)otaKBps());
+    } else {
+        snprintf(buf, sizeof(buf),
+            "<html><body><h2>Update failed!</h2><p>%s</p><a href='/'>Back</a></body></html>",
+            ota.error ? ota.error : "No firmware received");
+    }
+    server.send(ok ? 200 : 500, "text/html", buf);
+    if (!ok) return;
+
+    flushBeforeRestart();
     delay(1000);
-    if (!Update.hasError()) ESP.restart();
+    ESP.restart();
 }
 
 static void handleUpdateUpload() {
     if (!isAuthenticated()) return;
-    HTTPUpload &upload = server.upload();
+    otaUpload(server.upload(),
+              server.arg("offset").toInt(),
+              server.arg("size").toInt(),
+              server.arg("md5").c_str());
+}
 
-    if (upload.status == UPLOAD_FILE_START) {
-        Serial.printf("OTA: %s\n", upload.filename.c_str());
-        if (!Update.begin(UPDATE_SIZE_UNKNOWN)) {
-            Update.printError(Serial);
-        }
-    } else if (upload.status == UPLOAD_FILE_WRITE) {
-        if (Update.write(upload.buf, upload.currentSize) != upload.currentSize) {
-            Update.printError(Serial);
-        }
-    } else if (upload.status == UPLOAD_FILE_END) {
-        if (Update.end(true)) {
-            Serial.println(F("OTA: Success"));
-        } else {
-            Update.printError(Serial);
-        }
-    }
+// GET /api/ota — upload progress; `received` is where to resume from
+static void handleApiOta() {
+    if (!isAuthenticated()) { server.send(401, "text/plain", "Auth required"); return; }
+    const OtaStatus &ota = otaStatus();
+
+    JsonStream json(server);
+    json.beginObject();
+    json.add("state", otaStateName(ota.state));
+    json.add("compressed", ota.compressed);
+    json.add("received", (unsigned long)ota.received);
+    json.add("written", (unsigned long)ota.written);
+    json.add("size", (unsigned long)ota.size);
+    json.add("ms", (unsigned long)ota.elapsedMs);
+    json.add("kbps", (unsigned long)otaKBps());
+    if (ota.error) json.add("error", ota.error);
+    json.endObject();
+    json.finish();
 }
 
 // ─── Setup & Loop ──────────────────────────────────────────────────────────
@@ -407,8 +622,8 @@ void setupWebServer(GridConfig &cfg) {
     cfgPtr = &cfg;
     loadSession();
 
-    const char *headerKeys[] = {"Cookie"};
-    server.collectHeaders(headerKeys, 1);
+    const char *headerKeys[] = {"Cookie", "If-None-Match"};
+    server.collectHeaders(headerKeys, 2);
 
     // Pages
     server.on("/",         HTTP_GET,  handleDashboard);
@@ -430,12 +645,21 @@ void setupWebServer(GridConfig &cfg) {
     server.on("/api/defaults",   HTTP_POST, handleApiDefaults);
     server.on("/api/ws-token",   HTTP_GET,  handleApiWsToken);
     server.on("/api/mqtt",       HTTP_POST, handleApiMqtt);
+    server.on("/api/overlay",    HTTP_POST, handleApiOverlay);
     server.on("/api/restart",    HTTP_POST, handleApiRestart);
+    server.on("/api/gif",        HTTP_POST, handleGifResult, handleGifUpload);
+    server.on("/api/perf",       HTTP_GET,  handleApiPerf);
+    server.on("/api/ota",        HTTP_GET,  handleApiOta);
+    server.on("/api/trace",      HTTP_GET,  handleApiTrace);
 
     server.begin();
     Serial.println(F("Web server started on port 80"));
 }
 
 void loopWebServer() {
+    // Idle polls aren't worth a trace slot; anything longer served a request
+    static const uint32_t minCycles = TRACE_HTTP_MIN_US * getCpuFrequencyMhz();
+    uint32_t start = traceClock();
     server.handleClient();
+    if (traceClock() - start >= minCycles) traceSpan(TRACE_HTTP, start);
 }
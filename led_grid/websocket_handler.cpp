@@ -1,195 +1,208 @@
 #include "websocket_handler.h"
-#include "tetris_effect.h"
-#include "snake_game.h"
-#include <WebSocketsServer.h>
-#include <ArduinoJson.h>
-
-static WebSocketsServer ws(81);
-static bool clientConnected = false;
-static bool clientAuthenticated = false;
-static uint8_t activeClient = 0;
-static unsigned long lastBroadcastMs = 0;
-#define WS_BROADCAST_INTERVAL_MS 100  // 10 FPS
-
-// Which game is currently active (for command routing + broadcast)
-static Effect wsActiveEffect = EFFECT_TETRIS;
+#include "led_effects.h"
+#include "render_task.h"
+#include "gif_player.h"
+#include "mqtt_client.h"
+#include "perf_stats.h"
+#include "power_limit.h"
+#include "trace_log.h"
+#include <WiFi.h>
+#include <game_socket.h>
+
+// Auth, the game pad and board broadcasts live in LedCore; this file adds
+// the dashboard's status push and hands game controls to the render task.
+static GameSocket<GridGeometry> gameSocket(games);
+
+static const GridConfig *cfgPtr = nullptr;
 
 void setWsActiveEffect(Effect effect) {
-    wsActiveEffect = effect;
+    gameSocket.setGame(gameFor(effect));
 }
 
-// ─── Auth ──────────────────────────────────────────────────────────────────
-
-static char wsAuthToken[20] = {0};
-
 void setWebSocketAuthToken(const char *token) {
-    strncpy(wsAuthToken, token, sizeof(wsAuthToken) - 1);
-    wsAuthToken[sizeof(wsAuthToken) - 1] = '\0';
+    gameSocket.setAuthToken(token);
 }
 
-// ─── Command Handler ───────────────────────────────────────────────────────
-
-static void handleCommand(uint8_t num, const String &text) {
-    JsonDocument doc;
-    DeserializationError err = deserializeJson(doc, text);
-    if (err) return;
-
-    const char *cmd = doc["cmd"];
-    if (!cmd) return;
-
-    // First message must be auth
-    if (!clientAuthenticated) {
-        if (strcmp(cmd, "auth") == 0) {
-            const char *token = doc["token"];
-            if (token && strcmp(token, wsAuthToken) == 0) {
-                clientAuthenticated = true;
-                ws.sendTXT(num, "{\"auth\":true}");
-                Serial.printf("WS: Client %u authenticated\n", num);
-            } else {
-                ws.sendTXT(num, "{\"auth\":false}");
-                ws.disconnect(num);
-                Serial.printf("WS: Client %u auth failed\n", num);
-            }
-        }
-        return;
-    }
+// ─── Status Push ───────────────────────────────────────────────────────────
+// The dashboard subscribes with {"cmd":"status"} and gets the full status
+// once, then only the fields that changed:
+//
+//   {"status":{"brightness":60},"full":false}
+//
+// Changes are looked for every WS_STATUS_CHECK_MS. Uptime and free heap
+// move all the time, so they only ride along on the full snapshot sent
+// every WS_STATUS_HEARTBEAT_MS.
+
+#define WS_STATUS_CHECK_MS      250
+#define WS_STATUS_HEARTBEAT_MS  15000
+
+enum StatusField : uint8_t {
+    ST_EFFECT,
+    ST_BRIGHTNESS,
+    ST_BG_R,
+    ST_BG_G,
+    ST_BG_B,
+    ST_AI_SKILL,
+    ST_DROP_START,
+    ST_CLIP_FRAMES,
+    ST_MQTT,
+    ST_POWER_LIMITED,
+    ST_DEADLINE_MISSES,
+    ST_WORST_GAP,
+    ST_UPTIME,
+    ST_FREE_HEAP,
+    ST_FIELDS
+};
+
+// Keys match /api/status where the field exists there
+static const struct { const char *key; bool isBool; bool heartbeatOnly; } STATUS_FIELDS[ST_FIELDS] = {
+    {"effect",         false, false},
+    {"brightness",     false, false},
+    {"bgR",            false, false},
+    {"bgG",            false, false},
+    {"bgB",            false, false},
+    {"aiSkillPct",     false, false},
+    {"dropStartMs",    false, false},
+    {"clipFrames",     false, false},
+    {"mqttConnected",  true,  false},
+    {"powerLimited",   true,  false},
+    {"deadlineMisses", false, false},
+    {"worstGapMs",     false, false},
+    {"uptimeS",        false, true},
+    {"freeHeap",       false, true},
+};
+
+static uint32_t statusSent[ST_FIELDS];     // values in the last push
+static unsigned long lastStatusCheckMs = 0;
+static unsigned long lastStatusFullMs = 0;
+static char statusBuf[512];
+
+static void readStatus(uint32_t *v) {
+    const PerfStats &perf = perfStats();
+    v[ST_EFFECT]          = cfgPtr->currentEffect;
+    v[ST_BRIGHTNESS]      = cfgPtr->brightness;
+    v[ST_BG_R]            = cfgPtr->bgR;
+    v[ST_BG_G]            = cfgPtr->bgG;
+    v[ST_BG_B]            = cfgPtr->bgB;
+    v[ST_AI_SKILL]        = cfgPtr->aiSkillPct;
+    v[ST_DROP_START]      = cfgPtr->dropStartMs;
+    v[ST_CLIP_FRAMES]     = clipFrameCount();
+    v[ST_MQTT]            = isMqttConnected();
+    v[ST_POWER_LIMITED]   = powerStats().limiting;
+    v[ST_DEADLINE_MISSES] = perf.deadlineMisses;
+    v[ST_WORST_GAP]       = perf.worstGapMs;
+    v[ST_UPTIME]          = millis() / 1000;
+    v[ST_FREE_HEAP]       = ESP.getFreeHeap();
+}
 
-    // ── Snake commands ──
-    if (wsActiveEffect == EFFECT_SNAKE) {
-        if (strcmp(cmd, "left") == 0) {
-            snakeSetDirection(3);  // DIR_LEFT
-        } else if (strcmp(cmd, "right") == 0) {
-            snakeSetDirection(1);  // DIR_RIGHT
-        } else if (strcmp(cmd, "rotate") == 0) {
-            snakeSetDirection(0);  // DIR_UP (rotate button = up on d-pad)
-        } else if (strcmp(cmd, "drop") == 0) {
-            snakeSetDirection(2);  // DIR_DOWN (drop button = down on d-pad)
-        } else if (strcmp(cmd, "up") == 0) {
-            snakeSetDirection(0);
-        } else if (strcmp(cmd, "down") == 0) {
-            snakeSetDirection(2);
-        } else if (strcmp(cmd, "manual") == 0) {
-            setSnakeManualMode(true);
-        } else if (strcmp(cmd, "ai") == 0) {
-            setSnakeManualMode(false);
+// Build {"status":{...},"full":...} from the fields set in `mask`.
+// Returns the length, 0 if there is nothing to send.
+static int buildStatus(const uint32_t *v, uint32_t mask, bool full) {
+    if (!mask) return 0;
+    int pos = snprintf(statusBuf, sizeof(statusBuf), "{\"status\":{");
+    bool first = true;
+    for (uint8_t f = 0; f < ST_FIELDS; f++) {
+        if (!(mask & (1UL << f))) continue;
+        if (STATUS_FIELDS[f].isBool) {
+            pos += snprintf(statusBuf + pos, sizeof(statusBuf) - pos, "%s\"%s\":%s",
+                            first ? "" : ",", STATUS_FIELDS[f].key, v[f] ? "true" : "false");
+        } else {
+            pos += snprintf(statusBuf + pos, sizeof(statusBuf) - pos, "%s\"%s\":%lu",
+                            first ? "" : ",", STATUS_FIELDS[f].key, (unsigned long)v[f]);
         }
-        return;
+        first = false;
     }
-
-    // ── Tetris commands (default) ──
-    if (strcmp(cmd, "left") == 0) {
-        manualMoveLeft();
-    } else if (strcmp(cmd, "right") == 0) {
-        manualMoveRight();
-    } else if (strcmp(cmd, "rotate") == 0) {
-        manualRotate();
-    } else if (strcmp(cmd, "drop") == 0) {
-        manualHardDrop();
-    } else if (strcmp(cmd, "softdrop") == 0) {
-        bool active = doc["active"] | false;
-        manualSoftDrop(active);
-    } else if (strcmp(cmd, "manual") == 0) {
-        setManualMode(true);
-    } else if (strcmp(cmd, "ai") == 0) {
-        setManualMode(false);
+    if (full) {
+        pos += snprintf(statusBuf + pos, sizeof(statusBuf) - pos, ",\"ip\":\"%s\"",
+                        WiFi.localIP().toString().c_str());
     }
+    pos += snprintf(statusBuf + pos, sizeof(statusBuf) - pos, "},\"full\":%s}",
+                    full ? "true" : "false");
+    return pos < (int)sizeof(statusBuf) ? pos : 0;
 }
 
-// ─── WebSocket Events ──────────────────────────────────────────────────────
+static void pushStatus(bool full) {
+    uint32_t traceStart = traceClock();
+    uint32_t now[ST_FIELDS];
+    readStatus(now);
 
-static void onWsEvent(uint8_t num, WStype_t type, uint8_t *payload, size_t length) {
-    switch (type) {
-        case WStype_CONNECTED:
-            Serial.printf("WS: Client %u connected (awaiting auth)\n", num);
-            clientConnected = true;
-            clientAuthenticated = false;
-            activeClient = num;
-            break;
-
-        case WStype_DISCONNECTED:
-            Serial.printf("WS: Client %u disconnected\n", num);
-            if (num == activeClient) {
-                clientConnected = false;
-                clientAuthenticated = false;
-                // Return to AI mode for whichever game is active
-                if (wsActiveEffect == EFFECT_SNAKE) {
-                    if (isSnakeManualMode()) setSnakeManualMode(false);
-                } else {
-                    if (isManualMode()) setManualMode(false);
-                }
-            }
-            break;
-
-        case WStype_TEXT:
-            handleCommand(num, String((char *)payload));
-            break;
-
-        default:
-            break;
+    uint32_t mask = 0;
+    for (uint8_t f = 0; f < ST_FIELDS; f++) {
+        if (full || (!STATUS_FIELDS[f].heartbeatOnly && now[f] != statusSent[f])) mask |= 1UL << f;
     }
+    int len = buildStatus(now, mask, full);
+    if (!len) return;
+    memcpy(statusSent, now, sizeof(statusSent));
+
+    gameSocket.sendSubscribed(statusBuf);
+    traceSpan(TRACE_WS_BROADCAST, traceStart, len);
 }
 
-// ─── Broadcast State ───────────────────────────────────────────────────────
-
-// Pre-allocated buffer for broadcast JSON.
-// Worst case per cell: "16777215," = 9 chars. 256 cells * 9 = 2304.
-// Header/footer ~80 chars. Total ~2400. Use 2600 for safety.
-static char broadcastBuf[2600];
-
-static void broadcastState() {
-    static uint32_t gridBuf[GRID_WIDTH * GRID_HEIGHT];
-    uint16_t score, lines;
-    bool over;
-
-    if (wsActiveEffect == EFFECT_SNAKE) {
-        // Snake broadcast
-        uint16_t snakeLength;
-        getSnakeState(gridBuf, score, snakeLength, over);
-        lines = snakeLength;
-    } else {
-        // Tetris broadcast
-        uint8_t pType;
-        int8_t px, py;
-        uint8_t rot;
-        bool clr;
-        getTetrisState(gridBuf, pType, px, py, rot, score, lines, over, clr);
+// A new subscriber gets the full status straight away. The first one also
+// sets the delta baseline; later ones leave it alone, so a field changed
+// since the last push still goes out to everyone (a repeat for them).
+static void subscribeStatus(uint8_t num) {
+    bool first = !gameSocket.anySubscribed();
+    gameSocket.subscribe(num);
+    uint32_t now[ST_FIELDS];
+    readStatus(now);
+    if (!buildStatus(now, (1UL << ST_FIELDS) - 1, true)) return;
+    gameSocket.send(num, statusBuf);
+    if (first) {
+        memcpy(statusSent, now, sizeof(statusSent));
+        lastStatusFullMs = lastStatusCheckMs = millis();
     }
+}
 
-    // Build JSON into fixed buffer to avoid heap fragmentation
-    int pos = snprintf(broadcastBuf, sizeof(broadcastBuf),
-        "{\"score\":%u,\"lines\":%u,\"gameOver\":%s,\"grid\":[",
-        score, lines, over ? "true" : "false");
-
-    for (int i = 0; i < GRID_WIDTH * GRID_HEIGHT && pos < (int)sizeof(broadcastBuf) - 12; i++) {
-        if (i > 0) broadcastBuf[pos++] = ',';
-        pos += snprintf(broadcastBuf + pos, sizeof(broadcastBuf) - pos, "%lu", (unsigned long)gridBuf[i]);
+static void loopStatus() {
+    if (!gameSocket.anySubscribed()) return;
+    unsigned long now = millis();
+    if (now - lastStatusFullMs >= WS_STATUS_HEARTBEAT_MS) {
+        lastStatusFullMs = now;
+        lastStatusCheckMs = now;
+        pushStatus(true);
+    } else if (now - lastStatusCheckMs >= WS_STATUS_CHECK_MS) {
+        lastStatusCheckMs = now;
+        pushStatus(false);
     }
+}
 
-    if (pos < (int)sizeof(broadcastBuf) - 3) {
-        broadcastBuf[pos++] = ']';
-        broadcastBuf[pos++] = '}';
-        broadcastBuf[pos] = '\0';
-    }
+// ─── Socket Hooks ──────────────────────────────────────────────────────────
 
-    ws.sendTXT(activeClient, broadcastBuf);
+static bool handleCommand(uint8_t num, const char *cmd, JsonDocument &doc) {
+    if (strcmp(cmd, "status") != 0) return false;
+    subscribeStatus(num);
+    return true;
+}
+
+static void onWsEvent(uint8_t num, WStype_t type, uint8_t *payload, size_t length) {
+    if (type != WStype_TEXT) {
+        gameSocket.handleEvent(num, type, payload, length);
+        return;
+    }
+    TraceScope trace(TRACE_WS_RECEIVE, num);
+    gameSocket.handleEvent(num, type, payload, length);
 }
 
 // ─── Public API ────────────────────────────────────────────────────────────
 
-void setupWebSocket() {
-    ws.begin();
-    ws.onEvent(onWsEvent);
-    Serial.println(F("WebSocket server started on port 81"));
+void setupWebSocket(const GridConfig &cfg) {
+    cfgPtr = &cfg;
+    gameSocket.onCommand(handleCommand);
+    gameSocket.onInput(renderGameInput);   // the render task owns the games
+    gameSocket.begin(onWsEvent);
+}
+
+void publishGameBoard() {
+    gameSocket.publishGame();
 }
 
 void loopWebSocket() {
-    ws.loop();
-
-    // Only broadcast for interactive games
-    bool isGame = (wsActiveEffect == EFFECT_TETRIS || wsActiveEffect == EFFECT_SNAKE);
-    if (clientConnected && clientAuthenticated && isGame &&
-        millis() - lastBroadcastMs >= WS_BROADCAST_INTERVAL_MS) {
-        lastBroadcastMs = millis();
-        broadcastState();
-    }
+    gameSocket.loop();
+    loopStatus();
+
+    // The game pad's board, as the render task last published it
+    uint32_t traceStart = traceClock();
+    int len = gameSocket.broadcastGame();
+    if (len) traceSpan(TRACE_WS_BROADCAST, traceStart, len);
 }
@@ -3,9 +3,15 @@
 
 #include "config.h"
 
-void setupWebSocket();
+// Port 81. Each client authenticates with the token from /api/ws-token,
+// then either drives the active game (the tetris page) or sends
+// {"cmd":"status"} to have dashboard status pushed as it changes.
+void setupWebSocket(const GridConfig &cfg);
 void loopWebSocket();
-bool isWebSocketAuthenticated();
+
+// Render task, after each pass: hand the game pad's board to loopWebSocket().
+// The games are the render task's, so the socket never reads them itself.
+void publishGameBoard();
 void setWebSocketAuthToken(const char *token);
 
 // Tell the WS handler which game/effect is active (for command routing)
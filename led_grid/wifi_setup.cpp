@@ -31,7 +31,7 @@ static void apAnimation(Adafruit_NeoPixel &strip) {
                 Adafruit_NeoPixel::Color(r, g, b));
         }
     }
-    strip.show();
+    compositor.present(strip);
 }
 
 void setupWiFi(Adafruit_NeoPixel &strip) {
@@ -20,7 +20,7 @@ python3 compress_html.py
 
 # Step 2: Compile
 echo "==> Compiling..."
-arduino-cli compile --fqbn "$FQBN" "$SKETCH_DIR" --export-binaries
+arduino-cli compile --fqbn "$FQBN" "$SKETCH_DIR" --libraries ../libraries --export-binaries
 
 # Step 3: Optional OTA upload
 if [[ "${1:-}" == "--upload" ]]; then
@@ -2,6 +2,7 @@
 #define CONFIG_H
 
 #include <Arduino.h>
+#include <led_geometry.h>
 
 #define FW_VERSION "0.1.0"
 
@@ -23,9 +24,24 @@
 #define RAINBOW_CYCLE_MS      10000  // Full rainbow rotation period
 #define COLOUR_WASH_CYCLE_MS   5000  // Solid hue sweep period
 
+// ─── Text Ticker ───────────────────────────────────────────────────────────
+#define TICKER_TEXT_MAX       128        // characters per message
+#define TICKER_DEFAULT_TEXT   "LED Panel"
+#define TICKER_DEFAULT_COLOUR 0xFF8C00   // 0 = rainbow along the message
+#define TICKER_DEFAULT_SPEED  16         // pixels per second
+#define TICKER_MAX_SPEED      64
+
 // ─── Grid Layout ───────────────────────────────────────────────────────────
 #define SERPENTINE_LAYOUT  true
 
+// Column-major serpentine, mounted upside-down in its case.
+// Loop bounds, row bitmasks and the strip map all specialise on this type.
+typedef LedGeometry<GRID_WIDTH, GRID_HEIGHT, WIRING_COLUMNS, ROTATE_180, SERPENTINE_LAYOUT> GridGeometry;
+
+// The geometry already corrects for the 180° mounting, so screen
+// coordinates (overlays, text) are the logical ones.
+typedef GridGeometry ScreenGeometry;
+
 // ─── WiFi / Network ────────────────────────────────────────────────────────
 #define MDNS_HOSTNAME   "ledpanel"       // http://ledpanel.local
 #define AP_NAME         "LedPanel-Setup"
@@ -51,6 +67,11 @@ enum Effect : uint8_t {
     EFFECT_SPIRAL,           // Rotating colour pinwheel
     EFFECT_TETRIS,           // Tetris simulation — pieces fall and stack
     EFFECT_SNAKE,            // Snake game — AI or manual phone control
+    EFFECT_TICKER,           // Scrolling text message (HTTP / WebSocket)
+    EFFECT_NOISE_FIRE,       // Fire from a rising gradient-noise field
+    EFFECT_NOISE_AURORA,     // Aurora curtains wandering on noise
+    EFFECT_NOISE_LAVA,       // Lava blobs thresholded from a noise field
+    EFFECT_NOISE_CANDLE,     // Candle flicker following a noise curve
     EFFECT_COUNT             // Sentinel — number of effects
 };
 
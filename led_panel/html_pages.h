@@ -140,6 +140,22 @@ static const char DASHBOARD_PAGE[] PROGMEM = R"rawliteral(
   <button class="btn-effect" data-e="12" id="eff12">🧬 Life</button>
   <button class="btn-effect" data-e="13" id="eff13">🌀 Plasma</button>
   <button class="btn-effect" data-e="14" id="eff14">🌀 Spiral</button>
+  <button class="btn-effect" data-e="17" id="eff17">💬 Ticker</button>
+  <button class="btn-effect" data-e="18" id="eff18">🔥 Noise Fire</button>
+  <button class="btn-effect" data-e="19" id="eff19">🌌 Noise Aurora</button>
+  <button class="btn-effect" data-e="20" id="eff20">🫧 Noise Lava</button>
+  <button class="btn-effect" data-e="21" id="eff21">🕯 Noise Candle</button>
+</div>
+</div>
+
+<div class="card">
+<h2>Ticker</h2>
+<label>Message</label>
+<input type="text" id="tkText" maxlength="128" placeholder="Hello!">
+<div style="display:flex;gap:8px;margin-top:8px">
+  <input type="color" id="tkColour" value="#ff8c00" style="width:60px">
+  <input type="number" id="tkSpeed" min="1" max="64" value="16" style="width:60px" title="Pixels per second">
+  <button class="btn-secondary" onclick="sendTicker()">Send</button>
 </div>
 </div>
 
@@ -250,6 +266,14 @@ function sendBg(){
   post('/api/background','r='+r+'&g='+g+'&b='+b,function(ok){if(ok)toast('Background set')});
 }
 
+function sendTicker(){
+  var t=document.getElementById('tkText').value;
+  var c=document.getElementById('tkColour').value.substring(1);
+  var s=document.getElementById('tkSpeed').value;
+  post('/api/ticker','text='+encodeURIComponent(t)+'&colour='+c+'&speed='+s,
+    function(ok){if(ok)toast('Ticker updated')});
+}
+
 function saveAll(){
   post('/api/save','',function(ok){toast(ok?'Settings saved!':'Save failed',!ok)});
 }
@@ -273,7 +297,7 @@ function poll(){
       document.getElementById('bgB').value=d.bgB;
     }
     var games=[15,16];
-    for(var i=0;i<17;i++){
+    for(var i=0;i<22;i++){
       var el=document.getElementById('eff'+i);
       if(el){
         var cls='btn-effect';
@@ -25,8 +25,7 @@
 #include "config.h"
 #include "persistence.h"
 #include "led_effects.h"
-#include "tetris_effect.h"
-#include "snake_game.h"
+#include <LedCore.h>
 #include "wifi_setup.h"
 #include "web_server.h"
 #include "websocket_handler.h"
@@ -72,11 +71,13 @@ void setup() {
     initLeds(strip);
     strip.setBrightness(gridConfig.brightness);
 
+    // Seed effect/game PRNGs from the hardware RNG (fixed seeds replay frames)
+    seedEffects(esp_random());
+
     // Apply config to game engines
-    setTetrisConfig(gridConfig);
-    resetTetris();
-    setSnakeConfig(gridConfig);
-    resetSnake();
+    games.configure(gridConfig);
+    games.tetris.reset();
+    games.snake.reset();
     setWsActiveEffect(gridConfig.currentEffect);
 
     // WiFi setup (shows animation on panel during AP mode)
@@ -115,23 +116,20 @@ void loop() {
         if (now - lastButtonMs > 300) {
             lastButtonMs = now;
             gridConfig.currentEffect = nextEffect(gridConfig.currentEffect);
-            strip.clear();
-            strip.show();
+            compositor.base.clear();
+            compositor.base.show();
             setWsActiveEffect(gridConfig.currentEffect);
-            if (gridConfig.currentEffect == EFFECT_TETRIS) {
-                setManualMode(false);
-                resetTetris();
-            } else if (gridConfig.currentEffect == EFFECT_SNAKE) {
-                setSnakeManualMode(false);
-                resetSnake();
-            }
+            games.restart(gameFor(gridConfig.currentEffect), true);
             Serial.printf("Effect: %d/%d\n", gridConfig.currentEffect, EFFECT_COUNT);
         }
     }
 
-    // Update LEDs at target frame rate
+    // Render the base effect at its own frame rate
     if (now - lastUpdateMs >= LED_UPDATE_INTERVAL_MS) {
         lastUpdateMs = now;
-        updateEffect(strip, gridConfig.currentEffect);
+        updateEffect(compositor.base, gridConfig.currentEffect);
     }
+
+    // Blend overlays over the latest base frame; shows only when something changed
+    compositor.composite(strip);
 }
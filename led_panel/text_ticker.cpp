@@ -0,0 +1,219 @@
+#include "text_ticker.h"
+#include "led_effects.h"
+#include <pixel_kernels.h>
+
+// ─── 5x7 Font ──────────────────────────────────────────────────────────────
+// ASCII 0x20-0x7E, 5 columns per glyph, bit 0 = top row. Bit 7 holds the
+// descenders of g, j, p, q and y. Glyphs are trimmed to their inked columns
+// when rasterised, so narrow letters (i, l, !) take less room.
+
+#define FONT_FIRST   0x20
+#define FONT_LAST    0x7E
+#define GLYPH_COLS   5
+#define SPACE_COLS   3
+#define MAX_COLS     (TICKER_TEXT_MAX * (GLYPH_COLS + 1))
+#define SCROLL_START (-(int32_t)GRID_WIDTH * 256)   // message just off the right edge
+
+static const uint8_t FONT_5X7[FONT_LAST - FONT_FIRST + 1][GLYPH_COLS] PROGMEM = {
+    {0x00, 0x00, 0x00, 0x00, 0x00},  // space
+    {0x00, 0x00, 0x5F, 0x00, 0x00},  // !
+    {0x00, 0x07, 0x00, 0x07, 0x00},  // "
+    {0x14, 0x7F, 0x14, 0x7F, 0x14},  // #
+    {0x24, 0x2A, 0x7F, 0x2A, 0x12},  // $
+    {0x23, 0x13, 0x08, 0x64, 0x62},  // %
+    {0x36, 0x49, 0x56, 0x20, 0x50},  // &
+    {0x00, 0x00, 0x07, 0x00, 0x00},  // '
+    {0x00, 0x1C, 0x22, 0x41, 0x00},  // (
+    {0x00, 0x41, 0x22, 0x1C, 0x00},  // )
+    {0x2A, 0x1C, 0x7F, 0x1C, 0x2A},  // *
+    {0x08, 0x08, 0x3E, 0x08, 0x08},  // +
+    {0x00, 0x80, 0x60, 0x00, 0x00},  // ,
+    {0x08, 0x08, 0x08, 0x08, 0x08},  // -
+    {0x00, 0x00, 0x40, 0x00, 0x00},  // .
+    {0x20, 0x10, 0x08, 0x04, 0x02},  // /
+    {0x3E, 0x51, 0x49, 0x45, 0x3E},  // 0
+    {0x00, 0x42, 0x7F, 0x40, 0x00},  // 1
+    {0x62, 0x51, 0x49, 0x49, 0x46},  // 2
+    {0x21, 0x41, 0x49, 0x4D, 0x33},  // 3
+    {0x18, 0x14, 0x12, 0x7F, 0x10},  // 4
+    {0x27, 0x45, 0x45, 0x45, 0x39},  // 5
+    {0x3C, 0x4A, 0x49, 0x49, 0x31},  // 6
+    {0x01, 0x71, 0x09, 0x05, 0x03},  // 7
+    {0x36, 0x49, 0x49, 0x49, 0x36},  // 8
+    {0x46, 0x49, 0x49, 0x29, 0x1E},  // 9
+    {0x00, 0x00, 0x14, 0x00, 0x00},  // :
+    {0x00, 0x40, 0x34, 0x00, 0x00},  // ;
+    {0x08, 0x14, 0x22, 0x41, 0x00},  // <
+    {0x14, 0x14, 0x14, 0x14, 0x14},  // =
+    {0x00, 0x41, 0x22, 0x14, 0x08},  // >
+    {0x02, 0x01, 0x59, 0x09, 0x06},  // ?
+    {0x3E, 0x41, 0x5D, 0x55, 0x1E},  // @
+    {0x7E, 0x09, 0x09, 0x09, 0x7E},  // A
+    {0x7F, 0x49, 0x49, 0x49, 0x36},  // B
+    {0x3E, 0x41, 0x41, 0x41, 0x22},  // C
+    {0x7F, 0x41, 0x41, 0x41, 0x3E},  // D
+    {0x7F, 0x49, 0x49, 0x49, 0x41},  // E
+    {0x7F, 0x09, 0x09, 0x09, 0x01},  // F
+    {0x3E, 0x41, 0x49, 0x49, 0x7A},  // G
+    {0x7F, 0x08, 0x08, 0x08, 0x7F},  // H
+    {0x00, 0x41, 0x7F, 0x41, 0x00},  // I
+    {0x20, 0x40, 0x41, 0x3F, 0x01},  // J
+    {0x7F, 0x08, 0x14, 0x22, 0x41},  // K
+    {0x7F, 0x40, 0x40, 0x40, 0x40},  // L
+    {0x7F, 0x02, 0x0C, 0x02, 0x7F},  // M
+    {0x7F, 0x04, 0x08, 0x10, 0x7F},  // N
+    {0x3E, 0x41, 0x41, 0x41, 0x3E},  // O
+    {0x7F, 0x09, 0x09, 0x09, 0x06},  // P
+    {0x3E, 0x41, 0x51, 0x21, 0x5E},  // Q
+    {0x7F, 0x09, 0x19, 0x29, 0x46},  // R
+    {0x26, 0x49, 0x49, 0x49, 0x32},  // S
+    {0x01, 0x01, 0x7F, 0x01, 0x01},  // T
+    {0x3F, 0x40, 0x40, 0x40, 0x3F},  // U
+    {0x1F, 0x20, 0x40, 0x20, 0x1F},  // V
+    {0x3F, 0x40, 0x38, 0x40, 0x3F},  // W
+    {0x63, 0x14, 0x08, 0x14, 0x63},  // X
+    {0x07, 0x08, 0x70, 0x08, 0x07},  // Y
+    {0x61, 0x51, 0x49, 0x45, 0x43},  // Z
+    {0x00, 0x7F, 0x41, 0x41, 0x00},  // [
+    {0x02, 0x04, 0x08, 0x10, 0x20},  // backslash
+    {0x00, 0x41, 0x41, 0x7F, 0x00},  // ]
+    {0x04, 0x02, 0x01, 0x02, 0x04},  // ^
+    {0x40, 0x40, 0x40, 0x40, 0x40},  // _
+    {0x00, 0x01, 0x02, 0x00, 0x00},  // `
+    {0x20, 0x54, 0x54, 0x54, 0x78},  // a
+    {0x7F, 0x48, 0x44, 0x44, 0x38},  // b
+    {0x38, 0x44, 0x44, 0x44, 0x28},  // c
+    {0x38, 0x44, 0x44, 0x48, 0x7F},  // d
+    {0x38, 0x54, 0x54, 0x54, 0x18},  // e
+    {0x08, 0x7E, 0x09, 0x01, 0x02},  // f
+    {0x18, 0xA4, 0xA4, 0xA4, 0x7C},  // g
+    {0x7F, 0x08, 0x04, 0x04, 0x78},  // h
+    {0x00, 0x44, 0x7D, 0x40, 0x00},  // i
+    {0x40, 0x80, 0x84, 0x7D, 0x00},  // j
+    {0x7F, 0x10, 0x28, 0x44, 0x00},  // k
+    {0x00, 0x41, 0x7F, 0x40, 0x00},  // l
+    {0x7C, 0x04, 0x78, 0x04, 0x78},  // m
+    {0x7C, 0x08, 0x04, 0x04, 0x78},  // n
+    {0x38, 0x44, 0x44, 0x44, 0x38},  // o
+    {0xFC, 0x24, 0x24, 0x24, 0x18},  // p
+    {0x18, 0x24, 0x24, 0x24, 0xFC},  // q
+    {0x7C, 0x08, 0x04, 0x04, 0x08},  // r
+    {0x48, 0x54, 0x54, 0x54, 0x24},  // s
+    {0x04, 0x3F, 0x44, 0x40, 0x20},  // t
+    {0x3C, 0x40, 0x40, 0x20, 0x7C},  // u
+    {0x1C, 0x20, 0x40, 0x20, 0x1C},  // v
+    {0x3C, 0x40, 0x30, 0x40, 0x3C},  // w
+    {0x44, 0x28, 0x10, 0x28, 0x44},  // x
+    {0x1C, 0xA0, 0xA0, 0xA0, 0x7C},  // y
+    {0x44, 0x64, 0x54, 0x4C, 0x44},  // z
+    {0x00, 0x08, 0x36, 0x41, 0x00},  // {
+    {0x00, 0x00, 0x7F, 0x00, 0x00},  // |
+    {0x00, 0x41, 0x36, 0x08, 0x00},  // }
+    {0x08, 0x04, 0x08, 0x10, 0x08},  // ~
+};
+
+// ─── State ─────────────────────────────────────────────────────────────────
+
+static char     text[TICKER_TEXT_MAX + 1] = TICKER_DEFAULT_TEXT;
+static uint8_t  columns[MAX_COLS];        // the rasterised message
+static uint16_t columnCount = 0;
+static bool     rasterised  = false;
+
+static uint32_t colour = TICKER_DEFAULT_COLOUR;
+static uint8_t  speed  = TICKER_DEFAULT_SPEED;
+
+// Scroll position in 8.8 fixed point: the cache column under screen x = 0.
+static int32_t  scrollPos   = SCROLL_START;
+static uint16_t scrollCarry = 0;          // sub-step remainder, 1/1000 units
+static uint32_t lastStepMs  = 0;
+
+// ─── Rasteriser ────────────────────────────────────────────────────────────
+
+static void rasterise() {
+    uint16_t n = 0;
+    for (const char *p = text; *p; p++) {
+        uint8_t ch = (uint8_t)*p;
+        if ((ch & 0xC0) == 0x80) continue;   // UTF-8 continuation byte
+        if (ch < FONT_FIRST || ch > FONT_LAST) ch = '?';
+
+        if (ch == ' ') {
+            for (uint8_t i = 0; i < SPACE_COLS && n < MAX_COLS; i++) columns[n++] = 0;
+            continue;
+        }
+
+        uint8_t glyph[GLYPH_COLS];
+        memcpy_P(glyph, FONT_5X7[ch - FONT_FIRST], GLYPH_COLS);
+        uint8_t first = 0, last = GLYPH_COLS - 1;
+        while (first < last && glyph[first] == 0) first++;
+        while (last > first && glyph[last] == 0) last--;
+
+        if (n + (last - first + 2) > MAX_COLS) break;
+        for (uint8_t c = first; c <= last; c++) columns[n++] = glyph[c];
+        columns[n++] = 0;                    // inter-glyph gap
+    }
+    columnCount = n;
+    rasterised = true;
+}
+
+// ─── Public API ────────────────────────────────────────────────────────────
+
+uint16_t setTickerText(const char *msg) {
+    strncpy(text, msg, TICKER_TEXT_MAX);
+    text[TICKER_TEXT_MAX] = '\0';
+    rasterise();
+    scrollPos   = SCROLL_START;
+    scrollCarry = 0;
+    return strlen(text);
+}
+
+void setTickerColour(uint32_t c) {
+    colour = c & 0xFFFFFF;
+}
+
+void setTickerSpeed(uint8_t pxPerSec) {
+    speed = constrain(pxPerSec, 1, TICKER_MAX_SPEED);
+}
+
+const char *tickerText() {
+    return text;
+}
+
+void updateTicker(Canvas &strip) {
+    if (!rasterised) rasterise();
+
+    // Advance by elapsed time so the speed holds at any frame rate. A long
+    // gap (another effect was showing) is clamped rather than jumped over.
+    uint32_t now = millis();
+    uint32_t elapsed = now - lastStepMs;
+    lastStepMs = now;
+    if (elapsed > 100) elapsed = LED_UPDATE_INTERVAL_MS;
+
+    uint32_t step = elapsed * speed * 256 + scrollCarry;
+    scrollPos  += step / 1000;
+    scrollCarry = step % 1000;
+    if (scrollPos >= (int32_t)columnCount << 8)
+        scrollPos = SCROLL_START;
+
+    // Blit the window: each screen column mixes cache columns i and i + 1
+    // by the fractional position. Off-cache columns are blank.
+    int32_t base = scrollPos >> 8;
+    uint8_t frac = scrollPos & 0xFF;
+    uint8_t keep = 255 - frac;
+
+    int32_t i = base;
+    uint8_t cur = (i >= 0 && i < columnCount) ? columns[i] : 0;
+    for (uint8_t x = 0; x < GRID_WIDTH; x++, i++) {
+        uint8_t next = (i + 1 >= 0 && i + 1 < columnCount) ? columns[i + 1] : 0;
+        uint32_t c = colour ? colour : colourWheel((uint8_t)(i * 4 - (now >> 4)));
+        uint32_t cKeep = scaleColour(c, keep);
+        uint32_t cFrac = scaleColour(c, frac);
+
+        for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+            uint8_t bits = ((cur >> y) & 1) | (((next >> y) & 1) << 1);
+            uint32_t px = bits == 3 ? c : bits == 1 ? cKeep : bits == 2 ? cFrac : 0;
+            strip.setPixelColor(screenToIndex(x, y), px);
+        }
+        cur = next;
+    }
+    strip.show();
+}
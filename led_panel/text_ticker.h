@@ -0,0 +1,32 @@
+#ifndef TEXT_TICKER_H
+#define TEXT_TICKER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "led_effects.h"
+
+// ─── Scrolling Text Ticker ─────────────────────────────────────────────────
+// A message is rasterised once, when it is set, into a column bitmap cache:
+// one byte per column, bit 0 = top row, using a proportional 5x7 font with
+// descenders on the eighth row. Each frame blits a GRID_WIDTH-wide window
+// out of the cache at an 8.8 fixed-point scroll position, blending the two
+// source columns either side of it for sub-pixel smooth motion.
+//
+// Frame cost is GRID_WIDTH x GRID_HEIGHT pixels whatever the message length.
+
+// Set the message (ASCII; other bytes render as '?'). Restarts the scroll
+// from the right edge. Returns the number of characters that fit the cache.
+uint16_t setTickerText(const char *text);
+
+// Text colour, 0x00RRGGBB. 0 cycles the colour wheel along the message.
+void setTickerColour(uint32_t colour);
+
+// Scroll speed in pixels per second (clamped to 1-TICKER_MAX_SPEED).
+void setTickerSpeed(uint8_t pxPerSec);
+
+const char *tickerText();
+
+// Draw one frame of the ticker (EFFECT_TICKER).
+void updateTicker(Canvas &strip);
+
+#endif // TEXT_TICKER_H
@@ -1,9 +1,9 @@
 #include "web_server.h"
 #include "html_pages_gz.h"
 #include "persistence.h"
-#include "tetris_effect.h"
-#include "snake_game.h"
 #include "led_effects.h"
+#include "led_effects.h"
+#include "text_ticker.h"
 #include "websocket_handler.h"
 #include <WebServer.h>
 #include <Preferences.h>
@@ -200,11 +200,7 @@ static void handleApiEffect() {
     if (val >= 0 && val < EFFECT_COUNT) {
         cfgPtr->currentEffect = (Effect)val;
         setWsActiveEffect(cfgPtr->currentEffect);
-        if (cfgPtr->currentEffect == EFFECT_TETRIS) {
-            resetTetris();
-        } else if (cfgPtr->currentEffect == EFFECT_SNAKE) {
-            resetSnake();
-        }
+        games.restart(gameFor(cfgPtr->currentEffect), false);
     }
     server.send(200, "application/json", "{\"ok\":true}");
 }
@@ -225,7 +221,7 @@ static void handleApiTuning() {
     if (server.hasArg("jitterPct"))
         cfgPtr->jitterPct = constrain(server.arg("jitterPct").toInt(), 0, 50);
 
-    setTetrisConfig(*cfgPtr);
+    games.configure(*cfgPtr);
     server.send(200, "application/json", "{\"ok\":true}");
 }
 
@@ -236,7 +232,7 @@ static void handleApiBackground() {
     if (server.hasArg("g")) cfgPtr->bgG = constrain(server.arg("g").toInt(), 0, 40);
     if (server.hasArg("b")) cfgPtr->bgB = constrain(server.arg("b").toInt(), 0, 40);
 
-    setTetrisConfig(*cfgPtr);
+    games.configure(*cfgPtr);
     server.send(200, "application/json", "{\"ok\":true}");
 }
 
@@ -258,7 +254,7 @@ static void handleApiSave() {
 static void handleApiDefaults() {
     if (!isAuthenticated()) { server.send(401, "text/plain", "Auth required"); return; }
     initDefaultConfig(*cfgPtr);
-    setTetrisConfig(*cfgPtr);
+    games.configure(*cfgPtr);
     saveGridConfig(*cfgPtr);
     server.send(200, "application/json", "{\"ok\":true}");
 }
@@ -270,6 +266,81 @@ static void handleApiWsToken() {
     server.send(200, "application/json", buf);
 }
 
+static void handleApiOverlay() {
+    if (!isAuthenticated()) { server.send(401, "text/plain", "Auth required"); return; }
+
+    // slot=all&type=none clears every overlay
+    if (server.arg("slot") == "all") {
+        compositor.clearOverlays();
+        server.send(200, "application/json", "{\"ok\":true}");
+        return;
+    }
+
+    int slot = server.hasArg("slot") ? server.arg("slot").toInt() : 0;
+    if (slot < 0 || slot >= MAX_OVERLAYS) {
+        server.send(400, "text/plain", "Bad slot");
+        return;
+    }
+
+    Overlay ov;
+    compositor.overlayDefaults(ov);
+    ov.type = overlayTypeFromName(server.arg("type").c_str());
+    if (ov.type == OVERLAY_NONE) {
+        compositor.clearOverlay(slot);
+        server.send(200, "application/json", "{\"ok\":true}");
+        return;
+    }
+
+    if (server.hasArg("x"))        ov.x = constrain(server.arg("x").toInt(), -GRID_WIDTH, GRID_WIDTH);
+    if (server.hasArg("y"))        ov.y = constrain(server.arg("y").toInt(), -GRID_HEIGHT, GRID_HEIGHT);
+    if (server.hasArg("w"))        ov.w = constrain(server.arg("w").toInt(), 0, GRID_WIDTH);
+    if (server.hasArg("h"))        ov.h = constrain(server.arg("h").toInt(), 0, GRID_HEIGHT);
+    if (server.hasArg("alpha"))    ov.alpha = constrain(server.arg("alpha").toInt(), 0, 255);
+    if (server.hasArg("blend"))    ov.blend = blendModeFromName(server.arg("blend").c_str());
+    if (server.hasArg("scroll"))   ov.scrollMs = constrain(server.arg("scroll").toInt(), 0, 2000);
+    if (server.hasArg("duration")) ov.durationMs = constrain(server.arg("duration").toInt(), 0, 3600000);
+    if (server.hasArg("colour")) {
+        String c = server.arg("colour");
+        if (c.startsWith("#")) c = c.substring(1);
+        ov.colour = strtoul(c.c_str(), nullptr, 16) & 0xFFFFFF;
+    }
+    if (server.hasArg("text")) {
+        String t = server.arg("text");
+        strncpy(ov.text, t.c_str(), sizeof(ov.text) - 1);
+        ov.text[sizeof(ov.text) - 1] = '\0';
+    }
+    if (server.hasArg("sprite")) {
+        // Comma-separated hex rows, bit 15 = leftmost pixel
+        String rows = server.arg("sprite");
+        const char *p = rows.c_str();
+        uint8_t n = 0;
+        while (*p && n < OVERLAY_SPRITE_MAX) {
+            char *end;
+            ov.sprite[n++] = (uint16_t)strtoul(p, &end, 16);
+            if (*end != ',') break;
+            p = end + 1;
+        }
+        if (!server.hasArg("h")) ov.h = n;
+        if (!server.hasArg("w")) ov.w = OVERLAY_SPRITE_MAX;
+    }
+
+    compositor.setOverlay(slot, ov);
+    server.send(200, "application/json", "{\"ok\":true}");
+}
+
+static void handleApiTicker() {
+    if (!isAuthenticated()) { server.send(401, "text/plain", "Auth required"); return; }
+
+    if (server.hasArg("colour")) {
+        String c = server.arg("colour");
+        if (c.startsWith("#")) c = c.substring(1);
+        setTickerColour(strtoul(c.c_str(), nullptr, 16));
+    }
+    if (server.hasArg("speed")) setTickerSpeed(constrain(server.arg("speed").toInt(), 1, TICKER_MAX_SPEED));
+    if (server.hasArg("text"))  setTickerText(server.arg("text").c_str());
+    server.send(200, "application/json", "{\"ok\":true}");
+}
+
 static void handleApiRestart() {
     if (!isAuthenticated()) { server.send(401, "text/plain", "Auth required"); return; }
     server.send(200, "application/json", "{\"ok\":true}");
@@ -344,6 +415,8 @@ void setupWebServer(GridConfig &cfg) {
     server.on("/api/save",       HTTP_POST, handleApiSave);
     server.on("/api/defaults",   HTTP_POST, handleApiDefaults);
     server.on("/api/ws-token",   HTTP_GET,  handleApiWsToken);
+    server.on("/api/overlay",    HTTP_POST, handleApiOverlay);
+    server.on("/api/ticker",     HTTP_POST, handleApiTicker);
     server.on("/api/restart",    HTTP_POST, handleApiRestart);
 
     server.begin();
@@ -5,7 +5,6 @@
 
 void setupWebSocket();
 void loopWebSocket();
-bool isWebSocketAuthenticated();
 void setWebSocketAuthToken(const char *token);
 
 // Tell the WS handler which game/effect is active (for command routing)
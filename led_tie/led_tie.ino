@@ -7,6 +7,7 @@
 #include <DNSServer.h>
 #include <EEPROM.h>
 #include <string.h>
+#include "pixel_kernels.h"
 
 // -----------------------------
 // Pins & config
@@ -2928,21 +2929,12 @@ void modeMeteorShower(unsigned long now)
         return;
     last = now;
 
-    // Fade all pixels
-    for (int i = 0; i < NUM_LEDS; i++)
-    {
-        uint32_t c = strip.getPixelColor(i);
-        uint8_t r = (c >> 16) & 0xFF;
-        uint8_t g = (c >> 8) & 0xFF;
-        uint8_t b = c & 0xFF;
+    // Trails live in our own framebuffer - reading back from the strip
+    // is lossy once setBrightness() has scaled the stored pixels
+    static uint32_t frame[NUM_LEDS];
 
-        // Fade by ~12%
-        r = (r * 225) >> 8;
-        g = (g * 225) >> 8;
-        b = (b * 225) >> 8;
-
-        strip.setPixelColor(i, strip.Color(r, g, b));
-    }
+    // Fade all pixels by ~12%
+    fadeFrame(frame, NUM_LEDS, 225);
 
     // Meteor data: position, speed, colour type
     static int meteorPos[5] = {0, -15, -30, -45, -60};
@@ -3008,11 +3000,11 @@ void modeMeteorShower(unsigned long now)
             }
 
             // Meteor head
-            strip.setPixelColor(meteorPos[m], strip.Color(r, g, b));
+            frame[meteorPos[m]] = strip.Color(r, g, b);
 
             // Trail
             if (meteorPos[m] > 0)
-                strip.setPixelColor(meteorPos[m] - 1, strip.Color(r2, g2, b2));
+                frame[meteorPos[m] - 1] = strip.Color(r2, g2, b2);
         }
 
         // Advance meteor
@@ -3027,6 +3019,10 @@ void modeMeteorShower(unsigned long now)
         }
     }
 
+    for (int i = 0; i < NUM_LEDS; i++)
+    {
+        strip.setPixelColor(i, frame[i]);
+    }
     strip.show();
 }
 
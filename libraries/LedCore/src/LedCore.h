@@ -0,0 +1,32 @@
+#ifndef LED_CORE_H
+#define LED_CORE_H
+
+// ─── LedCore ───────────────────────────────────────────────────────────────
+// Code shared by the LED Grid and LED Panel sketches. Everything that
+// depends on matrix size or wiring is a template over the sketch's
+// LedGeometry (see led_geometry.h), instantiated in the sketch's own
+// translation units, so each device gets loops, masks and index maps
+// specialised to its grid at compile time.
+
+#include "led_geometry.h"
+#include "led_tiling.h"
+#include "fast_rng.h"
+#include "spsc_queue.h"
+#include "crc32.h"
+#include "json_reader.h"
+#include "light_command.h"
+#include "sine16.h"
+#include "heatshrink.h"
+#include "pixel_kernels.h"
+#include "layer_compositor.h"
+#include "noise.h"
+#include "particle_engine.h"
+#include "shared_effects.h"
+#include "tetris_engine.h"
+#include "snake_engine.h"
+#include "game_controller.h"
+
+// game_socket.h needs the WebSockets and ArduinoJson libraries, so the
+// sketches include it on its own where they serve the socket.
+
+#endif // LED_CORE_H
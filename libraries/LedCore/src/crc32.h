@@ -0,0 +1,32 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ─── CRC-32 ────────────────────────────────────────────────────────────────
+// The zlib / Ethernet CRC (reflected polynomial 0xEDB88320), so values match
+// Python's zlib.crc32(). A nibble at a time through a 16-entry table: 64
+// bytes of flash instead of the usual 1 KB, at two lookups per byte —
+// plenty for config blobs and file checks.
+//
+// Start with crc32Update(0, ...) and feed later chunks the previous result.
+
+inline uint32_t crc32Update(uint32_t crc, const void *data, size_t len) {
+    static const uint32_t NIBBLE[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+        0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+        0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    const uint8_t *p = (const uint8_t *)data;
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ NIBBLE[crc & 0x0F];
+        crc = (crc >> 4) ^ NIBBLE[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+#endif // CRC32_H
@@ -0,0 +1,58 @@
+#ifndef FAST_RNG_H
+#define FAST_RNG_H
+
+#include <Arduino.h>
+
+// ─── Fast PRNG for render loops ────────────────────────────────────────────
+// xorshift32 generator. Arduino random() on the ESP32 goes through the
+// hardware RNG and a division per call; this is three shifts and three XORs,
+// and a fixed seed gives the same frame sequence every run.
+//
+// Bounded helpers use Lemire's multiply-shift reduction: the result is the
+// high word of a 32x32 multiply, so there is no modulo on the common path.
+// The rejection step that removes bias only computes its threshold when the
+// low word falls in the (rare) biased zone.
+
+struct FastRng {
+    uint32_t state;
+
+    explicit FastRng(uint32_t s = 0x2545F491) { seed(s); }
+
+    // xorshift has a fixed point at zero — never let the state land there.
+    void seed(uint32_t s) { state = s ? s : 0x2545F491; }
+
+    uint32_t next() {
+        uint32_t x = state;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return state = x;
+    }
+
+    // Top byte has the best mixing in xorshift.
+    uint8_t next8() { return (uint8_t)(next() >> 24); }
+
+    // Uniform in [0, n). Returns 0 when n == 0.
+    uint32_t below(uint32_t n) {
+        uint64_t m = (uint64_t)next() * n;
+        uint32_t low = (uint32_t)m;
+        if (low < n) {
+            uint32_t threshold = (0u - n) % n;
+            while (low < threshold) {
+                m = (uint64_t)next() * n;
+                low = (uint32_t)m;
+            }
+        }
+        return (uint32_t)(m >> 32);
+    }
+
+    // Uniform in [lo, hi). Mirrors Arduino random(lo, hi).
+    int32_t range(int32_t lo, int32_t hi) {
+        return (hi > lo) ? lo + (int32_t)below((uint32_t)(hi - lo)) : lo;
+    }
+
+    // True with probability pct / 100.
+    bool chance(uint8_t pct) { return below(100) < pct; }
+};
+
+#endif // FAST_RNG_H
@@ -0,0 +1,108 @@
+#ifndef GAME_CONTROLLER_H
+#define GAME_CONTROLLER_H
+
+#include <Arduino.h>
+#include "tetris_engine.h"
+#include "snake_engine.h"
+
+// ─── Game Controller ───────────────────────────────────────────────────────
+// The Tetris and Snake engines a sketch plays, specialised on its geometry,
+// plus the glue every sketch needs around them: seeding, applying the
+// GridConfig, restarting on an effect switch and mapping phone controls
+// onto whichever game they are for. The engines stay public, so the
+// effect dispatcher calls games.tetris.update(strip) directly.
+
+// Which game a control is for. Anything but Snake drives Tetris.
+enum LedGame : uint8_t {
+    LED_GAME_NONE,
+    LED_GAME_TETRIS,
+    LED_GAME_SNAKE,
+};
+
+// Game controls, routed to Tetris or Snake by the game they are posted for.
+enum GameInput : uint8_t {
+    GAME_LEFT,
+    GAME_RIGHT,
+    GAME_UP,
+    GAME_DOWN,
+    GAME_ROTATE,
+    GAME_DROP,
+    GAME_SOFTDROP_ON,
+    GAME_SOFTDROP_OFF,
+    GAME_MANUAL,             // phone takes over
+    GAME_AI,                 // AI takes over
+    GAME_RELEASE,            // back to the AI if under manual control
+};
+
+template <class Geo>
+class GameController {
+public:
+    TetrisEngine<Geo> tetris;
+    SnakeEngine<Geo>  snake;
+
+    // Seed both games (same seed → same games).
+    void seed(uint32_t s) {
+        tetris.seed(s ^ 0x61C88647);
+        snake.seed(s ^ 0x7FEB352D);
+    }
+
+    // Apply the sketch's GridConfig: Tetris speed and AI tuning, and the
+    // background colour of both boards.
+    template <class Config>
+    void configure(const Config &cfg) {
+        tetris.setTuning(cfg.dropStartMs, cfg.dropMinMs, cfg.moveIntervalMs,
+                         cfg.rotIntervalMs, cfg.aiSkillPct, cfg.jitterPct);
+        tetris.setBackground(((uint32_t)cfg.bgR << 16) | ((uint32_t)cfg.bgG << 8) | cfg.bgB);
+        snake.setBackground(cfg.bgR, cfg.bgG, cfg.bgB);
+    }
+
+    // Start `game` on a fresh board. `release` also hands it back to the
+    // AI (the BOOT button); a switch from the web UI keeps the phone's mode.
+    void restart(LedGame game, bool release) {
+        if (game == LED_GAME_TETRIS) {
+            if (release) tetris.setManualMode(false);
+            tetris.reset();
+        } else if (game == LED_GAME_SNAKE) {
+            if (release) snake.setManualMode(false);
+            snake.reset();
+        }
+    }
+
+    void input(LedGame game, GameInput in) {
+        if (game == LED_GAME_SNAKE) snakeInput(in);
+        else                        tetrisInput(in);
+    }
+
+private:
+    void snakeInput(GameInput in) {
+        switch (in) {
+            case GAME_LEFT:    snake.setDirection(SNAKE_DIR_LEFT); break;
+            case GAME_RIGHT:   snake.setDirection(SNAKE_DIR_RIGHT); break;
+            case GAME_UP:
+            case GAME_ROTATE:  snake.setDirection(SNAKE_DIR_UP); break;    // rotate button = up on d-pad
+            case GAME_DOWN:
+            case GAME_DROP:    snake.setDirection(SNAKE_DIR_DOWN); break;  // drop button = down on d-pad
+            case GAME_MANUAL:  snake.setManualMode(true); break;
+            case GAME_AI:      snake.setManualMode(false); break;
+            case GAME_RELEASE: if (snake.isManualMode()) snake.setManualMode(false); break;
+            default: break;
+        }
+    }
+
+    void tetrisInput(GameInput in) {
+        switch (in) {
+            case GAME_LEFT:         tetris.moveLeft(); break;
+            case GAME_RIGHT:        tetris.moveRight(); break;
+            case GAME_ROTATE:       tetris.rotate(); break;
+            case GAME_DROP:         tetris.hardDrop(); break;
+            case GAME_SOFTDROP_ON:  tetris.softDrop(true); break;
+            case GAME_SOFTDROP_OFF: tetris.softDrop(false); break;
+            case GAME_MANUAL:       tetris.setManualMode(true); break;
+            case GAME_AI:           tetris.setManualMode(false); break;
+            case GAME_RELEASE:      if (tetris.isManualMode()) tetris.setManualMode(false); break;
+            default: break;
+        }
+    }
+};
+
+#endif // GAME_CONTROLLER_H
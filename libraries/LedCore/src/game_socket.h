@@ -0,0 +1,297 @@
+#ifndef GAME_SOCKET_H
+#define GAME_SOCKET_H
+
+#include <Arduino.h>
+#include <WebSocketsServer.h>
+#include <ArduinoJson.h>
+#include "game_controller.h"
+#include "spsc_queue.h"
+#include <atomic>
+
+// ─── Game Socket ───────────────────────────────────────────────────────────
+// The WebSocket side of phone play (port 81), shared by both sketches.
+// Each client authenticates with the token from /api/ws-token. The last
+// client to send a game control is the game pad: the board goes to it
+// alone, ~10 times a second, and the game returns to the AI when it
+// disconnects. Anything else a sketch speaks over the socket (dashboard
+// status, ticker text) reaches its command hook once the client is in.
+//
+// The sketch owns the event callback, so it can wrap it, and forwards:
+//
+//   static GameSocket<GridGeometry> gameSocket(games);
+//   static void onWsEvent(uint8_t num, WStype_t type, uint8_t *payload, size_t length) {
+//       gameSocket.handleEvent(num, type, payload, length);
+//   }
+//   ...
+//   gameSocket.begin(onWsEvent);
+//
+// When the games belong to another task (an input sink is set), that task
+// calls publishGame() at the end of each frame: it copies the board into
+// one of two buffers and passes it over, and broadcastGame() on the socket
+// side only sends what was published, never reading the games itself.
+
+#define GAME_SOCKET_PORT          81
+#define GAME_SOCKET_BROADCAST_MS  100   // 10 FPS
+#define GAME_SOCKET_NO_CLIENT     0xFF
+#define GAME_SOCKET_NO_BOARD      0xFF
+
+// A command the socket doesn't handle itself. Returns true if it was the
+// sketch's; otherwise the socket tries it as a game control.
+typedef bool (*GameSocketCommand)(uint8_t num, const char *cmd, JsonDocument &doc);
+
+// Where game controls go. Without one they go straight to the games; the
+// grid posts them to its render task instead (false: queue full, dropped),
+// and that task then owns the board too (see publishGame()).
+typedef bool (*GameSocketInput)(LedGame game, GameInput input);
+
+template <class Geo>
+class GameSocket {
+public:
+    explicit GameSocket(GameController<Geo> &games) : ws(GAME_SOCKET_PORT), games(games) {
+        freeBoards.push(0);
+        freeBoards.push(1);
+    }
+
+    void begin(void (*onEvent)(uint8_t, WStype_t, uint8_t *, size_t)) {
+        ws.begin();
+        ws.onEvent(onEvent);
+        Serial.println(F("WebSocket server started on port 81"));
+    }
+
+    void onCommand(GameSocketCommand hook) { commandHook = hook; }
+    void onInput(GameSocketInput sink)     { inputSink = sink; }
+
+    void setAuthToken(const char *token) {
+        strncpy(authToken, token, sizeof(authToken) - 1);
+        authToken[sizeof(authToken) - 1] = '\0';
+    }
+
+    // The game controls are for, and whose board is broadcast.
+    void setGame(LedGame g) { game = g; }
+
+    void handleEvent(uint8_t num, WStype_t type, uint8_t *payload, size_t length) {
+        if (num >= WEBSOCKETS_SERVER_CLIENT_MAX) return;
+        switch (type) {
+            case WStype_CONNECTED:
+                Serial.printf("WS: Client %u connected (awaiting auth)\n", num);
+                clients[num] = Client();
+                break;
+
+            case WStype_DISCONNECTED:
+                Serial.printf("WS: Client %u disconnected\n", num);
+                clients[num] = Client();
+                if (num == activeClient) {
+                    activeClient = GAME_SOCKET_NO_CLIENT;
+                    // Return to AI mode for whichever game is active
+                    sendInput(GAME_RELEASE);
+                }
+                break;
+
+            case WStype_TEXT:
+                handleCommand(num, (const char *)payload, length);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    void loop() { ws.loop(); }
+
+    // Send the board to the game pad if a game is on and a frame is due.
+    // Returns the bytes sent, 0 if nothing went out.
+    int broadcastGame() {
+        LedGame want = activeClient == GAME_SOCKET_NO_CLIENT ? LED_GAME_NONE : game;
+        wantedGame.store(want, std::memory_order_relaxed);
+        if (want == LED_GAME_NONE) return 0;
+
+        if (inputSink) {
+            // The owning task paces the board; send the newest it published
+            uint8_t slot, newest = GAME_SOCKET_NO_BOARD;
+            while (readyBoards.pop(slot)) {
+                if (newest != GAME_SOCKET_NO_BOARD) freeBoards.push(newest);
+                newest = slot;
+            }
+            if (newest == GAME_SOCKET_NO_BOARD) return 0;
+            int len = sendBoard(boards[newest]);
+            freeBoards.push(newest);
+            return len;
+        }
+
+        if (millis() - lastBroadcastMs < GAME_SOCKET_BROADCAST_MS) return 0;
+        lastBroadcastMs = millis();
+        readBoard(want, boards[0]);
+        return sendBoard(boards[0]);
+    }
+
+    // On the task that owns the games, once a frame is finished: snapshot
+    // the board for broadcastGame() if the game pad wants one and it is
+    // due. Skipped while the socket side still holds both buffers.
+    void publishGame() {
+        LedGame want = (LedGame)wantedGame.load(std::memory_order_relaxed);
+        if (want == LED_GAME_NONE || millis() - lastPublishMs < GAME_SOCKET_BROADCAST_MS) return;
+        uint8_t slot;
+        if (!freeBoards.pop(slot)) return;
+        lastPublishMs = millis();
+        readBoard(want, boards[slot]);
+        readyBoards.push(slot);        // two buffers, so never full
+    }
+
+    // ─── Subscribers ───────────────────────────────────────────────────────
+    // Clients that asked the sketch for pushes (the dashboard's status).
+    // Cleared when the client disconnects.
+
+    void subscribe(uint8_t num) {
+        if (num < WEBSOCKETS_SERVER_CLIENT_MAX) clients[num].subscribed = true;
+    }
+
+    bool anySubscribed() const {
+        for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+            if (clients[i].subscribed) return true;
+        }
+        return false;
+    }
+
+    void sendSubscribed(const char *text) {
+        for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+            if (clients[i].subscribed) ws.sendTXT(i, text);
+        }
+    }
+
+    bool send(uint8_t num, const char *text) { return ws.sendTXT(num, text); }
+
+private:
+    // Per-client state, indexed by the library's client number
+    struct Client {
+        bool authenticated;
+        bool subscribed;
+    };
+
+    WebSocketsServer     ws;
+    GameController<Geo> &games;
+    GameSocketCommand    commandHook = nullptr;
+    GameSocketInput      inputSink   = nullptr;
+    Client               clients[WEBSOCKETS_SERVER_CLIENT_MAX] = {};
+    uint8_t              activeClient = GAME_SOCKET_NO_CLIENT;
+    LedGame              game = LED_GAME_TETRIS;
+    char                 authToken[20] = {0};
+    unsigned long        lastBroadcastMs = 0;
+
+    // A board as it is broadcast
+    struct Board {
+        uint32_t grid[Geo::COUNT];
+        uint16_t score, lines;
+        bool     over;
+    };
+
+    // Boards travel between the owning task and the socket like the grid's
+    // MQTT frames: publishGame() takes a free buffer and posts it ready,
+    // broadcastGame() sends it and frees it again. Without an input sink
+    // both run on one task and only boards[0] is used.
+    Board                 boards[2];
+    SpscQueue<uint8_t, 2> freeBoards;                 // socket -> owner
+    SpscQueue<uint8_t, 2> readyBoards;                // owner -> socket
+    std::atomic<uint8_t>  wantedGame{LED_GAME_NONE};  // written by the socket side
+    unsigned long         lastPublishMs = 0;          // owner side
+
+    // Worst case per cell: "16777215," = 9 chars. The header and footer
+    // take ~80 more; the rest is margin.
+    char broadcastBuf[Geo::COUNT * 9 + 300];
+
+    void readBoard(LedGame g, Board &b) {
+        if (g == LED_GAME_SNAKE) {
+            uint16_t snakeLength;
+            games.snake.getState(b.grid, b.score, snakeLength, b.over);
+            b.lines = snakeLength;
+        } else {
+            uint8_t pType;
+            int8_t px, py;
+            uint8_t rot;
+            bool clr;
+            games.tetris.getState(b.grid, pType, px, py, rot, b.score, b.lines, b.over, clr);
+        }
+    }
+
+    int sendBoard(const Board &b) {
+        // Build JSON into fixed buffer to avoid heap fragmentation
+        int pos = snprintf(broadcastBuf, sizeof(broadcastBuf),
+            "{\"score\":%u,\"lines\":%u,\"gameOver\":%s,\"grid\":[",
+            b.score, b.lines, b.over ? "true" : "false");
+
+        for (uint16_t i = 0; i < Geo::COUNT && pos < (int)sizeof(broadcastBuf) - 12; i++) {
+            if (i > 0) broadcastBuf[pos++] = ',';
+            pos += snprintf(broadcastBuf + pos, sizeof(broadcastBuf) - pos, "%lu", (unsigned long)b.grid[i]);
+        }
+
+        if (pos < (int)sizeof(broadcastBuf) - 3) {
+            broadcastBuf[pos++] = ']';
+            broadcastBuf[pos++] = '}';
+            broadcastBuf[pos] = '\0';
+        }
+
+        ws.sendTXT(activeClient, broadcastBuf);
+        return pos;
+    }
+
+    void sendInput(GameInput input) {
+        if (inputSink) inputSink(game, input);
+        else           games.input(game, input);
+    }
+
+    void handleCommand(uint8_t num, const char *text, size_t length) {
+        JsonDocument doc;
+        DeserializationError err = deserializeJson(doc, text, length);
+        if (err) return;
+
+        const char *cmd = doc["cmd"];
+        if (!cmd) return;
+
+        // First message must be auth
+        if (!clients[num].authenticated) {
+            if (strcmp(cmd, "auth") == 0) {
+                const char *token = doc["token"];
+                if (token && strcmp(token, authToken) == 0) {
+                    clients[num].authenticated = true;
+                    ws.sendTXT(num, "{\"auth\":true}");
+                    Serial.printf("WS: Client %u authenticated\n", num);
+                } else {
+                    ws.sendTXT(num, "{\"auth\":false}");
+                    ws.disconnect(num);
+                    Serial.printf("WS: Client %u auth failed\n", num);
+                }
+            }
+            return;
+        }
+
+        if (commandHook && commandHook(num, cmd, doc)) return;
+
+        // Game controls
+        static const struct { const char *cmd; GameInput input; } COMMANDS[] = {
+            {"left", GAME_LEFT}, {"right", GAME_RIGHT}, {"up", GAME_UP}, {"down", GAME_DOWN},
+            {"rotate", GAME_ROTATE}, {"drop", GAME_DROP},
+            {"manual", GAME_MANUAL}, {"ai", GAME_AI},
+        };
+        if (strcmp(cmd, "softdrop") == 0) {
+            bool active = doc["active"] | false;
+            takeGamePad(num);
+            sendInput(active ? GAME_SOFTDROP_ON : GAME_SOFTDROP_OFF);
+            return;
+        }
+        for (const auto &c : COMMANDS) {
+            if (strcmp(cmd, c.cmd) == 0) {
+                takeGamePad(num);
+                sendInput(c.input);
+                return;
+            }
+        }
+    }
+
+    // A game control makes its sender the game pad; anything else doesn't.
+    void takeGamePad(uint8_t num) {
+        if (num == activeClient) return;
+        if (activeClient != GAME_SOCKET_NO_CLIENT) Serial.printf("WS: Client %u took the game from %u\n", num, activeClient);
+        activeClient = num;
+    }
+};
+
+#endif // GAME_SOCKET_H
@@ -0,0 +1,108 @@
+#ifndef HEATSHRINK_H
+#define HEATSHRINK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ─── Heatshrink Decoder ────────────────────────────────────────────────────
+// Streaming decoder for heatshrink (LZSS) data, the format written by
+// `heatshrink -e -w W -l L`. Compressed bytes go in as they arrive, in
+// chunks of any size; the only state is the 2^W-byte history window.
+//
+// The window doubles as the output buffer. Each time it fills, the sink is
+// handed the whole window, and finish() hands over whatever is left, so
+// output always comes in window-sized pieces with no copy. The sink must be
+// done with the bytes when it returns:
+//
+//   static HeatshrinkDecoder<11, 4> hs;   // 2 KB
+//   hs.reset();
+//   hs.feed(chunk, len, sink);            // sink(const uint8_t *, size_t)
+//   ...
+//   hs.finish(sink);
+//
+// The stream is a run of bit-packed codes, most significant bit first:
+// 1 + 8 bits is a literal byte; 0 + W bits + L bits copies (L bits + 1)
+// bytes starting (W bits + 1) bytes back. A code cut short at the end is
+// the encoder's padding and is dropped.
+
+template <uint8_t W, uint8_t L>
+class HeatshrinkDecoder {
+    static_assert(W >= 4 && W <= 15, "heatshrink window is 2^4 .. 2^15 bytes");
+    static_assert(L >= 3 && L < W, "heatshrink lookahead must be at least 3 and below the window");
+
+public:
+    static const size_t WINDOW = (size_t)1 << W;
+
+    void reset() {
+        for (size_t i = 0; i < WINDOW; i++) window[i] = 0;   // refs before the start read zeros
+        head   = 0;
+        acc    = 0;
+        nbits  = 0;
+        state  = TAG;
+        offset = 0;
+    }
+
+    // Bytes produced since reset().
+    uint32_t produced() const { return head; }
+
+    template <typename Sink>
+    void feed(const uint8_t *in, size_t len, Sink &sink) {
+        for (;;) {
+            uint8_t need = state == TAG ? 1 : state == LITERAL ? 8 : state == INDEX ? W : L;
+            while (nbits < need) {
+                if (len == 0) return;
+                acc = (acc << 8) | *in++;
+                len--;
+                nbits += 8;
+            }
+            nbits -= need;
+            uint16_t v = (acc >> nbits) & ((1u << need) - 1);
+
+            switch (state) {
+                case TAG:
+                    state = v ? LITERAL : INDEX;
+                    break;
+                case LITERAL:
+                    put((uint8_t)v, sink);
+                    state = TAG;
+                    break;
+                case INDEX:
+                    offset = v + 1;
+                    state = COUNT;
+                    break;
+                case COUNT:
+                    for (uint16_t n = v + 1; n > 0; n--) {
+                        put(window[(head - offset) & (WINDOW - 1)], sink);
+                    }
+                    state = TAG;
+                    break;
+            }
+        }
+    }
+
+    // Hand the sink the bytes still in the window.
+    template <typename Sink>
+    void finish(Sink &sink) {
+        size_t pending = head & (WINDOW - 1);
+        if (pending) sink(window, pending);
+    }
+
+private:
+    enum State : uint8_t { TAG, LITERAL, INDEX, COUNT };
+
+    uint8_t  window[WINDOW];
+    uint32_t head;       // total output; the write position is head mod WINDOW
+    uint32_t acc;        // bit accumulator, low nbits valid
+    uint8_t  nbits;
+    State    state;
+    uint16_t offset;     // back-reference distance, between INDEX and COUNT
+
+    template <typename Sink>
+    void put(uint8_t c, Sink &sink) {
+        window[head & (WINDOW - 1)] = c;
+        head++;
+        if ((head & (WINDOW - 1)) == 0) sink(window, WINDOW);
+    }
+};
+
+#endif // HEATSHRINK_H
@@ -0,0 +1,243 @@
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ─── JSON Reader ───────────────────────────────────────────────────────────
+// A pull reader for small, flat JSON objects such as MQTT commands. It walks
+// the payload in place and copies only the strings asked for into caller
+// buffers, so parsing allocates nothing. Nested values can be skipped but
+// not read.
+//
+//   JsonReader json(payload, length);
+//   if (!json.enterObject()) return;
+//   char key[16];
+//   while (json.nextKey(key, sizeof(key))) {
+//       if (strcmp(key, "brightness") == 0) json.readUint(brightness);
+//       else                                json.skipValue();
+//   }
+//   if (json.failed()) return;            // malformed: ignore the command
+//
+// Every key must be followed by exactly one readX() or skipValue(). A
+// value of the wrong type, or one that doesn't fit, makes readX() return
+// false and is skipped; only a syntax error fails the whole document.
+
+class JsonReader {
+public:
+    JsonReader(const char *json, size_t len) : p(json), end(json + len) {}
+
+    bool failed() const { return bad; }
+
+    // Expect the document to be an object.
+    bool enterObject() {
+        space();
+        if (p >= end || *p != '{') return fail();
+        p++;
+        first = true;
+        return true;
+    }
+
+    // The next key of the object, into `key`. Returns false at the closing
+    // brace or on a syntax error. Keys longer than cap - 1 come back empty.
+    bool nextKey(char *key, size_t cap) {
+        if (bad) return false;
+        space();
+        if (p >= end) return fail();
+        if (*p == '}') {
+            p++;
+            return false;
+        }
+        if (!first) {
+            if (*p != ',') return fail();
+            p++;
+            space();
+        }
+        first = false;
+
+        int r = scanString(key, cap);
+        if (r < 0) return fail();
+        if (r == 0) key[0] = '\0';
+        space();
+        if (p >= end || *p != ':') return fail();
+        p++;
+        return true;
+    }
+
+    // A string value of at most cap - 1 bytes.
+    bool readString(char *out, size_t cap) {
+        out[0] = '\0';
+        space();
+        if (p >= end || *p != '"') {
+            skipValue();
+            return false;
+        }
+        int r = scanString(out, cap);
+        if (r < 0) return fail();
+        if (r == 0) out[0] = '\0';
+        return r > 0;
+    }
+
+    // A non-negative integer that fits in 32 bits.
+    bool readUint(uint32_t &v) {
+        space();
+        const char *start = p;
+        uint32_t n = 0;
+        bool overflow = false;
+        while (p < end && *p >= '0' && *p <= '9') {
+            uint32_t d = *p++ - '0';
+            if (n > (UINT32_MAX - d) / 10) overflow = true;
+            n = n * 10 + d;
+        }
+        if (p == start || overflow || (p < end && !endOfValue(*p))) {
+            p = start;
+            skipValue();
+            return false;
+        }
+        v = n;
+        return true;
+    }
+
+    // true / false.
+    bool readBool(bool &v) {
+        space();
+        if (literal("true"))  { v = true;  return true; }
+        if (literal("false")) { v = false; return true; }
+        skipValue();
+        return false;
+    }
+
+    // Step over one value of any type, nested or not.
+    bool skipValue() {
+        space();
+        if (p >= end) return fail();
+        if (*p == '"') return scanString(nullptr, 0) >= 0 || fail();
+
+        if (*p == '{' || *p == '[') {
+            uint16_t depth = 0;
+            while (p < end) {
+                char c = *p;
+                if (c == '"') {
+                    if (scanString(nullptr, 0) < 0) return fail();
+                    continue;
+                }
+                p++;
+                if (c == '{' || c == '[') depth++;
+                else if (c == '}' || c == ']') {
+                    if (--depth == 0) return true;
+                }
+            }
+            return fail();
+        }
+
+        // Number or literal: up to the next delimiter
+        const char *start = p;
+        while (p < end && !endOfValue(*p)) p++;
+        return p > start || fail();
+    }
+
+private:
+    const char *p;
+    const char *end;
+    bool        bad   = false;
+    bool        first = false;
+
+    bool fail() {
+        bad = true;
+        return false;
+    }
+
+    static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+    static bool endOfValue(char c) { return c == ',' || c == '}' || c == ']' || isSpace(c); }
+
+    void space() {
+        while (p < end && isSpace(*p)) p++;
+    }
+
+    bool literal(const char *word) {
+        const char *q = p;
+        while (*word) {
+            if (q >= end || *q != *word) return false;
+            q++;
+            word++;
+        }
+        if (q < end && !endOfValue(*q)) return false;
+        p = q;
+        return true;
+    }
+
+    static int hexDigit(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    // Consume a string at p, unescaping into out (NUL-terminated) when out
+    // is given. Returns 1 if it fit, 0 if it was too long (still consumed),
+    // -1 on a syntax error. \u escapes are written as UTF-8; surrogate
+    // pairs are not joined.
+    int scanString(char *out, size_t cap) {
+        if (p >= end || *p != '"') return -1;
+        p++;
+        size_t n = 0;
+        bool fits = true;
+        while (p < end) {
+            char c = *p++;
+            if (c == '"') {
+                if (out && fits) out[n] = '\0';
+                return fits ? 1 : 0;
+            }
+            if ((uint8_t)c < 0x20) return -1;
+
+            char buf[3];
+            uint8_t len = 1;
+            buf[0] = c;
+            if (c == '\\') {
+                if (p >= end) return -1;
+                c = *p++;
+                switch (c) {
+                    case '"': case '\\': case '/': buf[0] = c; break;
+                    case 'b': buf[0] = '\b'; break;
+                    case 'f': buf[0] = '\f'; break;
+                    case 'n': buf[0] = '\n'; break;
+                    case 'r': buf[0] = '\r'; break;
+                    case 't': buf[0] = '\t'; break;
+                    case 'u': {
+                        if (end - p < 4) return -1;
+                        uint16_t u = 0;
+                        for (uint8_t i = 0; i < 4; i++) {
+                            int h = hexDigit(*p++);
+                            if (h < 0) return -1;
+                            u = (u << 4) | h;
+                        }
+                        if (u < 0x80) {
+                            buf[0] = (char)u;
+                        } else if (u < 0x800) {
+                            buf[0] = (char)(0xC0 | (u >> 6));
+                            buf[1] = (char)(0x80 | (u & 0x3F));
+                            len = 2;
+                        } else {
+                            buf[0] = (char)(0xE0 | (u >> 12));
+                            buf[1] = (char)(0x80 | ((u >> 6) & 0x3F));
+                            buf[2] = (char)(0x80 | (u & 0x3F));
+                            len = 3;
+                        }
+                        break;
+                    }
+                    default: return -1;
+                }
+            }
+
+            if (!out || !fits) continue;
+            if (n + len >= cap) {
+                fits = false;
+                continue;
+            }
+            for (uint8_t i = 0; i < len; i++) out[n++] = buf[i];
+        }
+        return -1;
+    }
+};
+
+#endif // JSON_READER_H
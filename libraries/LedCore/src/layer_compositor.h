@@ -0,0 +1,420 @@
+#ifndef LAYER_COMPOSITOR_H
+#define LAYER_COMPOSITOR_H
+
+#include <Arduino.h>
+#include <Adafruit_NeoPixel.h>
+#include "pixel_kernels.h"
+
+// ─── Layer Compositor ──────────────────────────────────────────────────────
+// The running effect draws into a base layer; up to MAX_OVERLAYS overlay
+// layers (text, sprites, solid regions) sit above it in slot order. Each
+// composite copies the base, blends every active overlay over it and
+// pushes the result with a single strip.show().
+//
+// Effects keep their own frame rate: an overlay change (new text, a scroll
+// step, an expiry) re-composites from the stored base layer without
+// running the effect again.
+//
+// Templated on the sketch's screen geometry: overlays are placed in screen
+// coordinates ((0, 0) top-left as the viewer sees it), and Screen::index()
+// maps them to the strip. A sketch whose logical frame is mirrored passes
+// LedMirrorX<GridGeometry>.
+
+#define MAX_OVERLAYS       4
+#define OVERLAY_TEXT_MAX   48
+#define OVERLAY_SPRITE_MAX 16     // sprite bitmaps are up to 16x16
+
+// ─── Base layer canvas ─────────────────────────────────────────────────────
+// Stands in for the Adafruit_NeoPixel calls effects make. Pixels are stored
+// unscaled (0x00RRGGBB, strip order); show() marks a finished frame for the
+// compositor instead of driving the data pin. Brightness is applied once,
+// on the composited output.
+
+template <uint16_t N>
+class LedCanvas {
+public:
+    void setPixelColor(uint16_t n, uint32_t c) {
+        if (n < N) px[n] = c & 0xFFFFFF;
+    }
+    void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b) {
+        if (n < N) px[n] = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+    }
+    uint32_t getPixelColor(uint16_t n) const { return n < N ? px[n] : 0; }
+
+    // Same semantics as Adafruit_NeoPixel::fill(): count 0 runs to the end.
+    void fill(uint32_t c = 0, uint16_t first = 0, uint16_t count = 0) {
+        if (first >= N) return;
+        uint16_t end = (count == 0 || first + count > N) ? N : first + count;
+        c &= 0xFFFFFF;
+        for (uint16_t i = first; i < end; i++) px[i] = c;
+    }
+    void clear() { memset(px, 0, sizeof(px)); }
+
+    // Bulk copy of a strip-order framebuffer.
+    void setPixels(const uint32_t *src) { memcpy(px, src, sizeof(px)); }
+
+    void show() { fresh = true; }
+    uint16_t numPixels() const { return N; }
+
+    const uint32_t *pixels() const { return px; }
+
+    // True once per show() — consumed by the compositor.
+    bool takeFrame() { bool f = fresh; fresh = false; return f; }
+
+private:
+    uint32_t px[N] = {0};
+    bool     fresh = false;
+};
+
+// ─── Overlays ──────────────────────────────────────────────────────────────
+
+enum OverlayType : uint8_t {
+    OVERLAY_NONE,
+    OVERLAY_SOLID,     // filled w x h rectangle
+    OVERLAY_TEXT,      // 3x5 font, clipped to w x h; scrolls when wider
+    OVERLAY_SPRITE,    // 1-bit w x h bitmap drawn in `colour`
+};
+
+enum BlendMode : uint8_t {
+    BLEND_NORMAL,      // alpha-over
+    BLEND_ADD,         // saturating add, scaled by alpha
+    BLEND_MULTIPLY,    // darken the base through the overlay colour
+    BLEND_COUNT
+};
+
+// Screen coordinates: (0, 0) is the top-left pixel as the viewer sees it.
+struct Overlay {
+    OverlayType type;
+    BlendMode   blend;
+    uint8_t     alpha;        // 0-255 opacity
+    int16_t     x, y;         // top-left, may be partly off-screen
+    uint8_t     w, h;         // region (solid/text clip) or bitmap size
+    uint32_t    colour;       // 0x00RRGGBB
+    uint16_t    scrollMs;     // text: ms per 1-pixel scroll step (0 = static)
+    uint32_t    durationMs;   // auto-clear after this long (0 = until cleared)
+    char        text[OVERLAY_TEXT_MAX];
+    uint16_t    sprite[OVERLAY_SPRITE_MAX];  // rows, bit 15 = leftmost pixel
+};
+
+// Name ↔ enum helpers for the HTTP/MQTT front ends ("text", "add", ...).
+// Unknown names return OVERLAY_NONE / BLEND_NORMAL.
+inline OverlayType overlayTypeFromName(const char *name) {
+    if (!name) return OVERLAY_NONE;
+    if (strcmp(name, "solid") == 0)  return OVERLAY_SOLID;
+    if (strcmp(name, "text") == 0)   return OVERLAY_TEXT;
+    if (strcmp(name, "sprite") == 0) return OVERLAY_SPRITE;
+    return OVERLAY_NONE;
+}
+
+inline BlendMode blendModeFromName(const char *name) {
+    if (!name) return BLEND_NORMAL;
+    if (strcmp(name, "add") == 0)      return BLEND_ADD;
+    if (strcmp(name, "multiply") == 0) return BLEND_MULTIPLY;
+    return BLEND_NORMAL;
+}
+
+// ─── Frame output hooks ────────────────────────────────────────────────────
+// Frames leave through present(): strip.show() unless a presenter has been
+// installed (a tiled wall splits the strip across several data pins).
+//
+// A brightness governor, if installed, picks the strip brightness for each
+// composited frame from its unscaled pixels (strip order) just before the
+// blit. Without one, the brightness set on the strip is used as-is.
+
+typedef void    (*FramePresenter)(Adafruit_NeoPixel &strip);
+typedef uint8_t (*BrightnessGovernor)(const uint32_t *px);
+
+// ─── 3x5 Font ──────────────────────────────────────────────────────────────
+// ASCII 0x20-0x5F, 5 rows of 3 bits (bit 2 = left column). Lower case is
+// drawn as upper case; anything else renders as '?'.
+
+#define OVERLAY_FONT_FIRST  0x20
+#define OVERLAY_FONT_LAST   0x5F
+#define OVERLAY_GLYPH_W     3
+#define OVERLAY_GLYPH_H     5
+#define OVERLAY_GLYPH_ADV   (OVERLAY_GLYPH_W + 1)
+
+static const uint8_t OVERLAY_FONT_3X5[OVERLAY_FONT_LAST - OVERLAY_FONT_FIRST + 1][OVERLAY_GLYPH_H] PROGMEM = {
+    {0b000, 0b000, 0b000, 0b000, 0b000},  // space
+    {0b010, 0b010, 0b010, 0b000, 0b010},  // !
+    {0b101, 0b101, 0b000, 0b000, 0b000},  // "
+    {0b101, 0b111, 0b101, 0b111, 0b101},  // #
+    {0b011, 0b110, 0b010, 0b011, 0b110},  // $
+    {0b101, 0b001, 0b010, 0b100, 0b101},  // %
+    {0b010, 0b101, 0b010, 0b101, 0b011},  // &
+    {0b010, 0b010, 0b000, 0b000, 0b000},  // '
+    {0b001, 0b010, 0b010, 0b010, 0b001},  // (
+    {0b100, 0b010, 0b010, 0b010, 0b100},  // )
+    {0b000, 0b101, 0b010, 0b101, 0b000},  // *
+    {0b000, 0b010, 0b111, 0b010, 0b000},  // +
+    {0b000, 0b000, 0b000, 0b010, 0b100},  // ,
+    {0b000, 0b000, 0b111, 0b000, 0b000},  // -
+    {0b000, 0b000, 0b000, 0b000, 0b010},  // .
+    {0b001, 0b001, 0b010, 0b100, 0b100},  // /
+    {0b111, 0b101, 0b101, 0b101, 0b111},  // 0
+    {0b010, 0b110, 0b010, 0b010, 0b111},  // 1
+    {0b111, 0b001, 0b111, 0b100, 0b111},  // 2
+    {0b111, 0b001, 0b111, 0b001, 0b111},  // 3
+    {0b101, 0b101, 0b111, 0b001, 0b001},  // 4
+    {0b111, 0b100, 0b111, 0b001, 0b111},  // 5
+    {0b111, 0b100, 0b111, 0b101, 0b111},  // 6
+    {0b111, 0b001, 0b010, 0b010, 0b010},  // 7
+    {0b111, 0b101, 0b111, 0b101, 0b111},  // 8
+    {0b111, 0b101, 0b111, 0b001, 0b111},  // 9
+    {0b000, 0b010, 0b000, 0b010, 0b000},  // :
+    {0b000, 0b010, 0b000, 0b010, 0b100},  // ;
+    {0b001, 0b010, 0b100, 0b010, 0b001},  // <
+    {0b000, 0b111, 0b000, 0b111, 0b000},  // =
+    {0b100, 0b010, 0b001, 0b010, 0b100},  // >
+    {0b111, 0b001, 0b010, 0b000, 0b010},  // ?
+    {0b111, 0b101, 0b111, 0b100, 0b011},  // @
+    {0b010, 0b101, 0b111, 0b101, 0b101},  // A
+    {0b110, 0b101, 0b110, 0b101, 0b110},  // B
+    {0b011, 0b100, 0b100, 0b100, 0b011},  // C
+    {0b110, 0b101, 0b101, 0b101, 0b110},  // D
+    {0b111, 0b100, 0b110, 0b100, 0b111},  // E
+    {0b111, 0b100, 0b110, 0b100, 0b100},  // F
+    {0b011, 0b100, 0b101, 0b101, 0b011},  // G
+    {0b101, 0b101, 0b111, 0b101, 0b101},  // H
+    {0b111, 0b010, 0b010, 0b010, 0b111},  // I
+    {0b001, 0b001, 0b001, 0b101, 0b010},  // J
+    {0b101, 0b101, 0b110, 0b101, 0b101},  // K
+    {0b100, 0b100, 0b100, 0b100, 0b111},  // L
+    {0b101, 0b111, 0b111, 0b101, 0b101},  // M
+    {0b110, 0b101, 0b101, 0b101, 0b101},  // N
+    {0b010, 0b101, 0b101, 0b101, 0b010},  // O
+    {0b110, 0b101, 0b110, 0b100, 0b100},  // P
+    {0b010, 0b101, 0b101, 0b110, 0b011},  // Q
+    {0b110, 0b101, 0b110, 0b101, 0b101},  // R
+    {0b011, 0b100, 0b010, 0b001, 0b110},  // S
+    {0b111, 0b010, 0b010, 0b010, 0b010},  // T
+    {0b101, 0b101, 0b101, 0b101, 0b111},  // U
+    {0b101, 0b101, 0b101, 0b101, 0b010},  // V
+    {0b101, 0b101, 0b111, 0b111, 0b101},  // W
+    {0b101, 0b101, 0b010, 0b101, 0b101},  // X
+    {0b101, 0b101, 0b010, 0b010, 0b010},  // Y
+    {0b111, 0b001, 0b010, 0b100, 0b111},  // Z
+    {0b011, 0b010, 0b010, 0b010, 0b011},  // [
+    {0b100, 0b100, 0b010, 0b001, 0b001},  // backslash
+    {0b110, 0b010, 0b010, 0b010, 0b110},  // ]
+    {0b010, 0b101, 0b000, 0b000, 0b000},  // ^
+    {0b000, 0b000, 0b000, 0b000, 0b111},  // _
+};
+
+// ─── Compositor ────────────────────────────────────────────────────────────
+
+template <class Screen>
+class LayerCompositor {
+public:
+    typedef LedCanvas<Screen::COUNT> Canvas;
+
+    // The base layer effects draw into.
+    Canvas base;
+
+    // Zeroed overlay covering the whole screen, opaque, normal blend, white.
+    void overlayDefaults(Overlay &ov) const {
+        memset(&ov, 0, sizeof(ov));
+        ov.blend  = BLEND_NORMAL;
+        ov.alpha  = 255;
+        ov.w      = Screen::WIDTH;
+        ov.h      = Screen::HEIGHT;
+        ov.colour = 0xFFFFFF;
+    }
+
+    // Install an overlay in `slot` (higher slots draw on top). Returns false
+    // for an out-of-range slot.
+    bool setOverlay(uint8_t slot, const Overlay &ov) {
+        if (slot >= MAX_OVERLAYS) return false;
+        OverlaySlot &s = slots[slot];
+        s.ov = ov;
+        s.ov.text[OVERLAY_TEXT_MAX - 1] = '\0';
+        if (s.ov.blend >= BLEND_COUNT) s.ov.blend = BLEND_NORMAL;
+        if (s.ov.type == OVERLAY_SPRITE) {
+            if (s.ov.w > OVERLAY_SPRITE_MAX) s.ov.w = OVERLAY_SPRITE_MAX;
+            if (s.ov.h > OVERLAY_SPRITE_MAX) s.ov.h = OVERLAY_SPRITE_MAX;
+        }
+        uint16_t len = strlen(s.ov.text);
+        s.textWidth  = len ? len * OVERLAY_GLYPH_ADV - 1 : 0;
+        s.startMs    = millis();
+        s.lastStepMs = s.startMs;
+        s.scrollPos  = 0;
+        dirty = true;
+        return true;
+    }
+
+    void clearOverlay(uint8_t slot) {
+        if (slot >= MAX_OVERLAYS) return;
+        slots[slot].ov.type = OVERLAY_NONE;
+        dirty = true;
+    }
+
+    void clearOverlays() {
+        for (uint8_t i = 0; i < MAX_OVERLAYS; i++) slots[i].ov.type = OVERLAY_NONE;
+        dirty = true;
+    }
+
+    // Number of slots currently showing something.
+    uint8_t activeOverlayCount() const {
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < MAX_OVERLAYS; i++) {
+            if (slots[i].ov.type != OVERLAY_NONE) n++;
+        }
+        return n;
+    }
+
+    // Composite and show if the base produced a frame or any overlay changed.
+    // Call every loop(); returns true when it pushed a frame.
+    bool composite(Adafruit_NeoPixel &strip) {
+        bool changed = base.takeFrame();
+        changed |= tickOverlays(millis());
+        changed |= dirty;
+        if (!changed) return false;
+        dirty = false;
+
+        const uint32_t *src = base.pixels();
+        if (activeOverlayCount() > 0) {
+            memcpy(out, src, sizeof(out));
+            for (uint8_t i = 0; i < MAX_OVERLAYS; i++) {
+                const OverlaySlot &s = slots[i];
+                switch (s.ov.type) {
+                    case OVERLAY_SOLID:  drawSolid(s.ov);  break;
+                    case OVERLAY_TEXT:   drawText(s);      break;
+                    case OVERLAY_SPRITE: drawSprite(s.ov); break;
+                    default: break;
+                }
+            }
+            src = out;
+        }
+
+        if (governor) {
+            uint8_t b = governor(src);
+            if (b != strip.getBrightness()) strip.setBrightness(b);
+        }
+        for (uint16_t i = 0; i < Screen::COUNT; i++) strip.setPixelColor(i, src[i]);
+        present(strip);
+        return true;
+    }
+
+    // ─── Frame output ──────────────────────────────────────────────────────
+
+    void setFramePresenter(FramePresenter fn)        { presenter = fn; }
+    void setBrightnessGovernor(BrightnessGovernor fn) { governor = fn; }
+
+    void present(Adafruit_NeoPixel &strip) {
+        if (presenter) presenter(strip);
+        else           strip.show();
+    }
+
+private:
+    struct OverlaySlot {
+        Overlay  ov;
+        uint32_t startMs;      // for durationMs expiry
+        uint32_t lastStepMs;   // last text scroll step
+        uint16_t scrollPos;    // pixels scrolled so far
+        uint16_t textWidth;    // cached pixel width of ov.text
+    };
+
+    OverlaySlot        slots[MAX_OVERLAYS] = {};
+    uint32_t           out[Screen::COUNT];
+    bool               dirty     = false;
+    FramePresenter     presenter = nullptr;
+    BrightnessGovernor governor  = nullptr;
+
+    // ─── Blending ──────────────────────────────────────────────────────────
+
+    static inline uint32_t blendPixel(uint32_t dst, uint32_t src, BlendMode mode, uint8_t alpha) {
+        switch (mode) {
+            case BLEND_ADD:
+                return addColour(dst, scaleColour(src, alpha));
+            case BLEND_MULTIPLY:
+                src = mulColour(dst, src);
+                break;
+            default:
+                break;
+        }
+        // 255 → 256 so an opaque overlay fully replaces the base
+        return lerpColour(dst, src, alpha + (alpha >> 7));
+    }
+
+    inline void plot(int16_t x, int16_t y, const Overlay &ov) {
+        if (x < 0 || y < 0 || x >= Screen::WIDTH || y >= Screen::HEIGHT) return;
+        uint16_t idx = Screen::index((uint8_t)x, (uint8_t)y);
+        out[idx] = blendPixel(out[idx], ov.colour, ov.blend, ov.alpha);
+    }
+
+    static const uint8_t *glyphFor(char ch) {
+        if (ch >= 'a' && ch <= 'z') ch -= 'a' - 'A';
+        if (ch < OVERLAY_FONT_FIRST || ch > OVERLAY_FONT_LAST) ch = '?';
+        return OVERLAY_FONT_3X5[ch - OVERLAY_FONT_FIRST];
+    }
+
+    // ─── Overlay renderers ─────────────────────────────────────────────────
+
+    void drawSolid(const Overlay &ov) {
+        for (int16_t y = ov.y; y < ov.y + ov.h; y++) {
+            for (int16_t x = ov.x; x < ov.x + ov.w; x++) plot(x, y, ov);
+        }
+    }
+
+    void drawSprite(const Overlay &ov) {
+        for (uint8_t row = 0; row < ov.h; row++) {
+            uint16_t bits = ov.sprite[row];
+            for (uint8_t col = 0; col < ov.w; col++) {
+                if (bits & (0x8000 >> col)) plot(ov.x + col, ov.y + row, ov);
+            }
+        }
+    }
+
+    // Text is clipped to the overlay's w x h window. When it doesn't fit and
+    // scrollMs is set, it enters from the right edge and leaves on the left.
+    void drawText(const OverlaySlot &s) {
+        const Overlay &ov = s.ov;
+        int16_t clipR = ov.x + ov.w;
+        int16_t clipB = ov.y + ov.h;
+        int16_t penX  = ov.x;
+        if (ov.scrollMs && s.textWidth > ov.w) penX = ov.x + ov.w - (int16_t)s.scrollPos;
+
+        for (const char *p = ov.text; *p; p++, penX += OVERLAY_GLYPH_ADV) {
+            if (penX >= clipR) break;
+            if (penX + OVERLAY_GLYPH_W <= ov.x) continue;
+            const uint8_t *glyph = glyphFor(*p);
+            for (uint8_t row = 0; row < OVERLAY_GLYPH_H; row++) {
+                int16_t y = ov.y + row;
+                if (y >= clipB) break;
+                uint8_t bits = pgm_read_byte(&glyph[row]);
+                for (uint8_t col = 0; col < OVERLAY_GLYPH_W; col++) {
+                    int16_t x = penX + col;
+                    if (x < ov.x || x >= clipR) continue;
+                    if (bits & (0b100 >> col)) plot(x, y, ov);
+                }
+            }
+        }
+    }
+
+    // Expire timed overlays and advance scrolling text. Returns true if
+    // anything visible changed.
+    bool tickOverlays(uint32_t now) {
+        bool changed = false;
+        for (uint8_t i = 0; i < MAX_OVERLAYS; i++) {
+            OverlaySlot &s = slots[i];
+            if (s.ov.type == OVERLAY_NONE) continue;
+
+            if (s.ov.durationMs && now - s.startMs >= s.ov.durationMs) {
+                s.ov.type = OVERLAY_NONE;
+                changed = true;
+                continue;
+            }
+            if (s.ov.type == OVERLAY_TEXT && s.ov.scrollMs && s.textWidth > s.ov.w &&
+                now - s.lastStepMs >= s.ov.scrollMs) {
+                // Catch up on missed steps so a slow loop doesn't slow the scroll
+                uint32_t steps = (now - s.lastStepMs) / s.ov.scrollMs;
+                s.lastStepMs += steps * s.ov.scrollMs;
+                s.scrollPos = (s.scrollPos + steps) % (s.textWidth + s.ov.w);
+                changed = true;
+            }
+        }
+        return changed;
+    }
+};
+
+#endif // LAYER_COMPOSITOR_H
@@ -0,0 +1,96 @@
+#ifndef LED_GEOMETRY_H
+#define LED_GEOMETRY_H
+
+#include <Arduino.h>
+
+// ─── Grid Geometry ─────────────────────────────────────────────────────────
+// Compile-time description of a matrix: logical size, how the strip is
+// wired (row- or column-major, serpentine or not) and how the physical
+// matrix is rotated relative to the logical (x, y) frame. Each sketch
+// typedefs one in config.h:
+//
+//   typedef LedGeometry<16, 16, WIRING_ROWS, ROTATE_90, true> GridGeometry;
+//
+// Everything is a constant expression, so loops bounded by WIDTH/HEIGHT
+// unroll and specialise, and index() folds to a constant for constant
+// coordinates. Logical (0, 0) is the top-left of the logical frame.
+
+enum LedWiring : uint8_t {
+    WIRING_ROWS,       // strip runs along physical rows
+    WIRING_COLUMNS,    // strip runs down physical columns
+};
+
+// Clockwise rotation taking the logical frame to the physical one.
+enum LedRotation : uint8_t {
+    ROTATE_0,
+    ROTATE_90,
+    ROTATE_180,
+    ROTATE_270,
+};
+
+// Type-level if: LedSelect<true, A, B>::type is A.
+template <bool C, typename A, typename B> struct LedSelect { typedef A type; };
+template <typename A, typename B> struct LedSelect<false, A, B> { typedef B type; };
+
+// Smallest unsigned integer with at least N bits — one grid row as a bitmask.
+template <uint8_t N> struct LedBits {
+    typedef typename LedSelect<(N <= 8),  uint8_t,
+            typename LedSelect<(N <= 16), uint16_t,
+            typename LedSelect<(N <= 32), uint32_t,
+                                          uint64_t>::type>::type>::type type;
+};
+
+template <uint8_t W, uint8_t H, LedWiring WIRING, LedRotation ROT, bool SERPENTINE>
+struct LedGeometry {
+    static const uint8_t  WIDTH  = W;
+    static const uint8_t  HEIGHT = H;
+    static const uint16_t COUNT  = (uint16_t)W * H;
+
+    // One bit per column, bit x = column x.
+    typedef typename LedBits<W>::type RowBits;
+    static const RowBits FULL_ROW = (RowBits)(((RowBits)1 << (W - 1)) * 2 - 1);
+
+    // Physical matrix size: a quarter turn swaps the axes.
+    static const bool    SWAPPED = (ROT == ROTATE_90 || ROT == ROTATE_270);
+    static const uint8_t PHYS_W  = SWAPPED ? H : W;
+    static const uint8_t PHYS_H  = SWAPPED ? W : H;
+
+    static constexpr uint8_t physX(uint8_t x, uint8_t y) {
+        return ROT == ROTATE_0   ? x :
+               ROT == ROTATE_90  ? y :
+               ROT == ROTATE_180 ? (uint8_t)(W - 1 - x) :
+                                   (uint8_t)(H - 1 - y);
+    }
+
+    static constexpr uint8_t physY(uint8_t x, uint8_t y) {
+        return ROT == ROTATE_0   ? y :
+               ROT == ROTATE_90  ? (uint8_t)(W - 1 - x) :
+               ROT == ROTATE_180 ? (uint8_t)(H - 1 - y) :
+                                   x;
+    }
+
+    // Strip position of a physical cell. Serpentine wiring reverses every
+    // odd row (or column).
+    static constexpr uint16_t wire(uint8_t px, uint8_t py) {
+        return WIRING == WIRING_ROWS
+            ? (uint16_t)py * PHYS_W + ((SERPENTINE && (py & 1)) ? PHYS_W - 1 - px : px)
+            : (uint16_t)px * PHYS_H + ((SERPENTINE && (px & 1)) ? PHYS_H - 1 - py : py);
+    }
+
+    // Logical (x, y) to strip index. Out-of-range coordinates map to 0.
+    static constexpr uint16_t index(uint8_t x, uint8_t y) {
+        return (x >= W || y >= H) ? 0 : wire(physX(x, y), physY(x, y));
+    }
+};
+
+// Any geometry with its x axis flipped, for a sketch whose logical frame
+// runs right→left as the viewer sees it: screen (x, y) is logical
+// (WIDTH - 1 - x, y). Overlays and text are laid out in screen coordinates.
+template <class Geo>
+struct LedMirrorX : Geo {
+    static inline uint16_t index(uint8_t x, uint8_t y) {
+        return Geo::index((uint8_t)(Geo::WIDTH - 1 - x), y);
+    }
+};
+
+#endif // LED_GEOMETRY_H
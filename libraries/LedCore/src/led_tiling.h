@@ -0,0 +1,113 @@
+#ifndef LED_TILING_H
+#define LED_TILING_H
+
+#include <Arduino.h>
+#include "led_geometry.h"
+
+// ─── Tiled Geometry ────────────────────────────────────────────────────────
+// Several identical PW x PH panels chained into a COLS x ROWS wall, which
+// effects address as one (COLS*PW) x (ROWS*PH) grid. The wall is described
+// by a table of LedTile entries, one per panel, in data-chain order:
+//
+//   static const LedTile WALL_LAYOUT[] = {
+//       // col row  rotation    serpentine  output
+//       {  0,  0,  ROTATE_90,  true,       0 },
+//       {  1,  0,  ROTATE_270, true,       0 },
+//       {  0,  1,  ROTATE_90,  true,       1 },
+//       {  1,  1,  ROTATE_270, true,       1 },
+//   };
+//
+// Panels on the same output are chained in table order. The strip buffer
+// holds every panel of output 0 first, then output 1 and so on, so each
+// output sends one contiguous span (outputSpan()). build() compiles the
+// table into a logical→strip index map once at boot; index() is then a
+// single lookup, the same cost whatever the layout. Cells no tile covers
+// map to 0.
+
+struct LedTile {
+    uint8_t     col, row;      // position on the wall, in panels (0, 0 = top-left)
+    LedRotation rotation;      // panel mounting, as for LedGeometry
+    bool        serpentine;    // odd rows (or columns) run backwards
+    uint8_t     output;        // data pin / RMT channel driving the panel
+};
+
+template <uint8_t PW, uint8_t PH, uint8_t COLS, uint8_t ROWS, LedWiring WIRING>
+struct LedTiledGeometry {
+    static const uint8_t  WIDTH       = PW * COLS;
+    static const uint8_t  HEIGHT      = PH * ROWS;
+    static const uint16_t COUNT       = (uint16_t)WIDTH * HEIGHT;
+    static const uint8_t  TILES       = COLS * ROWS;
+    static const uint16_t PANEL_COUNT = (uint16_t)PW * PH;
+
+    // One bit per column, bit x = column x.
+    typedef typename LedBits<WIDTH>::type RowBits;
+    static const RowBits FULL_ROW = (RowBits)(((RowBits)1 << (WIDTH - 1)) * 2 - 1);
+
+    // Logical (x, y) → strip index, row-major. Filled by build().
+    static uint16_t indexMap[COUNT];
+
+    // Strip offset of the first LED of tile t.
+    static uint16_t tileBase(const LedTile *tiles, uint8_t t) {
+        uint16_t base = 0;
+        for (uint8_t i = 0; i < TILES; i++) {
+            if (tiles[i].output < tiles[t].output ||
+                (tiles[i].output == tiles[t].output && i < t)) {
+                base += PANEL_COUNT;
+            }
+        }
+        return base;
+    }
+
+    // Strip span driven by one output. count is 0 for an unused output.
+    static void outputSpan(const LedTile *tiles, uint8_t output,
+                           uint16_t &first, uint16_t &count) {
+        first = 0;
+        count = 0;
+        for (uint8_t i = 0; i < TILES; i++) {
+            if (tiles[i].output < output)       first += PANEL_COUNT;
+            else if (tiles[i].output == output) count += PANEL_COUNT;
+        }
+    }
+
+    // Compile the layout table (TILES entries) into indexMap.
+    static void build(const LedTile *tiles) {
+        for (uint8_t t = 0; t < TILES; t++) {
+            const LedTile &tile = tiles[t];
+            if (tile.col >= COLS || tile.row >= ROWS) continue;
+            uint16_t base = tileBase(tiles, t);
+            for (uint8_t y = 0; y < PH; y++) {
+                uint16_t row = (uint16_t)(tile.row * PH + y) * WIDTH + tile.col * PW;
+                for (uint8_t x = 0; x < PW; x++) {
+                    indexMap[row + x] = base + panelIndex(tile, x, y);
+                }
+            }
+        }
+    }
+
+    // Logical (x, y) to strip index. Out-of-range coordinates map to 0.
+    static inline uint16_t index(uint8_t x, uint8_t y) {
+        return (x >= WIDTH || y >= HEIGHT) ? 0 : indexMap[(uint16_t)y * WIDTH + x];
+    }
+
+private:
+    // Index within one panel; each mounting is its own LedGeometry.
+    template <bool SERPENTINE>
+    static uint16_t panelIndex(LedRotation rot, uint8_t x, uint8_t y) {
+        switch (rot) {
+            case ROTATE_90:  return LedGeometry<PW, PH, WIRING, ROTATE_90,  SERPENTINE>::index(x, y);
+            case ROTATE_180: return LedGeometry<PW, PH, WIRING, ROTATE_180, SERPENTINE>::index(x, y);
+            case ROTATE_270: return LedGeometry<PW, PH, WIRING, ROTATE_270, SERPENTINE>::index(x, y);
+            default:         return LedGeometry<PW, PH, WIRING, ROTATE_0,   SERPENTINE>::index(x, y);
+        }
+    }
+
+    static uint16_t panelIndex(const LedTile &tile, uint8_t x, uint8_t y) {
+        return tile.serpentine ? panelIndex<true>(tile.rotation, x, y)
+                               : panelIndex<false>(tile.rotation, x, y);
+    }
+};
+
+template <uint8_t PW, uint8_t PH, uint8_t COLS, uint8_t ROWS, LedWiring WIRING>
+uint16_t LedTiledGeometry<PW, PH, COLS, ROWS, WIRING>::indexMap[LedTiledGeometry<PW, PH, COLS, ROWS, WIRING>::COUNT];
+
+#endif // LED_TILING_H
@@ -0,0 +1,51 @@
+#ifndef LIGHT_COMMAND_H
+#define LIGHT_COMMAND_H
+
+#include <stdint.h>
+#include <string.h>
+#include "json_reader.h"
+
+// ─── Light Command ─────────────────────────────────────────────────────────
+// The Home Assistant JSON light schema's command, e.g. {"state":"ON",
+// "brightness":128,"effect":"Fire"}. Read in place with JsonReader, so a
+// burst of commands from an automation touches no heap; keys other than
+// these three (color_mode, transition...) are skipped.
+
+struct LightCommand {
+    int8_t  state;             // 1 = ON, 0 = OFF, -1 = not given
+    int16_t brightness;        // -1 = not given
+    char    effect[24];        // "" = not given
+};
+
+// False if the payload isn't a well-formed JSON object; the command is
+// then ignored as a whole. Values of the wrong type or out of range are
+// dropped individually.
+inline bool parseLightCommand(const uint8_t *payload, size_t length, LightCommand &cmd) {
+    cmd.state      = -1;
+    cmd.brightness = -1;
+    cmd.effect[0]  = '\0';
+
+    JsonReader json((const char *)payload, length);
+    if (!json.enterObject()) return false;
+
+    char key[16];
+    while (json.nextKey(key, sizeof(key))) {
+        if (strcmp(key, "state") == 0) {
+            char state[4];
+            if (json.readString(state, sizeof(state))) {
+                if (strcmp(state, "ON") == 0)       cmd.state = 1;
+                else if (strcmp(state, "OFF") == 0) cmd.state = 0;
+            }
+        } else if (strcmp(key, "brightness") == 0) {
+            uint32_t b;
+            if (json.readUint(b) && b <= 255) cmd.brightness = b;
+        } else if (strcmp(key, "effect") == 0) {
+            json.readString(cmd.effect, sizeof(cmd.effect));
+        } else {
+            json.skipValue();
+        }
+    }
+    return !json.failed();
+}
+
+#endif // LIGHT_COMMAND_H
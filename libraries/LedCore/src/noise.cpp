@@ -0,0 +1,155 @@
+#include "noise.h"
+
+// Ken Perlin's reference permutation. Indices wrap at 256, so hashing a
+// lattice corner is P(P(P(x) + y) + z) with plain uint8_t arithmetic.
+static const uint8_t PERM[256] PROGMEM = {
+    151, 160, 137,  91,  90,  15, 131,  13, 201,  95,  96,  53, 194, 233,   7, 225,
+    140,  36, 103,  30,  69, 142,   8,  99,  37, 240,  21,  10,  23, 190,   6, 148,
+    247, 120, 234,  75,   0,  26, 197,  62,  94, 252, 219, 203, 117,  35,  11,  32,
+     57, 177,  33,  88, 237, 149,  56,  87, 174,  20, 125, 136, 171, 168,  68, 175,
+     74, 165,  71, 134, 139,  48,  27, 166,  77, 146, 158, 231,  83, 111, 229, 122,
+     60, 211, 133, 230, 220, 105,  92,  41,  55,  46, 245,  40, 244, 102, 143,  54,
+     65,  25,  63, 161,   1, 216,  80,  73, 209,  76, 132, 187, 208,  89,  18, 169,
+    200, 196, 135, 130, 116, 188, 159,  86, 164, 100, 109, 198, 173, 186,   3,  64,
+     52, 217, 226, 250, 124, 123,   5, 202,  38, 147, 118, 126, 255,  82,  85, 212,
+    207, 206,  59, 227,  47,  16,  58,  17, 182, 189,  28,  42, 223, 183, 170, 213,
+    119, 248, 152,   2,  44, 154, 163,  70, 221, 153, 101, 155, 167,  43, 172,   9,
+    129,  22,  39, 253,  19,  98, 108, 110,  79, 113, 224, 232, 178, 185, 112, 104,
+    218, 246,  97, 228, 251,  34, 242, 193, 238, 210, 144,  12, 191, 179, 162, 241,
+     81,  51, 145, 235, 249,  14, 239, 107,  49, 192, 214,  31, 181, 199, 106, 157,
+    184,  84, 204, 176, 115, 121,  50,  45, 127,   4, 150, 254, 138, 236, 205,  93,
+    222, 114,  67,  29,  24,  72, 243, 141, 128, 195,  78,  66, 215,  61, 156, 180,
+};
+
+// Cube-edge gradients for 3D (12 directions, four repeated to fill 16 slots)
+static const int8_t GRAD3[16][3] PROGMEM = {
+    { 1,  1,  0}, {-1,  1,  0}, { 1, -1,  0}, {-1, -1,  0},
+    { 1,  0,  1}, {-1,  0,  1}, { 1,  0, -1}, {-1,  0, -1},
+    { 0,  1,  1}, { 0, -1,  1}, { 0,  1, -1}, { 0, -1, -1},
+    { 1,  1,  0}, { 0, -1,  1}, {-1,  1,  0}, { 0, -1, -1},
+};
+
+// Square gradients for 2D: four diagonals and four axes
+static const int8_t GRAD2[8][2] PROGMEM = {
+    { 1,  1}, {-1,  1}, { 1, -1}, {-1, -1},
+    { 1,  0}, {-1,  0}, { 0,  1}, { 0, -1},
+};
+
+// Quintic fade 6t^5 - 15t^4 + 10t^3, t = i/256, scaled to 0-255. Zero first
+// and second derivative at both ends, so cell edges don't show.
+static const uint8_t FADE[256] PROGMEM = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   3,   3,   3,   3,   4,
+      4,   4,   5,   5,   6,   6,   7,   7,   8,   8,   9,   9,  10,  10,  11,  12,
+     12,  13,  14,  15,  15,  16,  17,  18,  19,  20,  20,  21,  22,  23,  24,  25,
+     26,  27,  29,  30,  31,  32,  33,  34,  35,  37,  38,  39,  41,  42,  43,  45,
+     46,  47,  49,  50,  52,  53,  55,  56,  58,  59,  61,  62,  64,  65,  67,  69,
+     70,  72,  73,  75,  77,  79,  80,  82,  84,  85,  87,  89,  91,  93,  94,  96,
+     98, 100, 102, 103, 105, 107, 109, 111, 113, 114, 116, 118, 120, 122, 124, 126,
+    128, 129, 131, 133, 135, 137, 139, 141, 142, 144, 146, 148, 150, 152, 153, 155,
+    157, 159, 161, 162, 164, 166, 168, 170, 171, 173, 175, 176, 178, 180, 182, 183,
+    185, 186, 188, 190, 191, 193, 194, 196, 197, 199, 200, 202, 203, 205, 206, 208,
+    209, 210, 212, 213, 214, 216, 217, 218, 220, 221, 222, 223, 224, 225, 226, 228,
+    229, 230, 231, 232, 233, 234, 235, 235, 236, 237, 238, 239, 240, 240, 241, 242,
+    243, 243, 244, 245, 245, 246, 246, 247, 247, 248, 248, 249, 249, 250, 250, 251,
+    251, 251, 252, 252, 252, 252, 253, 253, 253, 253, 254, 254, 254, 254, 254, 254,
+    254, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+};
+
+// Fractal sums are renormalised by 256 / (1 + 1/2 + ... + 1/2^(n-1))
+static const uint8_t OCTAVE_GAIN[NOISE_MAX_OCTAVES + 1] = {
+    0, 255, 171, 146, 137, 132,
+};
+
+static inline uint8_t P(uint8_t i) { return pgm_read_byte(&PERM[i]); }
+
+static inline int16_t lerp(int16_t a, int16_t b, uint8_t t) {
+    return a + (int16_t)(((int32_t)(b - a) * t) >> 8);
+}
+
+// Offsets are the in-cell position relative to the corner: -256..255.
+static inline int16_t grad3(uint8_t hash, int16_t dx, int16_t dy, int16_t dz) {
+    const int8_t *g = GRAD3[hash & 15];
+    return (int8_t)pgm_read_byte(&g[0]) * dx
+         + (int8_t)pgm_read_byte(&g[1]) * dy
+         + (int8_t)pgm_read_byte(&g[2]) * dz;
+}
+
+static inline int16_t grad2(uint8_t hash, int16_t dx, int16_t dy) {
+    const int8_t *g = GRAD2[hash & 7];
+    return (int8_t)pgm_read_byte(&g[0]) * dx
+         + (int8_t)pgm_read_byte(&g[1]) * dy;
+}
+
+static inline int8_t clamp8(int16_t v) {
+    return (v > 127) ? 127 : (v < -127) ? -127 : (int8_t)v;
+}
+
+// ─── Single octave ─────────────────────────────────────────────────────────
+
+int8_t noise2(uint16_t x, uint16_t y) {
+    uint8_t X = x >> 8, Y = y >> 8;
+    int16_t fx = x & 0xFF, fy = y & 0xFF;
+    uint8_t u = pgm_read_byte(&FADE[fx]);
+    uint8_t v = pgm_read_byte(&FADE[fy]);
+
+    uint8_t A = P(X) + Y;
+    uint8_t B = P(X + 1) + Y;
+
+    int16_t n0 = lerp(grad2(P(A),     fx, fy),       grad2(P(B),     fx - 256, fy),       u);
+    int16_t n1 = lerp(grad2(P(A + 1), fx, fy - 256), grad2(P(B + 1), fx - 256, fy - 256), u);
+
+    // 2D output spans roughly +/-1.0 of a cell (+/-256 here)
+    return clamp8(lerp(n0, n1, v) >> 1);
+}
+
+int8_t noise3(uint16_t x, uint16_t y, uint16_t z) {
+    uint8_t X = x >> 8, Y = y >> 8, Z = z >> 8;
+    int16_t fx = x & 0xFF, fy = y & 0xFF, fz = z & 0xFF;
+    uint8_t u = pgm_read_byte(&FADE[fx]);
+    uint8_t v = pgm_read_byte(&FADE[fy]);
+    uint8_t w = pgm_read_byte(&FADE[fz]);
+
+    uint8_t A  = P(X) + Y,     B  = P(X + 1) + Y;
+    uint8_t AA = P(A) + Z,     AB = P(A + 1) + Z;
+    uint8_t BA = P(B) + Z,     BB = P(B + 1) + Z;
+
+    int16_t gx = fx - 256, gy = fy - 256, gz = fz - 256;
+
+    int16_t x00 = lerp(grad3(P(AA),     fx, fy, fz), grad3(P(BA),     gx, fy, fz), u);
+    int16_t x10 = lerp(grad3(P(AB),     fx, gy, fz), grad3(P(BB),     gx, gy, fz), u);
+    int16_t x01 = lerp(grad3(P(AA + 1), fx, fy, gz), grad3(P(BA + 1), gx, fy, gz), u);
+    int16_t x11 = lerp(grad3(P(AB + 1), fx, gy, gz), grad3(P(BB + 1), gx, gy, gz), u);
+
+    int16_t y0 = lerp(x00, x10, v);
+    int16_t y1 = lerp(x01, x11, v);
+
+    // 3D output spans roughly +/-1.0 of a cell (+/-256 here)
+    return clamp8(lerp(y0, y1, w) >> 1);
+}
+
+// ─── Fractal octaves ───────────────────────────────────────────────────────
+// Each octave is offset by an odd constant so lattice zeros don't line up.
+
+uint8_t fractalNoise2(uint16_t x, uint16_t y, uint8_t octaves) {
+    octaves = constrain(octaves, 1, NOISE_MAX_OCTAVES);
+    int16_t sum = 0;
+    for (uint8_t o = 0; o < octaves; o++) {
+        sum += noise2(x, y) >> o;
+        x = (x << 1) + 0x3A7;
+        y = (y << 1) + 0x1F5;
+    }
+    return (uint8_t)(128 + clamp8((int16_t)((int32_t)sum * OCTAVE_GAIN[octaves] >> 8)));
+}
+
+uint8_t fractalNoise3(uint16_t x, uint16_t y, uint16_t z, uint8_t octaves) {
+    octaves = constrain(octaves, 1, NOISE_MAX_OCTAVES);
+    int16_t sum = 0;
+    for (uint8_t o = 0; o < octaves; o++) {
+        sum += noise3(x, y, z) >> o;
+        x = (x << 1) + 0x3A7;
+        y = (y << 1) + 0x1F5;
+        z = (z << 1) + 0x2C9;
+    }
+    return (uint8_t)(128 + clamp8((int16_t)((int32_t)sum * OCTAVE_GAIN[octaves] >> 8)));
+}
@@ -0,0 +1,26 @@
+#ifndef NOISE_H
+#define NOISE_H
+
+#include <Arduino.h>
+
+// ─── Gradient Noise ────────────────────────────────────────────────────────
+// Integer Perlin ("improved noise") in 2D and 3D. Coordinates are 8.8 fixed
+// point: the high byte selects the lattice cell, the low byte is the position
+// inside it, so one lattice cell spans 256 units and the field repeats every
+// 256 cells. Use the third axis as time to animate a 2D field smoothly.
+//
+// Permutation, gradient and fade tables live in flash. A sample is a handful
+// of table reads and integer multiplies — no floats, no divisions.
+
+#define NOISE_MAX_OCTAVES  5
+
+// Signed noise, roughly -127..127, 0 on every lattice point.
+int8_t noise2(uint16_t x, uint16_t y);
+int8_t noise3(uint16_t x, uint16_t y, uint16_t z);
+
+// Fractal sum of `octaves` layers (1..NOISE_MAX_OCTAVES), each at double the
+// frequency and half the amplitude of the last. Unsigned, centred on 128.
+uint8_t fractalNoise2(uint16_t x, uint16_t y, uint8_t octaves);
+uint8_t fractalNoise3(uint16_t x, uint16_t y, uint16_t z, uint8_t octaves);
+
+#endif // NOISE_H
@@ -0,0 +1,146 @@
+#ifndef PARTICLE_ENGINE_H
+#define PARTICLE_ENGINE_H
+
+#include <Arduino.h>
+#include "fast_rng.h"
+#include "pixel_kernels.h"
+
+// ─── Particle Pool ─────────────────────────────────────────────────────────
+// Fixed-capacity, structure-of-arrays particle store. Positions and
+// velocities are 8.8 fixed point (256 = one pixel, one pixel per frame).
+// Live particles are always packed into [0, count): dead ones are removed
+// by swapping the last live particle into their slot, so update and render
+// are straight loops with no liveness checks.
+//
+// A particle's life doubles as its brightness: it loses `decay` every frame
+// and renders at colour * life / 256. decay = 0 lives until it leaves the grid.
+//
+// Update and render are templated on the sketch's LedGeometry, so the
+// culling bounds and strip mapping are compile-time constants.
+
+#define PARTICLE_CAPACITY  384
+#define FP_ONE             256    // 1.0 in 8.8 fixed point
+
+struct ParticlePool {
+    int16_t  x[PARTICLE_CAPACITY];
+    int16_t  y[PARTICLE_CAPACITY];
+    int16_t  vx[PARTICLE_CAPACITY];
+    int16_t  vy[PARTICLE_CAPACITY];
+    uint32_t colour[PARTICLE_CAPACITY];
+    uint8_t  life[PARTICLE_CAPACITY];
+    uint8_t  decay[PARTICLE_CAPACITY];
+    uint16_t count;
+
+    int16_t  gravity;   // added to vy every frame (8.8)
+    uint8_t  drag;      // velocity loses drag / 256 every frame (0 = none)
+};
+
+// Continuous spawner — e.g. a row of rain across the top edge.
+struct ParticleEmitter {
+    int16_t  x, y;          // spawn origin (8.8)
+    int16_t  xSpread;       // origin jitter: x + [0, xSpread)
+    int16_t  vx, vy;        // base velocity (8.8 per frame)
+    int16_t  vySpread;      // velocity jitter: vy + [0, vySpread)
+    uint8_t  life, decay;
+    uint16_t rate;          // particles per frame (8.8)
+    uint16_t accum;         // fractional spawn carry
+    uint32_t colour;        // fixed colour, ignored when randomHue is set
+    bool     randomHue;     // colourWheel(random) per particle
+};
+
+// Empty the pool and set its physics.
+inline void particlesReset(ParticlePool &pool, int16_t gravity, uint8_t drag) {
+    pool.count   = 0;
+    pool.gravity = gravity;
+    pool.drag    = drag;
+}
+
+// Add one particle. Returns false when the pool is full.
+inline bool particleSpawn(ParticlePool &pool, int16_t x, int16_t y,
+                          int16_t vx, int16_t vy, uint32_t colour,
+                          uint8_t life, uint8_t decay) {
+    if (pool.count >= PARTICLE_CAPACITY) return false;
+    uint16_t i = pool.count++;
+    pool.x[i]      = x;
+    pool.y[i]      = y;
+    pool.vx[i]     = vx;
+    pool.vy[i]     = vy;
+    pool.colour[i] = colour;
+    pool.life[i]   = life;
+    pool.decay[i]  = decay;
+    return true;
+}
+
+// Spawn this frame's share of an emitter's rate.
+inline void particlesEmit(ParticlePool &pool, ParticleEmitter &em, FastRng &rng) {
+    em.accum += em.rate;
+    while (em.accum >= FP_ONE) {
+        em.accum -= FP_ONE;
+        int16_t x  = em.x + (int16_t)rng.below(em.xSpread);
+        int16_t vy = em.vy + (int16_t)rng.below(em.vySpread);
+        uint32_t c = em.randomHue ? colourWheel(rng.next8()) : em.colour;
+        if (!particleSpawn(pool, x, em.y, em.vx, vy, c, em.life, em.decay)) {
+            em.accum = 0;
+            return;
+        }
+    }
+}
+
+inline void particleRemoveAt(ParticlePool &pool, uint16_t i) {
+    uint16_t last = --pool.count;
+    pool.x[i]      = pool.x[last];
+    pool.y[i]      = pool.y[last];
+    pool.vx[i]     = pool.vx[last];
+    pool.vy[i]     = pool.vy[last];
+    pool.colour[i] = pool.colour[last];
+    pool.life[i]   = pool.life[last];
+    pool.decay[i]  = pool.decay[last];
+}
+
+// Integrate, age and cull every live particle by one frame. Particles may
+// arc above the top edge and fall back in; anything a grid height out, or
+// off either side / the bottom, is culled.
+template <class Geo>
+void particlesUpdate(ParticlePool &pool) {
+    const int16_t fpWidth  = (int16_t)(Geo::WIDTH * FP_ONE);
+    const int16_t fpHeight = (int16_t)(Geo::HEIGHT * FP_ONE);
+    const int16_t gravity  = pool.gravity;
+    const uint8_t drag     = pool.drag;
+
+    uint16_t i = 0;
+    while (i < pool.count) {
+        if (pool.life[i] <= pool.decay[i]) { particleRemoveAt(pool, i); continue; }
+        pool.life[i] -= pool.decay[i];
+
+        int16_t vx = pool.vx[i];
+        int16_t vy = pool.vy[i];
+        vx -= (int16_t)(((int32_t)vx * drag) >> 8);
+        vy -= (int16_t)(((int32_t)vy * drag) >> 8);
+        vy += gravity;
+        pool.vx[i] = vx;
+        pool.vy[i] = vy;
+        int16_t x = pool.x[i] + vx;
+        int16_t y = pool.y[i] + vy;
+        pool.x[i] = x;
+        pool.y[i] = y;
+
+        // Unsigned compare folds x < 0 into the right-edge test
+        if ((uint16_t)x >= (uint16_t)fpWidth || y >= fpHeight || y < -fpHeight) {
+            particleRemoveAt(pool, i);
+            continue;
+        }
+        i++;
+    }
+}
+
+// Additively draw live particles into a strip-order 0x00RRGGBB framebuffer.
+template <class Geo>
+void particlesRender(const ParticlePool &pool, uint32_t *frame) {
+    for (uint16_t i = 0; i < pool.count; i++) {
+        if (pool.y[i] < 0) continue;  // above the top edge
+        uint16_t idx = Geo::index((uint8_t)(pool.x[i] >> 8), (uint8_t)(pool.y[i] >> 8));
+        frame[idx] = addColour(frame[idx], scaleColour(pool.colour[i], pool.life[i]));
+    }
+}
+
+#endif // PARTICLE_ENGINE_H
@@ -0,0 +1,93 @@
+#ifndef PIXEL_KERNELS_H
+#define PIXEL_KERNELS_H
+
+#include <Arduino.h>
+
+// ─── Packed-pixel kernels ──────────────────────────────────────────────────
+// SWAR (SIMD-within-a-register) helpers for 0x00RRGGBB words. Red and blue
+// sit 16 bits apart, so one 32-bit multiply scales both with room for the
+// 8-bit product in each lane; green gets the second multiply. No channel
+// unpacking and no per-channel branches.
+//
+// Effects keep a persistent framebuffer of these words and run the buffer
+// kernels on it, instead of reading pixels back from the strip (which is
+// lossy once setBrightness() is active).
+
+#define PK_RB_MASK  0x00FF00FFUL
+#define PK_G_MASK   0x0000FF00UL
+
+// Scale all channels by scale/256.
+static inline uint32_t scaleColour(uint32_t c, uint8_t scale) {
+    uint32_t rb = ((c & PK_RB_MASK) * scale >> 8) & PK_RB_MASK;
+    uint32_t g  = ((c & PK_G_MASK)  * scale >> 8) & PK_G_MASK;
+    return rb | g;
+}
+
+// Scale red/blue and green by separate factors (e.g. green-tinted trails).
+static inline uint32_t scaleColourRB_G(uint32_t c, uint8_t rbScale, uint8_t gScale) {
+    uint32_t rb = ((c & PK_RB_MASK) * rbScale >> 8) & PK_RB_MASK;
+    uint32_t g  = ((c & PK_G_MASK)  * gScale  >> 8) & PK_G_MASK;
+    return rb | g;
+}
+
+// Per-channel saturating add: each channel clamps at 255.
+static inline uint32_t addColour(uint32_t a, uint32_t b) {
+    uint32_t low   = (a & 0x7F7F7F) + (b & 0x7F7F7F);      // bits 0-6 per lane
+    uint32_t top   = (a ^ b) & 0x808080;                   // bit 7 half-sum
+    uint32_t carry = ((a & b) | (low & top)) & 0x808080;   // lane overflow
+    return ((low ^ top) | ((carry >> 7) * 0xFF)) & 0xFFFFFF;
+}
+
+// Linear blend: t = 0 → a, t = 256 → b. Both lanes of a multiply stay below
+// 255 * 256, so neither sum can spill into its neighbour.
+static inline uint32_t lerpColour(uint32_t a, uint32_t b, uint16_t t) {
+    uint16_t s = 256 - t;
+    uint32_t rb = ((a & PK_RB_MASK) * s + (b & PK_RB_MASK) * t) >> 8;
+    uint32_t g  = ((a & PK_G_MASK)  * s + (b & PK_G_MASK)  * t) >> 8;
+    return (rb & PK_RB_MASK) | (g & PK_G_MASK);
+}
+
+// Per-channel product (multiply blend): white leaves a unchanged, black
+// gives black. Lanes can't share a multiply here, so it's three.
+static inline uint32_t mulColour(uint32_t a, uint32_t b) {
+    uint32_t r  = (((a >> 16) & 0xFF) * (((b >> 16) & 0xFF) + 1)) >> 8;
+    uint32_t g  = (((a >> 8)  & 0xFF) * (((b >> 8)  & 0xFF) + 1)) >> 8;
+    uint32_t bl = ((a & 0xFF) * ((b & 0xFF) + 1)) >> 8;
+    return (r << 16) | (g << 8) | bl;
+}
+
+// HSV-like colour wheel: 0-255 maps to full hue rotation (R→G→B→R)
+static inline uint32_t colourWheel(uint8_t pos) {
+    pos = 255 - pos;
+    if (pos < 85) {
+        return ((uint32_t)(255 - pos * 3) << 16) | (pos * 3);
+    } else if (pos < 170) {
+        pos -= 85;
+        return ((uint32_t)(pos * 3) << 8) | (255 - pos * 3);
+    } else {
+        pos -= 170;
+        return ((uint32_t)(pos * 3) << 16) | ((uint32_t)(255 - pos * 3) << 8);
+    }
+}
+
+// ─── Buffer kernels ────────────────────────────────────────────────────────
+
+static inline void fadeFrame(uint32_t *buf, uint16_t n, uint8_t scale) {
+    for (uint16_t i = 0; i < n; i++) buf[i] = scaleColour(buf[i], scale);
+}
+
+static inline void fadeFrameRB_G(uint32_t *buf, uint16_t n,
+                                 uint8_t rbScale, uint8_t gScale) {
+    for (uint16_t i = 0; i < n; i++) buf[i] = scaleColourRB_G(buf[i], rbScale, gScale);
+}
+
+static inline void addFrame(uint32_t *dst, const uint32_t *src, uint16_t n) {
+    for (uint16_t i = 0; i < n; i++) dst[i] = addColour(dst[i], src[i]);
+}
+
+static inline void lerpFrame(uint32_t *dst, const uint32_t *a, const uint32_t *b,
+                             uint16_t n, uint16_t t) {
+    for (uint16_t i = 0; i < n; i++) dst[i] = lerpColour(a[i], b[i], t);
+}
+
+#endif // PIXEL_KERNELS_H
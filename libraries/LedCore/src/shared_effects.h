@@ -0,0 +1,733 @@
+#ifndef SHARED_EFFECTS_H
+#define SHARED_EFFECTS_H
+
+#include <Arduino.h>
+#include "fast_rng.h"
+#include "pixel_kernels.h"
+#include "particle_engine.h"
+#include "noise.h"
+
+// ─── Shared Effects ────────────────────────────────────────────────────────
+// The effects the LED Grid and LED Panel render identically: every size
+// and position comes from the geometry, so one copy runs on a 16x16 grid
+// and a 32x8 panel alike. Effects laid out for one device (clock faces,
+// tickers, bitmaps) and ones tuned per device stay in the sketches, which
+// can reuse the effect maths below.
+//
+// Render into anything with setPixelColor(uint16_t, uint32_t), fill(),
+// clear(), setPixels() and show() — the compositor's base layer canvas.
+
+// ─── Effect Maths ──────────────────────────────────────────────────────────
+
+// 256 entries, values -127..+127 (≈ sin(angle * 2π / 256) * 127)
+static const int8_t FX_SIN_TABLE[256] PROGMEM = {
+      0,   3,   6,   9,  12,  15,  18,  21,  24,  27,  30,  33,  36,  39,  42,  45,
+     48,  51,  54,  57,  59,  62,  65,  67,  70,  73,  75,  78,  80,  82,  85,  87,
+     89,  91,  94,  96,  98, 100, 102, 103, 105, 107, 108, 110, 112, 113, 114, 116,
+    117, 118, 119, 120, 121, 122, 123, 123, 124, 125, 125, 126, 126, 126, 126, 126,
+    127, 126, 126, 126, 126, 126, 125, 125, 124, 123, 123, 122, 121, 120, 119, 118,
+    117, 116, 114, 113, 112, 110, 108, 107, 105, 103, 102, 100,  98,  96,  94,  91,
+     89,  87,  85,  82,  80,  78,  75,  73,  70,  67,  65,  62,  59,  57,  54,  51,
+     48,  45,  42,  39,  36,  33,  30,  27,  24,  21,  18,  15,  12,   9,   6,   3,
+      0,  -3,  -6,  -9, -12, -15, -18, -21, -24, -27, -30, -33, -36, -39, -42, -45,
+    -48, -51, -54, -57, -59, -62, -65, -67, -70, -73, -75, -78, -80, -82, -85, -87,
+    -89, -91, -94, -96, -98,-100,-102,-103,-105,-107,-108,-110,-112,-113,-114,-116,
+   -117,-118,-119,-120,-121,-122,-123,-123,-124,-125,-125,-126,-126,-126,-126,-126,
+   -127,-126,-126,-126,-126,-126,-125,-125,-124,-123,-123,-122,-121,-120,-119,-118,
+   -117,-116,-114,-113,-112,-110,-108,-107,-105,-103,-102,-100, -98, -96, -94, -91,
+    -89, -87, -85, -82, -80, -78, -75, -73, -70, -67, -65, -62, -59, -57, -54, -51,
+    -48, -45, -42, -39, -36, -33, -30, -27, -24, -21, -18, -15, -12,  -9,  -6,  -3,
+};
+
+static inline int8_t fastSin(uint8_t angle) {
+    return (int8_t)pgm_read_byte(&FX_SIN_TABLE[angle]);
+}
+
+static inline int8_t fastCos(uint8_t angle) {
+    return fastSin(angle + 64);
+}
+
+// Maps heat value 0-255 to warm fire colours (black → red → orange → yellow → white)
+static inline uint32_t heatColour(uint8_t temperature) {
+    uint8_t r, g, b;
+    if (temperature < 85) {
+        // Black → Red
+        r = temperature * 3;
+        g = 0;
+        b = 0;
+    } else if (temperature < 170) {
+        // Red → Orange/Yellow
+        r = 255;
+        g = (temperature - 85) * 3;
+        b = 0;
+    } else {
+        // Yellow → White
+        r = 255;
+        g = 255;
+        b = (temperature - 170) * 3;
+    }
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
+
+// Integer atan2: angle 0-255 representing 0-2π
+static inline uint8_t fastAtan2(int8_t dy, int8_t dx) {
+    if (dx == 0 && dy == 0) return 0;
+    // Use simple octant-based approximation
+    uint8_t ax = abs(dx);
+    uint8_t ay = abs(dy);
+    // ratio ≈ min/max scaled to 0-64 range
+    uint8_t ratio;
+    if (ax >= ay) {
+        ratio = (ay == 0) ? 0 : (uint8_t)((uint16_t)ay * 32 / ax);
+    } else {
+        ratio = 64 - (uint8_t)((uint16_t)ax * 32 / ay);
+    }
+    // Map to full angle based on octant
+    if (dx >= 0 && dy >= 0) return ratio;               // Q1: 0-64
+    if (dx < 0  && dy >= 0) return 128 - ratio;          // Q2: 64-128
+    if (dx < 0  && dy < 0)  return 128 + ratio;          // Q3: 128-192
+    return 0 - ratio;                                     // Q4: 192-256 (wraps)
+}
+
+// Integer sqrt approximation. The estimate is 16-bit: from 511 up the first
+// step no longer fits a byte, and a byte that wrapped to 0 divided by zero.
+static inline uint8_t fastSqrt(uint16_t val) {
+    if (val == 0) return 0;
+    uint16_t result = 1;
+    // Newton's method, a few iterations
+    result = (result + val / result) >> 1;
+    result = (result + val / result) >> 1;
+    result = (result + val / result) >> 1;
+    return result > 255 ? 255 : (uint8_t)result;
+}
+
+#define FX_MAX_ROCKETS      4
+#define FX_SPARK_GRAVITY    (FP_ONE / 16)
+#define FX_SPARK_DRAG       6
+
+template <class Geo>
+class SharedEffects {
+public:
+    static const uint8_t  W = Geo::WIDTH;
+    static const uint8_t  H = Geo::HEIGHT;
+    static const uint16_t N = Geo::COUNT;
+
+    // Persistent 0x00RRGGBB frame in strip order for effects that fade their
+    // previous output (trails). The sketch's own effects may draw into it
+    // too; it is never read back from the strip.
+    uint32_t frame[N];
+
+    // Seed every effect's generator. Each effect owns its own, so one
+    // effect's draw count never shifts another's sequence.
+    void seed(uint32_t s) {
+        // Distinct odd salts keep the per-effect streams decorrelated
+        rainRng.seed(s ^ 0x9E3779B1);
+        candleRng.seed(s ^ 0xC2B2AE3D);
+        twinkleRng.seed(s ^ 0x27D4EB2F);
+        matrixRng.seed(s ^ 0x165667B1);
+        fireworksRng.seed(s ^ 0xD3A2646C);
+        lifeRng.seed(s ^ 0xFD7046C5);
+    }
+
+    // Call on an effect switch: trail effects start from black and the
+    // particle pool goes to whichever effect claims it next.
+    void restart() {
+        memset(frame, 0, sizeof(frame));
+        particleOwner = OWNER_NONE;
+    }
+
+    template <class Strip>
+    void showFrame(Strip &strip) {
+        strip.setPixels(frame);
+        strip.show();
+    }
+
+    // ─── Rainbows ──────────────────────────────────────────────────────────
+
+    // Rainbow wave — hue ripples across the grid horizontally
+    template <class Strip>
+    void rainbowWave(Strip &strip, uint32_t cycleMs) {
+        uint32_t ms = millis();
+        // Phase advances based on time; each column offset by hue
+        uint8_t baseHue = (uint8_t)((ms * 256UL / cycleMs) % 256);
+
+        for (uint8_t y = 0; y < H; y++) {
+            for (uint8_t x = 0; x < W; x++) {
+                // Spread 256 hue values across the grid width
+                uint8_t hue = baseHue + (x * 256 / W);
+                strip.setPixelColor(Geo::index(x, y), colourWheel(hue));
+            }
+        }
+        strip.show();
+    }
+
+    // Colour wash — entire grid is one solid colour, smoothly sweeping through hues
+    template <class Strip>
+    void colourWash(Strip &strip, uint32_t cycleMs) {
+        uint32_t ms = millis();
+        uint8_t hue = (uint8_t)((ms * 256UL / cycleMs) % 256);
+        uint32_t colour = colourWheel(hue);
+
+        strip.fill(colour);
+        strip.show();
+    }
+
+    // Diagonal rainbow — hue bands run along the diagonal (x + y)
+    template <class Strip>
+    void diagonalRainbow(Strip &strip, uint32_t cycleMs) {
+        uint32_t ms = millis();
+        uint8_t baseHue = (uint8_t)((ms * 256UL / cycleMs) % 256);
+
+        for (uint8_t y = 0; y < H; y++) {
+            for (uint8_t x = 0; x < W; x++) {
+                // Diagonal distance from top-left, mapped to hue
+                uint8_t diag = x + y;  // 0..(W + H - 2)
+                uint8_t hue = baseHue + (diag * 256 / (W + H));
+                strip.setPixelColor(Geo::index(x, y), colourWheel(hue));
+            }
+        }
+        strip.show();
+    }
+
+    // ─── Rain ──────────────────────────────────────────────────────────────
+    // Coloured drops fall down random columns at varying speeds.
+
+    template <class Strip>
+    void rain(Strip &strip) {
+        if (claimParticles(OWNER_RAIN, 0, 0)) {
+            drops = ParticleEmitter();
+            drops.xSpread   = W * FP_ONE;             // any column
+            drops.vy        = FP_ONE / 6;             // 6 frames per row ...
+            drops.vySpread  = FP_ONE / 2 - FP_ONE / 6;  // ... up to 2
+            drops.life      = 255;
+            drops.decay     = 0;                      // live until off the bottom
+            drops.rate      = (FP_ONE / 3) * W / H;   // ~one per column in flight
+            drops.randomHue = true;
+        }
+
+        // Fade all pixels by ~20% (trail effect)
+        fadeFrame(frame, N, 200);
+
+        particlesEmit(particles, drops, rainRng);
+        particlesUpdate<Geo>(particles);
+        particlesRender<Geo>(particles, frame);
+        showFrame(strip);
+    }
+
+    // ─── Lava Lamp ─────────────────────────────────────────────────────────
+    // Slow-moving coloured blobs (metaballs).
+
+    template <class Strip>
+    void lava(Strip &strip) {
+        uint32_t ms = millis();
+
+        // 3 blob centres drifting on slow sine paths
+        struct Blob {
+            int16_t cx, cy;
+            uint8_t hue;
+        };
+
+        Blob blobs[3];
+        // Blob 0: slow drift — range covers most of the grid
+        blobs[0].cx = 128 + (int16_t)fastSin((uint8_t)(ms / 50)) * 80 / 127;
+        blobs[0].cy = 128 + (int16_t)fastCos((uint8_t)(ms / 70)) * 80 / 127;
+        blobs[0].hue = (uint8_t)(ms / 100);
+
+        // Blob 1: medium drift
+        blobs[1].cx = 128 + (int16_t)fastSin((uint8_t)(ms / 40 + 85)) * 80 / 127;
+        blobs[1].cy = 128 + (int16_t)fastCos((uint8_t)(ms / 55 + 85)) * 80 / 127;
+        blobs[1].hue = (uint8_t)(ms / 100 + 85);
+
+        // Blob 2: faster drift
+        blobs[2].cx = 128 + (int16_t)fastSin((uint8_t)(ms / 35 + 170)) * 80 / 127;
+        blobs[2].cy = 128 + (int16_t)fastCos((uint8_t)(ms / 45 + 170)) * 80 / 127;
+        blobs[2].hue = (uint8_t)(ms / 100 + 170);
+
+        for (uint8_t y = 0; y < H; y++) {
+            for (uint8_t x = 0; x < W; x++) {
+                int16_t px = x * (256 / W) + 128 / W;
+                int16_t py = y * (256 / H) + 128 / H;
+
+                // Sum of inverse distances to blob centres
+                uint16_t energy = 0;
+                uint16_t hueSum = 0;
+                uint16_t weightSum = 0;
+
+                for (uint8_t i = 0; i < 3; i++) {
+                    int16_t dx = px - blobs[i].cx;
+                    int16_t dy = py - blobs[i].cy;
+                    uint16_t distSq = (uint16_t)(dx * dx + dy * dy);
+                    if (distSq < 4) distSq = 4;
+                    uint16_t inv = 10000 / distSq;
+                    energy += inv;
+                    hueSum += (uint16_t)blobs[i].hue * inv;
+                    weightSum += inv;
+                }
+
+                // Threshold for blob edge
+                uint8_t bright;
+                if (energy > 80) bright = 255;
+                else if (energy > 40) bright = (uint8_t)((energy - 40) * 255 / 40);
+                else bright = 0;
+
+                if (bright > 0 && weightSum > 0) {
+                    uint8_t hue = (uint8_t)(hueSum / weightSum);
+                    strip.setPixelColor(Geo::index(x, y), scaleColour(colourWheel(hue), bright));
+                } else {
+                    strip.setPixelColor(Geo::index(x, y), 0);
+                }
+            }
+        }
+        strip.show();
+    }
+
+    // ─── Candle ────────────────────────────────────────────────────────────
+    // Warm flickering candlelight — brighter in the centre, random fluctuations.
+
+    template <class Strip>
+    void candle(Strip &strip) {
+        if (!candleLit) {
+            for (uint8_t x = 0; x < W; x++) candleFlicker[x] = 128;
+            candleLit = true;
+        }
+
+        // Update flicker per column — smooth random walk
+        for (uint8_t x = 0; x < W; x++) {
+            int16_t delta = (int16_t)candleRng.below(40) - 20;
+            int16_t nv = (int16_t)candleFlicker[x] + delta;
+            // Bias toward centre (128)
+            nv = (nv * 3 + 128) / 4;
+            if (nv < 60) nv = 60;
+            if (nv > 220) nv = 220;
+            candleFlicker[x] = (uint8_t)nv;
+        }
+
+        // Centre of grid
+        float cx = (W - 1) * 0.5f;
+        float cy = (H - 1) * 0.5f;
+        float maxDist = sqrtf(cx * cx + cy * cy);  // Corner distance
+
+        for (uint8_t y = 0; y < H; y++) {
+            for (uint8_t x = 0; x < W; x++) {
+                // Distance from centre, normalised 0-255
+                float dx = (float)x - cx;
+                float dy = (float)y - cy;
+                float dist = sqrtf(dx * dx + dy * dy);
+                uint8_t distBright = (dist < maxDist) ? (uint8_t)(255 - dist * 255 / maxDist) : 0;
+
+                // Combine distance and flicker
+                uint8_t bright = (uint8_t)((uint16_t)distBright * candleFlicker[x] >> 8);
+
+                // Warm amber palette: R=255, G=100, B=20, scaled by brightness
+                uint8_t r = (uint8_t)((uint16_t)255 * bright >> 8);
+                uint8_t g = (uint8_t)((uint16_t)100 * bright >> 8);
+                uint8_t b = (uint8_t)((uint16_t)20 * bright >> 8);
+
+                strip.setPixelColor(Geo::index(x, y), ((uint32_t)r << 16) | ((uint32_t)g << 8) | b);
+            }
+        }
+        strip.show();
+    }
+
+    // ─── Spiral ────────────────────────────────────────────────────────────
+    // Rotating colour pinwheel from the centre.
+
+    template <class Strip>
+    void spiral(Strip &strip) {
+        uint32_t ms = millis();
+        uint8_t timeSpin = (uint8_t)(ms / 20);  // Rotation speed
+
+        for (uint8_t y = 0; y < H; y++) {
+            for (uint8_t x = 0; x < W; x++) {
+                int8_t dx = (int8_t)x - W / 2;
+                int8_t dy = (int8_t)y - H / 2;
+
+                // Angle from centre (0-255)
+                uint8_t angle = fastAtan2(dy, dx);
+
+                // Distance from centre
+                uint8_t dist = fastSqrt((uint16_t)(dx * dx + dy * dy) * 16);
+
+                // 4 spiral arms, tightness controlled by dist multiplier
+                uint8_t hue = angle * 4 + dist * 3 + timeSpin;
+
+                strip.setPixelColor(Geo::index(x, y), colourWheel(hue));
+            }
+        }
+        strip.show();
+    }
+
+    // ─── Noise-field Fire, Aurora, Lava and Candle ─────────────────────────
+    // Driven by gradient noise instead of layered sines and random walks.
+    // Time is the third noise axis, so the motion never visibly repeats and
+    // has no per-cell state. The noise field wraps every 65536 units, so the
+    // uint16_t time coordinates roll over seamlessly. Spatial scales are per
+    // pixel, so the grid and panel see the same texture.
+
+    template <class Strip>
+    void fireNoise(Strip &strip) {
+        uint32_t ms = millis();
+        uint16_t rise  = (uint16_t)(ms / 3);   // texture scrolls up — flames climb
+        uint16_t churn = (uint16_t)(ms / 6);   // and evolves as it goes
+
+        for (uint8_t y = 0; y < H; y++) {
+            // Heat budget: full on the bottom row, gone by the top
+            uint8_t base = (uint8_t)((uint16_t)(y + 1) * 255 / H);
+            for (uint8_t x = 0; x < W; x++) {
+                uint8_t n = fractalNoise3(x * 64, y * 64 + rise, churn, 3);
+                int16_t heat = (int16_t)((uint16_t)n * base >> 7) - 64;
+                strip.setPixelColor(Geo::index(x, y), heatColour((uint8_t)constrain(heat, 0, 255)));
+            }
+        }
+        strip.show();
+    }
+
+    template <class Strip>
+    void auroraNoise(Strip &strip) {
+        uint32_t ms = millis();
+        uint16_t t = (uint16_t)(ms / 8);
+
+        // Curtain centre per column (0-255 vertical), wandering over time
+        int16_t centre[W];
+        for (uint8_t x = 0; x < W; x++) {
+            centre[x] = 128 + (int16_t)noise2(x * 40, t) * 2;
+        }
+
+        for (uint8_t y = 0; y < H; y++) {
+            int16_t vy = (int16_t)y * (256 / H) + (128 / H);
+            for (uint8_t x = 0; x < W; x++) {
+                int16_t bandDist = abs(vy - centre[x]);
+                if (bandDist >= 64) {
+                    strip.setPixelColor(Geo::index(x, y), 0);
+                    continue;
+                }
+
+                // Fine vertical rays shimmer through the curtain
+                uint8_t rays = fractalNoise3(x * 96, y * 24, t * 2, 2);
+                uint16_t bright = (uint16_t)(255 - bandDist * 4) * rays >> 7;
+                if (bright > 255) bright = 255;
+
+                // Same green/blue/purple palette as the sine version
+                uint8_t hueBase = (uint8_t)(noise3(x * 24, y * 24, t / 2) + (uint8_t)(ms / 40));
+                uint8_t r = (uint8_t)(bright * (uint16_t)(fastSin(hueBase + 170) + 128) >> 9);
+                uint8_t g = (uint8_t)(bright * (uint16_t)(fastSin(hueBase + 64) + 128) >> 8);
+                uint8_t b = (uint8_t)(bright * (uint16_t)(fastSin(hueBase) + 128) >> 8);
+
+                strip.setPixelColor(Geo::index(x, y), ((uint32_t)r << 16) | ((uint32_t)g << 8) | b);
+            }
+        }
+        strip.show();
+    }
+
+    template <class Strip>
+    void lavaNoise(Strip &strip) {
+        uint32_t ms = millis();
+        uint16_t t = (uint16_t)(ms / 12);
+        uint8_t hueDrift = (uint8_t)(ms / 100);
+
+        for (uint8_t y = 0; y < H; y++) {
+            for (uint8_t x = 0; x < W; x++) {
+                uint8_t n = fractalNoise3(x * 40, y * 40, t, 2);
+
+                // Threshold the field into blobs with a soft edge
+                uint8_t bright;
+                if (n >= 150) bright = 255;
+                else if (n > 118) bright = (uint8_t)((n - 118) * 8);
+                else bright = 0;
+
+                uint32_t c = bright ? scaleColour(colourWheel(hueDrift + (n >> 1)), bright) : 0;
+                strip.setPixelColor(Geo::index(x, y), c);
+            }
+        }
+        strip.show();
+    }
+
+    template <class Strip>
+    void candleNoise(Strip &strip) {
+        uint32_t ms = millis();
+        uint16_t t = (uint16_t)(ms / 2);
+
+        // Distances in half-pixel units from the grid centre
+        const uint16_t maxDistSq = (W - 1) * (W - 1) + (H - 1) * (H - 1);
+
+        // Flicker per column: a noise curve replaces the random walk
+        uint8_t flicker[W];
+        for (uint8_t x = 0; x < W; x++) {
+            flicker[x] = 60 + (uint8_t)((uint16_t)fractalNoise2(x * 48, t, 2) * 160 >> 8);
+        }
+
+        for (uint8_t y = 0; y < H; y++) {
+            int16_t dy = 2 * y - (H - 1);
+            for (uint8_t x = 0; x < W; x++) {
+                int16_t dx = 2 * x - (W - 1);
+                uint16_t distSq = (uint16_t)(dx * dx + dy * dy);
+                uint8_t distBright = (uint8_t)(255 - (uint32_t)distSq * 255 / maxDistSq);
+                uint8_t bright = (uint8_t)((uint16_t)distBright * flicker[x] >> 8);
+
+                // Warm amber palette: R=255, G=100, B=20, scaled by brightness
+                strip.setPixelColor(Geo::index(x, y), scaleColour(0xFF6414, bright));
+            }
+        }
+        strip.show();
+    }
+
+    // ─── Twinkle Stars ─────────────────────────────────────────────────────
+    // Random pixels light up and fade out like a starfield.
+
+    template <class Strip>
+    void twinkle(Strip &strip) {
+        // Fade all stars
+        for (uint16_t i = 0; i < N; i++) {
+            if (starBright[i] > 4) starBright[i] -= 4;
+            else starBright[i] = 0;
+        }
+
+        // Spawn 1-2 new stars per frame
+        uint8_t toSpawn = 1 + twinkleRng.below(2);
+        for (uint8_t s = 0; s < toSpawn; s++) {
+            uint16_t idx = twinkleRng.below(N);
+            if (starBright[idx] == 0) {
+                starBright[idx] = 200 + twinkleRng.below(56);
+                starHue[idx] = twinkleRng.next8();
+            }
+        }
+
+        // Render
+        for (uint16_t i = 0; i < N; i++) {
+            if (starBright[i] > 0) {
+                strip.setPixelColor(i, scaleColour(colourWheel(starHue[i]), starBright[i]));
+            } else {
+                strip.setPixelColor(i, 0);
+            }
+        }
+        strip.show();
+    }
+
+    // ─── Matrix ────────────────────────────────────────────────────────────
+    // Green falling code streams (The Matrix).
+
+    template <class Strip>
+    void matrix(Strip &strip) {
+        if (claimParticles(OWNER_MATRIX, 0, 0)) {
+            heads = ParticleEmitter();
+            heads.xSpread  = W * FP_ONE;
+            heads.vy       = FP_ONE / 4;             // 4 frames per row ...
+            heads.vySpread = FP_ONE - FP_ONE / 4;    // ... up to 1
+            heads.life     = 255;
+            heads.decay    = 0;
+            heads.rate     = (FP_ONE * 5 / 8) * W / H;
+            heads.colour   = 0xC8FFC8;               // white-green
+        }
+
+        // Fade all pixels — green channel fades slower for trail effect
+        fadeFrameRB_G(frame, N, 140, 200);
+
+        particlesEmit(particles, heads, matrixRng);
+        particlesUpdate<Geo>(particles);
+        particlesRender<Geo>(particles, frame);
+        showFrame(strip);
+    }
+
+    // ─── Fireworks ─────────────────────────────────────────────────────────
+    // Rockets launch upward then explode into sparks; several bursts can be
+    // in the air at once, all sharing the particle pool.
+
+    template <class Strip>
+    void fireworks(Strip &strip) {
+        uint32_t now = millis();
+
+        if (claimParticles(OWNER_FIREWORKS, FX_SPARK_GRAVITY, FX_SPARK_DRAG)) {
+            for (uint8_t r = 0; r < FX_MAX_ROCKETS; r++) rockets[r].active = false;
+            nextLaunchMs = now;
+        }
+
+        // Fade everything
+        fadeFrame(frame, N, 180);
+
+        // Launch a new rocket into a free slot
+        if ((int32_t)(now - nextLaunchMs) >= 0) {
+            for (uint8_t r = 0; r < FX_MAX_ROCKETS; r++) {
+                if (rockets[r].active) continue;
+                rockets[r].x      = (int16_t)(3 + fireworksRng.below(W - 6)) * FP_ONE;
+                rockets[r].y      = (int16_t)(H - 1) * FP_ONE;
+                rockets[r].burstY = (int16_t)(H / 5 + fireworksRng.below(H / 4)) * FP_ONE;
+                rockets[r].hue    = fireworksRng.next8();
+                rockets[r].active = true;
+                break;
+            }
+            nextLaunchMs = now + 300 + fireworksRng.below(900);
+        }
+
+        for (uint8_t r = 0; r < FX_MAX_ROCKETS; r++) {
+            Rocket &rk = rockets[r];
+            if (!rk.active) continue;
+
+            rk.y -= FP_ONE;  // one row per frame
+            if (rk.y > rk.burstY) {
+                frame[Geo::index((uint8_t)(rk.x >> 8), (uint8_t)(rk.y >> 8))] = 0xFFFFDC;
+                continue;
+            }
+
+            // Explode into a ring of sparks with a little speed variation
+            uint8_t numSparks = 24 + fireworksRng.below(16);
+            for (uint8_t p = 0; p < numSparks; p++) {
+                uint8_t angle = p * 256 / numSparks + fireworksRng.below(10);
+                int16_t speed = FP_ONE / 4 + fireworksRng.below(FP_ONE / 4);
+                particleSpawn(particles, rk.x + FP_ONE / 2, rk.y + FP_ONE / 2,
+                              (int16_t)(fastCos(angle) * speed / 128),
+                              (int16_t)(fastSin(angle) * speed / 128),
+                              colourWheel(rk.hue + fireworksRng.below(32)),
+                              255, 5 + fireworksRng.below(4));
+            }
+            rk.active = false;
+        }
+
+        particlesUpdate<Geo>(particles);
+        particlesRender<Geo>(particles, frame);
+        showFrame(strip);
+    }
+
+    // ─── Game of Life ──────────────────────────────────────────────────────
+    // Conway's Game of Life with colour — auto-reseeds on stagnation.
+
+    template <class Strip>
+    void life(Strip &strip) {
+        if (!lifeSeeded) {
+            memset(lifeGrid, 0, sizeof(lifeGrid));
+            lifeSeed();
+            lifeSeeded = true;
+        }
+
+        uint32_t now = millis();
+        if (now - lifeLastMs >= 150) {
+            lifeLastMs = now;
+
+            uint8_t next = 1 - lifeCurrent;
+            uint16_t population = 0;
+
+            for (uint8_t y = 0; y < H; y++) {
+                for (uint8_t x = 0; x < W; x++) {
+                    // Count neighbours (wrapping)
+                    uint8_t neighbours = 0;
+                    for (int8_t dy = -1; dy <= 1; dy++) {
+                        for (int8_t dx = -1; dx <= 1; dx++) {
+                            if (dx == 0 && dy == 0) continue;
+                            uint8_t nx = (x + dx + W) % W;
+                            uint8_t ny = (y + dy + H) % H;
+                            if (lifeGrid[lifeCurrent][ny][nx]) neighbours++;
+                        }
+                    }
+
+                    bool alive = lifeGrid[lifeCurrent][y][x];
+                    if (alive) {
+                        lifeGrid[next][y][x] = (neighbours == 2 || neighbours == 3);
+                    } else {
+                        lifeGrid[next][y][x] = (neighbours == 3);
+                    }
+
+                    if (lifeGrid[next][y][x]) {
+                        population++;
+                        // Shift hue slightly each generation
+                        if (!alive) lifeHue[y][x] = lifeRng.next8();  // Newborn
+                        else lifeHue[y][x] += 2;
+                    }
+                }
+            }
+
+            lifeCurrent = next;
+
+            // Detect stagnation (population stable or zero)
+            lifePop[lifePopIdx] = population;
+            lifePopIdx = (lifePopIdx + 1) % 3;
+            if (population == 0 ||
+                (lifePop[0] == lifePop[1] && lifePop[1] == lifePop[2])) {
+                lifeSeed();
+            }
+        }
+
+        // Render current state
+        strip.clear();
+        for (uint8_t y = 0; y < H; y++) {
+            for (uint8_t x = 0; x < W; x++) {
+                if (lifeGrid[lifeCurrent][y][x]) {
+                    strip.setPixelColor(Geo::index(x, y), colourWheel(lifeHue[y][x]));
+                }
+            }
+        }
+        strip.show();
+    }
+
+private:
+    FastRng rainRng;
+    FastRng candleRng;
+    FastRng twinkleRng;
+    FastRng matrixRng;
+    FastRng fireworksRng;
+    FastRng lifeRng;
+
+    // ─── Shared Particle Pool ──────────────────────────────────────────────
+    // One pool serves whichever particle effect is running (Rain, Matrix,
+    // Fireworks) — only one effect renders at a time.
+
+    enum ParticleOwner : uint8_t {
+        OWNER_NONE,
+        OWNER_RAIN,
+        OWNER_MATRIX,
+        OWNER_FIREWORKS,
+    };
+
+    ParticlePool    particles;
+    ParticleOwner   particleOwner = OWNER_NONE;
+    ParticleEmitter drops;
+    ParticleEmitter heads;
+
+    // Hand the pool to an effect. Returns true on its first frame after a switch.
+    bool claimParticles(ParticleOwner owner, int16_t gravity, uint8_t drag) {
+        if (particleOwner == owner) return false;
+        particleOwner = owner;
+        particlesReset(particles, gravity, drag);
+        return true;
+    }
+
+    // ─── Fireworks ─────────────────────────────────────────────────────────
+
+    struct Rocket {
+        int16_t x, y;        // 8.8
+        int16_t burstY;      // explode at or above this row (8.8)
+        uint8_t hue;
+        bool    active;
+    };
+    Rocket   rockets[FX_MAX_ROCKETS];
+    uint32_t nextLaunchMs;
+
+    // ─── Candle ────────────────────────────────────────────────────────────
+
+    uint8_t candleFlicker[W];
+    bool    candleLit = false;
+
+    // ─── Twinkle ───────────────────────────────────────────────────────────
+
+    uint8_t starBright[N] = {0};
+    uint8_t starHue[N]    = {0};
+
+    // ─── Life ──────────────────────────────────────────────────────────────
+
+    bool     lifeGrid[2][H][W];
+    uint8_t  lifeHue[H][W];
+    uint8_t  lifeCurrent = 0;
+    uint32_t lifeLastMs  = 0;
+    uint16_t lifePop[3]  = {0, 0, 0};
+    uint8_t  lifePopIdx  = 0;
+    bool     lifeSeeded  = false;
+
+    void lifeSeed() {
+        for (uint8_t y = 0; y < H; y++) {
+            for (uint8_t x = 0; x < W; x++) {
+                lifeGrid[lifeCurrent][y][x] = lifeRng.chance(35);
+                lifeHue[y][x] = lifeRng.next8();
+            }
+        }
+    }
+};
+
+#endif // SHARED_EFFECTS_H
@@ -0,0 +1,44 @@
+#ifndef SINE16_H
+#define SINE16_H
+
+#include <stdint.h>
+
+// ─── 16-bit Sine ───────────────────────────────────────────────────────────
+// Integer sine for effects that would otherwise call sinf() per LED: on an
+// ESP32-C3 (no FPU) every float operation is a soft-float library call.
+// Angles are uint16_t, 65536 to the turn, so a phase is just
+// (t % period) * 65536 / period and wraps for free. A 65-entry quarter-wave
+// table (130 bytes of flash) is mirrored into the other three quadrants and
+// interpolated linearly; the result is within 4 of round(sin * 32767),
+// about 0.01% of full scale.
+
+// sin(angle) in Q15: -32767 .. 32767.
+inline int16_t sin16(uint16_t angle) {
+    static const int16_t QUARTER[65] = {
+            0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+         6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+        12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+        18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+        23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+        27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+        30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+        32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+        32767,
+    };
+    uint16_t x = angle & 0x3FFF;                // position within the quadrant
+    if (angle & 0x4000) x = 0x4000 - x;         // 2nd and 4th quadrants fall
+    uint8_t i    = x >> 8;
+    uint8_t frac = x & 0xFF;
+
+    int32_t v = QUARTER[i];
+    if (frac) v += ((QUARTER[i + 1] - v) * frac) >> 8;
+    return (angle & 0x8000) ? -v : v;
+}
+
+// (sin(angle) + 1) / 2 as a 0 .. 65534 fraction of 65536, the usual
+// "0 → 1 → 0" pulse.
+inline uint16_t wave16(uint16_t angle) {
+    return (uint16_t)(sin16(angle) + 32767);
+}
+
+#endif // SINE16_H
@@ -0,0 +1,368 @@
+#ifndef SNAKE_ENGINE_H
+#define SNAKE_ENGINE_H
+
+#include <Arduino.h>
+#include "led_geometry.h"
+#include "fast_rng.h"
+
+// ─── Snake Engine ──────────────────────────────────────────────────────────
+// Snake with a greedy flood-fill AI (or phone control) on any LedGeometry.
+// Collision checks use one RowBits mask per row, so a 32-wide panel gets
+// 32-bit rows and a 16x16 grid 16-bit rows. The body is a ring buffer the
+// size of the grid, and the snake starts centred on whatever grid it has.
+//
+// Render into anything with fill(), clear(), setPixelColor() and show().
+
+#define SNAKE_DIR_UP    0
+#define SNAKE_DIR_RIGHT 1
+#define SNAKE_DIR_DOWN  2
+#define SNAKE_DIR_LEFT  3
+
+static const int8_t SNAKE_DX[4] = {0, 1, 0, -1};
+static const int8_t SNAKE_DY[4] = {-1, 0, 1, 0};
+
+template <class Geo>
+class SnakeEngine {
+public:
+    static const uint8_t  W = Geo::WIDTH;
+    static const uint8_t  H = Geo::HEIGHT;
+    static const uint16_t MAX_LEN = Geo::COUNT;
+    typedef typename Geo::RowBits RowBits;
+
+    void reset() {
+        headIdx = 2;
+        snakeLen = 3;
+        direction = SNAKE_DIR_RIGHT;
+        nextDirection = SNAKE_DIR_RIGHT;
+        snakeScore = 0;
+        gameOver = false;
+        lastMoveMs = millis();
+
+        // Start in the middle, heading right
+        bodyX[0] = W / 2 - 2; bodyY[0] = H / 2;  // tail
+        bodyX[1] = W / 2 - 1; bodyY[1] = H / 2;  // mid
+        bodyX[2] = W / 2;     bodyY[2] = H / 2;  // head
+
+        rebuildOccupied();
+        placeFood();
+    }
+
+    void seed(uint32_t s) { rng.seed(s); }
+
+    void setBackground(uint8_t r, uint8_t g, uint8_t b) {
+        bgColour = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+    }
+
+    // ─── Manual Control ────────────────────────────────────────────────────
+    // Direction: 0=up, 1=right, 2=down, 3=left
+
+    void setManualMode(bool enabled) { manualMode = enabled; }
+    bool isManualMode() const { return manualMode; }
+
+    void setDirection(uint8_t dir) {
+        if (dir > 3) return;
+        // Can't reverse direction
+        if ((dir + 2) % 4 == direction) return;
+        nextDirection = dir;
+    }
+
+    // ─── State Query ───────────────────────────────────────────────────────
+    // gridOut is W * H colours, row-major in logical coordinates.
+
+    void getState(uint32_t *gridOut, uint16_t &outScore, uint16_t &outLength,
+                  bool &over) const {
+        memset(gridOut, 0, sizeof(uint32_t) * W * H);
+
+        if (!gameOver) {
+            for (uint16_t i = 0; i < snakeLen; i++) {
+                uint16_t idx = ringIndex(i);
+                gridOut[bodyY[idx] * W + bodyX[idx]] =
+                    i == 0 ? 0x00C8FFC8 : bodyColour(i);  // white-green head
+            }
+            gridOut[foodY * W + foodX] = 0x00E00000;  // red
+        }
+
+        outScore = snakeScore;
+        outLength = snakeLen;
+        over = gameOver;
+    }
+
+    // ─── Frame ─────────────────────────────────────────────────────────────
+
+    template <class Strip>
+    void update(Strip &strip) {
+        uint32_t now = millis();
+
+        // Handle game over — flash snake in red, restart after 3s
+        if (gameOver) {
+            bool flash = ((now - gameOverMs) / 300) % 2 == 0;
+            strip.clear();
+            if (!flash) {
+                for (uint16_t i = 0; i < snakeLen; i++) {
+                    uint16_t idx = ringIndex(i);
+                    strip.setPixelColor(Geo::index(bodyX[idx], bodyY[idx]), 0xB40000);
+                }
+            }
+            strip.show();
+
+            if (now - gameOverMs > 3000) {
+                reset();
+            }
+            return;
+        }
+
+        // Move at the appropriate interval
+        if (now - lastMoveMs >= moveInterval()) {
+            lastMoveMs = now;
+            if (!step(now)) return;
+        }
+
+        // ── Render ──
+        strip.fill(bgColour);
+
+        // Head bright white-green, body gradient green → dark teal
+        for (uint16_t i = 0; i < snakeLen; i++) {
+            uint16_t idx = ringIndex(i);
+            strip.setPixelColor(Geo::index(bodyX[idx], bodyY[idx]),
+                                i == 0 ? 0xC8FFC8 : bodyColour(i));
+        }
+
+        // Draw food — pulsing red
+        uint16_t phase = (now / 4) & 0xFF;
+        uint8_t wave = (phase < 128) ? (uint8_t)(phase * 2) :
+                                       (uint8_t)((255 - phase) * 2);
+        uint8_t foodBright = 140 + (uint8_t)((uint16_t)wave * 115 / 255);
+        strip.setPixelColor(Geo::index(foodX, foodY), (uint32_t)foodBright << 16);
+
+        strip.show();
+    }
+
+private:
+    uint8_t  bodyX[MAX_LEN];
+    uint8_t  bodyY[MAX_LEN];
+    uint16_t headIdx = 0;
+    uint16_t snakeLen = 3;
+    uint8_t  direction = SNAKE_DIR_RIGHT;
+    uint8_t  nextDirection = SNAKE_DIR_RIGHT;
+
+    uint8_t  foodX = 0;
+    uint8_t  foodY = 0;
+
+    uint16_t snakeScore = 0;
+    bool     gameOver = false;
+    uint32_t lastMoveMs = 0;
+    uint32_t gameOverMs = 0;
+    bool     manualMode = false;
+
+    // Occupied grid — one bit per cell for fast collision detection
+    RowBits  occupied[H];
+
+    FastRng  rng;
+    uint32_t bgColour = 0;
+
+    // Ring position of the i-th segment back from the head.
+    uint16_t ringIndex(uint16_t i) const {
+        return (headIdx - i + MAX_LEN) % MAX_LEN;
+    }
+
+    // Body gradient: bright green (near head) → dark teal (tail)
+    uint32_t bodyColour(uint16_t i) const {
+        uint8_t frac = (snakeLen > 1) ?
+            (uint8_t)((uint32_t)i * 255 / (snakeLen - 1)) : 0;
+        uint8_t g = 255 - (uint8_t)((uint16_t)frac * 175 / 255);  // 255→80
+        uint8_t b = (uint8_t)((uint16_t)frac * 80 / 255);          // 0→80
+        return ((uint32_t)g << 8) | b;
+    }
+
+    // ─── Occupied Grid ─────────────────────────────────────────────────────
+
+    void rebuildOccupied() {
+        memset(occupied, 0, sizeof(occupied));
+        for (uint16_t i = 0; i < snakeLen; i++) {
+            uint16_t idx = ringIndex(i);
+            occupied[bodyY[idx]] |= (RowBits)1 << bodyX[idx];
+        }
+    }
+
+    bool isOccupied(uint8_t x, uint8_t y) const {
+        if (x >= W || y >= H) return true;
+        return (occupied[y] >> x) & 1;
+    }
+
+    // ─── Food Placement ────────────────────────────────────────────────────
+
+    void placeFood() {
+        uint16_t empty = MAX_LEN - snakeLen;
+        if (empty == 0) {
+            // Snake fills entire grid — victory!
+            gameOver = true;
+            gameOverMs = millis();
+            return;
+        }
+        // Pick a random empty cell
+        uint16_t target = rng.below(empty);
+        uint16_t count = 0;
+        for (uint8_t y = 0; y < H; y++) {
+            for (uint8_t x = 0; x < W; x++) {
+                if (!isOccupied(x, y)) {
+                    if (count == target) {
+                        foodX = x;
+                        foodY = y;
+                        return;
+                    }
+                    count++;
+                }
+            }
+        }
+    }
+
+    // ─── AI: Flood-Fill Safety Check ───────────────────────────────────────
+    // BFS from (sx, sy) counting reachable empty cells.
+
+    uint16_t floodCount(uint8_t sx, uint8_t sy) const {
+        if (sx >= W || sy >= H) return 0;
+        if (isOccupied(sx, sy)) return 0;
+
+        // BFS queue (one entry per cell at most)
+        static uint8_t qx[MAX_LEN], qy[MAX_LEN];
+        RowBits visited[H];
+        memcpy(visited, occupied, sizeof(occupied));
+
+        uint16_t qHead = 0, qTail = 0;
+        qx[qTail] = sx; qy[qTail] = sy; qTail++;
+        visited[sy] |= (RowBits)1 << sx;
+        uint16_t count = 0;
+
+        while (qHead < qTail) {
+            uint8_t cx = qx[qHead]; uint8_t cy = qy[qHead]; qHead++;
+            count++;
+
+            for (uint8_t d = 0; d < 4; d++) {
+                int8_t nx = (int8_t)cx + SNAKE_DX[d];
+                int8_t ny = (int8_t)cy + SNAKE_DY[d];
+                if (nx < 0 || nx >= W || ny < 0 || ny >= H) continue;
+                RowBits bit = (RowBits)1 << nx;
+                if (visited[ny] & bit) continue;
+                visited[ny] |= bit;
+                qx[qTail] = (uint8_t)nx; qy[qTail] = (uint8_t)ny; qTail++;
+            }
+        }
+        return count;
+    }
+
+    // ─── AI: Direction Choice ──────────────────────────────────────────────
+    // Greedy toward food, with flood-fill to avoid trapping itself.
+
+    uint8_t aiChoose() {
+        uint8_t hx = bodyX[headIdx];
+        uint8_t hy = bodyY[headIdx];
+
+        // Temporarily clear the tail from occupied (it will move away this step)
+        uint16_t tailIdx = ringIndex(snakeLen - 1);
+        RowBits tailBit = (RowBits)1 << bodyX[tailIdx];
+        uint8_t tailY = bodyY[tailIdx];
+        occupied[tailY] &= ~tailBit;
+
+        int16_t bestScore = -9999;
+        uint8_t bestDir = direction;
+
+        for (uint8_t d = 0; d < 4; d++) {
+            // Can't reverse
+            if ((d + 2) % 4 == direction) continue;
+
+            int8_t nx = (int8_t)hx + SNAKE_DX[d];
+            int8_t ny = (int8_t)hy + SNAKE_DY[d];
+
+            // Wall check
+            if (nx < 0 || nx >= W || ny < 0 || ny >= H) continue;
+
+            // Body check (tail already removed from occupied)
+            if (isOccupied((uint8_t)nx, (uint8_t)ny)) continue;
+
+            int16_t dirScore = 0;
+
+            // Manhattan distance to food (prefer closer)
+            int16_t dist = abs((int16_t)nx - (int16_t)foodX) +
+                           abs((int16_t)ny - (int16_t)foodY);
+            dirScore -= dist * 10;
+
+            // Flood-fill: prefer directions with more reachable space
+            uint16_t reachable = floodCount((uint8_t)nx, (uint8_t)ny);
+
+            if (reachable < snakeLen) {
+                // Might trap ourselves — heavy penalty
+                dirScore -= 5000;
+            } else {
+                dirScore += (int16_t)(reachable / 4);
+            }
+
+            // Slight bias for continuing straight
+            if (d == direction) dirScore += 5;
+
+            if (dirScore > bestScore) {
+                bestScore = dirScore;
+                bestDir = d;
+            }
+        }
+
+        // Restore tail in occupied grid
+        occupied[tailY] |= tailBit;
+
+        return bestDir;
+    }
+
+    // Start at 280ms, decrease by 6ms per food eaten, min 80ms
+    uint16_t moveInterval() const {
+        int16_t interval = 280 - (int16_t)snakeScore * 6;
+        if (interval < 80) interval = 80;
+        return (uint16_t)interval;
+    }
+
+    // Advance one cell. Returns false when the move ended the game.
+    bool step(uint32_t now) {
+        if (!manualMode) {
+            nextDirection = aiChoose();
+        }
+        direction = nextDirection;
+
+        int8_t newX = (int8_t)bodyX[headIdx] + SNAKE_DX[direction];
+        int8_t newY = (int8_t)bodyY[headIdx] + SNAKE_DY[direction];
+
+        // Wall collision
+        if (newX < 0 || newX >= W || newY < 0 || newY >= H) {
+            gameOver = true;
+            gameOverMs = now;
+            return false;
+        }
+
+        // Self collision
+        // Tail will move away this step (unless eating), so allow tail cell
+        uint16_t tailRingIdx = ringIndex(snakeLen - 1);
+        bool hittingTail = ((uint8_t)newX == bodyX[tailRingIdx] &&
+                            (uint8_t)newY == bodyY[tailRingIdx]);
+        bool eating = ((uint8_t)newX == foodX && (uint8_t)newY == foodY);
+
+        if (isOccupied((uint8_t)newX, (uint8_t)newY) && (!hittingTail || eating)) {
+            gameOver = true;
+            gameOverMs = now;
+            return false;
+        }
+
+        // Advance head
+        headIdx = (headIdx + 1) % MAX_LEN;
+        bodyX[headIdx] = (uint8_t)newX;
+        bodyY[headIdx] = (uint8_t)newY;
+
+        if (eating) {
+            snakeLen++;
+            snakeScore++;
+            rebuildOccupied();
+            placeFood();
+        } else {
+            rebuildOccupied();
+        }
+        return true;
+    }
+};
+
+#endif // SNAKE_ENGINE_H
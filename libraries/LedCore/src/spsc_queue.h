@@ -0,0 +1,54 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdint.h>
+#include <atomic>
+
+// ─── Single-producer / single-consumer queue ───────────────────────────────
+// Fixed ring of N (a power of two) slots between exactly one producing task
+// and one consuming task. Each side only writes its own index: the
+// producer publishes a slot with a release store of `head` after filling
+// it, and the consumer frees one with a release store of `tail` after
+// copying it out. Neither side ever blocks or takes a lock, and only plain
+// 32-bit loads and stores are needed, so it works on cores without atomic
+// read-modify-write instructions (the ESP32-C3 is RV32IMC).
+//
+// Indices run freely and wrap at 2^32; `head - tail` is the fill level.
+
+template <typename T, uint32_t N>
+class SpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue size must be a power of two");
+
+public:
+    // Producer side. Returns false (and drops v) when the queue is full.
+    bool push(const T &v) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == N) return false;
+        slots[h & (N - 1)] = v;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when there is nothing to take.
+    bool pop(T &v) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) == t) return false;
+        v = slots[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate from either side; exact from a side that is not running.
+    uint32_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    static constexpr uint32_t capacity() { return N; }
+
+private:
+    T slots[N];
+    std::atomic<uint32_t> head{0};     // written by the producer only
+    std::atomic<uint32_t> tail{0};     // written by the consumer only
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,635 @@
+#ifndef TETRIS_ENGINE_H
+#define TETRIS_ENGINE_H
+
+#include <Arduino.h>
+#include "led_geometry.h"
+#include "fast_rng.h"
+#include "pixel_kernels.h"
+
+// ─── Tetris Engine ─────────────────────────────────────────────────────────
+// Self-playing (or phone-controlled) Tetris on any LedGeometry. The board
+// keeps a colour per cell for rendering plus one RowBits mask per row, so
+// fit tests, full-row checks and the AI's board scoring are word-wide bit
+// operations sized to the grid width at compile time.
+//
+// Render into anything with setPixelColor(uint16_t, uint32_t) and show().
+
+#define TETRIS_NUM_PIECES      7
+#define TETRIS_AI_TOP_N        5
+#define TETRIS_CLEAR_FLASH_MS  400
+#define TETRIS_GAME_OVER_MS    1500
+
+static const uint32_t TETRIS_COLOURS[TETRIS_NUM_PIECES] = {
+    0x00F0F0,  // I — cyan
+    0xF0F000,  // O — yellow
+    0xA000F0,  // T — purple
+    0x00F000,  // S — green
+    0xF00000,  // Z — red
+    0xF03C96,  // L — pink
+    0x0000F0,  // J — blue
+};
+
+// 4 rotations per piece, 16-bit bitmask (4x4 grid, MSB = top-left)
+static const uint16_t TETRIS_SHAPES[TETRIS_NUM_PIECES][4] = {
+    {0x0F00, 0x2222, 0x00F0, 0x4444},  // I
+    {0x6600, 0x6600, 0x6600, 0x6600},  // O
+    {0x4E00, 0x4640, 0x0E40, 0x4C40},  // T
+    {0x6C00, 0x4620, 0x06C0, 0x8C40},  // S
+    {0xC600, 0x2640, 0x0C60, 0x4C80},  // Z
+    {0x2E00, 0x4460, 0x0E80, 0xC440},  // L
+    {0x8E00, 0x6440, 0x0E20, 0x44C0},  // J
+};
+
+// Shape rows are stored MSB = left; board rows are bit x = column x.
+static const uint8_t TETRIS_REV4[16] = {
+    0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE,
+    0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF,
+};
+
+template <class Geo>
+class TetrisEngine {
+public:
+    static const uint8_t W = Geo::WIDTH;
+    static const uint8_t H = Geo::HEIGHT;
+    typedef typename Geo::RowBits RowBits;
+
+    // ─── Configuration ─────────────────────────────────────────────────────
+
+    void setTuning(uint16_t dropStartMs, uint16_t dropMinMs,
+                   uint16_t moveIntervalMs, uint16_t rotIntervalMs,
+                   uint8_t aiSkillPct, uint8_t jitterPct) {
+        cfgDropStartMs    = constrain(dropStartMs, 100, 600);
+        cfgDropMinMs      = constrain(dropMinMs, 30, 200);
+        cfgMoveIntervalMs = constrain(moveIntervalMs, 20, 200);
+        cfgRotIntervalMs  = constrain(rotIntervalMs, 50, 300);
+        cfgAiSkillPct     = constrain(aiSkillPct, 0, 100);
+        cfgJitterPct      = constrain(jitterPct, 0, 50);
+    }
+
+    void setBackground(uint32_t colour) { cfgBgColour = colour; }
+
+    void seed(uint32_t s) { rng.seed(s); }
+
+    void reset() {
+        memset(board, 0, sizeof(board));
+        memset(rows, 0, sizeof(rows));
+        clearing = false;
+        gameOver = false;
+        numClearRows = 0;
+        piecesPlaced = 0;
+        totalScore = 0;
+        totalLines = 0;
+        dropIntervalMs = cfgDropStartMs;
+        lastDropMs = millis();
+        lastMoveMs = millis();
+        lastRotMs = millis();
+        spawnPiece();
+    }
+
+    // ─── Manual Control ────────────────────────────────────────────────────
+
+    void setManualMode(bool enabled) {
+        if (manualActive != enabled) {
+            manualActive = enabled;
+            reset();
+        }
+    }
+
+    bool isManualMode() const { return manualActive; }
+
+    bool moveLeft() {
+        if (!manualActive || clearing || gameOver) return false;
+        if (pieceFits(pieceType, pieceRot, pieceX - 1, pieceY)) {
+            pieceX--;
+            return true;
+        }
+        return false;
+    }
+
+    bool moveRight() {
+        if (!manualActive || clearing || gameOver) return false;
+        if (pieceFits(pieceType, pieceRot, pieceX + 1, pieceY)) {
+            pieceX++;
+            return true;
+        }
+        return false;
+    }
+
+    bool rotate() {
+        if (!manualActive || clearing || gameOver) return false;
+        uint8_t newRot = (pieceRot + 1) % 4;
+        if (pieceFits(pieceType, newRot, pieceX, pieceY)) {
+            pieceRot = newRot;
+            return true;
+        }
+        return false;
+    }
+
+    void hardDrop() {
+        if (!manualActive || clearing || gameOver) return;
+        while (pieceFits(pieceType, pieceRot, pieceX, pieceY + 1)) {
+            pieceY++;
+        }
+        // Force immediate lock on next frame
+        lastDropMs = 0;
+    }
+
+    void softDrop(bool active) { softDropActive = active; }
+
+    // ─── State Query ───────────────────────────────────────────────────────
+    // gridOut is W * H colours, row-major in logical coordinates.
+
+    void getState(uint32_t *gridOut, uint8_t &pType, int8_t &px, int8_t &py,
+                  uint8_t &rot, uint16_t &score, uint16_t &lines,
+                  bool &over, bool &clr) const {
+        for (uint8_t y = 0; y < H; y++) {
+            for (uint8_t x = 0; x < W; x++) {
+                uint32_t c = board[y][x];
+                gridOut[y * W + x] = c != 0 ? c : cfgBgColour;
+            }
+        }
+        if (!clearing && !gameOver) {
+            for (uint8_t r = 0; r < 4; r++) {
+                for (uint8_t c = 0; c < 4; c++) {
+                    if (!shapeCell(pieceType, pieceRot, r, c)) continue;
+                    int8_t bx = pieceX + c;
+                    int8_t by = pieceY + r;
+                    if (bx >= 0 && bx < W && by >= 0 && by < H) {
+                        gridOut[by * W + bx] = TETRIS_COLOURS[pieceType];
+                    }
+                }
+            }
+        }
+        pType = pieceType;
+        px = pieceX;
+        py = pieceY;
+        rot = pieceRot;
+        score = totalScore;
+        lines = totalLines;
+        over = gameOver;
+        clr = clearing;
+    }
+
+    // ─── Frame ─────────────────────────────────────────────────────────────
+
+    template <class Strip>
+    void update(Strip &strip) {
+        unsigned long now = millis();
+
+        // ── Game over: flash then reset ──
+        if (gameOver) {
+            bool flashOn = ((now - gameOverStartMs) / 200) & 1;
+            for (uint8_t y = 0; y < H; y++) {
+                for (uint8_t x = 0; x < W; x++) {
+                    uint32_t c = board[y][x];
+                    if (flashOn && c != 0) c = 0xFFFFFF;
+                    strip.setPixelColor(Geo::index(x, y), c != 0 ? c : cfgBgColour);
+                }
+            }
+            strip.show();
+            if (now - gameOverStartMs >= TETRIS_GAME_OVER_MS) {
+                reset();
+            }
+            return;
+        }
+
+        // ── Row clearing animation — rainbow sweep then fade ──
+        if (clearing) {
+            unsigned long elapsed = now - clearStartMs;
+            uint8_t fade = (elapsed < TETRIS_CLEAR_FLASH_MS)
+                ? 255 - (uint8_t)(elapsed * 255UL / TETRIS_CLEAR_FLASH_MS)
+                : 0;
+            uint8_t hueOffset = (uint8_t)(elapsed / 2);  // Fast hue rotation
+
+            for (uint8_t y = 0; y < H; y++) {
+                bool isClearing = rows[y] == Geo::FULL_ROW;
+                for (uint8_t x = 0; x < W; x++) {
+                    if (isClearing) {
+                        uint32_t rainbow = colourWheel(hueOffset + x * 16);
+                        uint8_t r = (uint8_t)((rainbow >> 16) * fade >> 8);
+                        uint8_t g = (uint8_t)(((rainbow >> 8) & 0xFF) * fade >> 8);
+                        uint8_t b = (uint8_t)((rainbow & 0xFF) * fade >> 8);
+                        strip.setPixelColor(Geo::index(x, y),
+                            ((uint32_t)r << 16) | ((uint32_t)g << 8) | b);
+                    } else {
+                        uint32_t c = board[y][x];
+                        strip.setPixelColor(Geo::index(x, y), c != 0 ? c : cfgBgColour);
+                    }
+                }
+            }
+            strip.show();
+            if (elapsed >= TETRIS_CLEAR_FLASH_MS) {
+                removeRows();
+                clearing = false;
+                spawnPiece();
+                lastDropMs = now;
+                lastMoveMs = now;
+            }
+            return;
+        }
+
+        // ── AI mode: human-like rotate and slide toward target ──
+        if (!manualActive) {
+            // Reaction delay — piece must be on-screen and "thinking" time elapsed
+            if (aiThinking) {
+                unsigned long thinkMs = 150 + rng.below(350);  // 150-500ms
+                if (pieceY >= 2 && now - thinkStartMs >= thinkMs) {
+                    aiThinking = false;
+                }
+            }
+
+            // Rotate and move happen simultaneously (like a real player)
+            if (!aiThinking) {
+                // Rotate via shortest path
+                if (rotStepsLeft > 0 && now - lastRotMs >= cfgRotIntervalMs) {
+                    lastRotMs = now;
+                    uint8_t nextRot = (pieceRot + rotDir + 4) % 4;
+                    if (pieceFits(pieceType, nextRot, pieceX, pieceY)) {
+                        pieceRot = nextRot;
+                        rotStepsLeft--;
+                    } else {
+                        rotStepsLeft = 0;
+                    }
+                }
+            }
+
+            if (!aiThinking && !reachedTarget && now - lastMoveMs >= cfgMoveIntervalMs) {
+                lastMoveMs = now;
+                if (rng.chance(cfgJitterPct)) {
+                    // Hesitate — skip this tick
+                } else if (pieceX < targetX) {
+                    if (pieceFits(pieceType, pieceRot, pieceX + 1, pieceY)) {
+                        pieceX++;
+                    } else {
+                        reachedTarget = true;
+                    }
+                } else if (pieceX > targetX) {
+                    if (pieceFits(pieceType, pieceRot, pieceX - 1, pieceY)) {
+                        pieceX--;
+                    } else {
+                        reachedTarget = true;
+                    }
+                } else {
+                    reachedTarget = true;
+                }
+            }
+        }
+
+        // ── Drop the piece ──
+        uint16_t effectiveDropMs = softDropActive ? cfgDropMinMs : dropIntervalMs;
+        if (now - lastDropMs >= effectiveDropMs) {
+            lastDropMs = now;
+
+            if (pieceFits(pieceType, pieceRot, pieceX, pieceY + 1)) {
+                pieceY++;
+            } else {
+                lockPiece();
+
+                if (findFullRows() > 0) {
+                    clearing = true;
+                    clearStartMs = now;
+                } else {
+                    spawnPiece();
+                    lastMoveMs = now;
+                }
+
+                // Speed up every 10 pieces
+                if (piecesPlaced % 10 == 0 && dropIntervalMs > cfgDropMinMs) {
+                    dropIntervalMs -= 25;
+                    if (dropIntervalMs < cfgDropMinMs) dropIntervalMs = cfgDropMinMs;
+                }
+            }
+        }
+
+        render(strip);
+    }
+
+private:
+    struct Placement {
+        int8_t  x;
+        uint8_t rot;
+        float   score;
+    };
+
+    // ─── Runtime Config ────────────────────────────────────────────────────
+    uint16_t cfgDropStartMs    = 300;
+    uint16_t cfgDropMinMs      = 80;
+    uint16_t cfgMoveIntervalMs = 70;
+    uint16_t cfgRotIntervalMs  = 150;
+    uint8_t  cfgAiSkillPct     = 90;
+    uint8_t  cfgJitterPct      = 20;
+    uint32_t cfgBgColour       = 0;
+
+    // ─── State ─────────────────────────────────────────────────────────────
+    FastRng  rng;
+
+    uint32_t board[H][W];     // cell colours, 0 = empty
+    RowBits  rows[H];         // occupancy, bit x = column x
+
+    // Current piece
+    uint8_t  pieceType = 0;
+    uint8_t  pieceRot = 0;
+    int8_t   pieceX = 0, pieceY = 0;
+
+    // AI target
+    int8_t   targetX = 0;
+    uint8_t  targetRot = 0;
+    bool     reachedTarget = false;
+    int8_t   rotDir = 1;
+    uint8_t  rotStepsLeft = 0;    // Rotation steps remaining (shortest path)
+    bool     aiThinking = false;  // Reaction delay before first action
+    unsigned long thinkStartMs = 0;
+
+    // Manual mode
+    bool     manualActive = false;
+    bool     softDropActive = false;
+
+    // Timing
+    unsigned long lastDropMs = 0;
+    unsigned long lastMoveMs = 0;
+    unsigned long lastRotMs = 0;
+    uint16_t dropIntervalMs = 300;
+    uint16_t piecesPlaced = 0;
+
+    // Score tracking
+    uint16_t totalScore = 0;
+    uint16_t totalLines = 0;
+
+    // Row clearing
+    bool     clearing = false;
+    uint8_t  clearRows[H];
+    uint8_t  numClearRows = 0;
+    unsigned long clearStartMs = 0;
+
+    // Game over
+    bool     gameOver = false;
+    unsigned long gameOverStartMs = 0;
+
+    // ─── Shape Helpers ─────────────────────────────────────────────────────
+
+    static bool shapeCell(uint8_t type, uint8_t rot, uint8_t row, uint8_t col) {
+        return (TETRIS_SHAPES[type][rot] >> (15 - (row * 4 + col))) & 1;
+    }
+
+    // Row `row` of a shape as a column mask, bit c = shape column c.
+    static uint8_t shapeRow(uint8_t type, uint8_t rot, uint8_t row) {
+        return TETRIS_REV4[(TETRIS_SHAPES[type][rot] >> (12 - row * 4)) & 0xF];
+    }
+
+    // Shape row mask placed at column px, or false if any cell falls off
+    // the left or right edge.
+    static bool rowMaskAt(uint8_t bits, int8_t px, RowBits &mask) {
+        if (px < 0) {
+            if (px <= -4 || (bits & ((1 << -px) - 1))) return false;
+            mask = (RowBits)(bits >> -px);
+            return true;
+        }
+        if (px >= (int8_t)W) return false;
+        RowBits m = (RowBits)bits << px;
+        if ((RowBits)(m >> px) != bits || (m & (RowBits)~Geo::FULL_ROW)) return false;
+        mask = m;
+        return true;
+    }
+
+    bool pieceFits(uint8_t type, uint8_t rot, int8_t px, int8_t py) const {
+        for (uint8_t r = 0; r < 4; r++) {
+            uint8_t bits = shapeRow(type, rot, r);
+            if (!bits) continue;
+            RowBits mask;
+            if (!rowMaskAt(bits, px, mask)) return false;
+            int8_t by = py + r;
+            if (by >= (int8_t)H) return false;
+            if (by >= 0 && (rows[by] & mask)) return false;
+        }
+        return true;
+    }
+
+    int8_t hardDropY(uint8_t type, uint8_t rot, int8_t px) const {
+        int8_t py = -2;
+        while (pieceFits(type, rot, px, py + 1)) {
+            py++;
+        }
+        return py;
+    }
+
+    // ─── AI: Board Scoring ─────────────────────────────────────────────────
+    // Drops the piece into the occupancy masks, scores the board, then
+    // restores the touched rows.
+
+    float scorePlacement(uint8_t type, uint8_t rot, int8_t px) {
+        int8_t py = hardDropY(type, rot, px);
+
+        RowBits saved[4];
+        for (uint8_t r = 0; r < 4; r++) {
+            int8_t by = py + r;
+            if (by < 0 || by >= (int8_t)H) continue;
+            saved[r] = rows[by];
+            RowBits mask;
+            if (rowMaskAt(shapeRow(type, rot, r), px, mask)) rows[by] |= mask;
+        }
+
+        int colHeights[W];
+        int aggregateHeight = 0;
+        int holes = 0;
+        for (uint8_t x = 0; x < W; x++) {
+            RowBits bit = (RowBits)1 << x;
+            colHeights[x] = 0;
+            bool foundFilled = false;
+            for (uint8_t y = 0; y < H; y++) {
+                if (rows[y] & bit) {
+                    if (!foundFilled) colHeights[x] = H - y;
+                    foundFilled = true;
+                } else if (foundFilled) {
+                    holes++;
+                }
+            }
+            aggregateHeight += colHeights[x];
+        }
+
+        int completedLines = 0;
+        for (uint8_t y = 0; y < H; y++) {
+            if (rows[y] == Geo::FULL_ROW) completedLines++;
+        }
+
+        int bumpiness = 0;
+        for (uint8_t x = 0; x < W - 1; x++) {
+            int diff = colHeights[x] - colHeights[x + 1];
+            bumpiness += (diff < 0) ? -diff : diff;
+        }
+
+        for (uint8_t r = 0; r < 4; r++) {
+            int8_t by = py + r;
+            if (by >= 0 && by < (int8_t)H) rows[by] = saved[r];
+        }
+
+        return -0.35f * aggregateHeight
+               + 1.40f * completedLines
+               - 0.50f * holes
+               - 0.15f * bumpiness;
+    }
+
+    // ─── AI: Choose Placement ──────────────────────────────────────────────
+
+    void aiChoosePlacement(uint8_t type) {
+        Placement best;
+        best.score = -999999.0f;
+        best.x = (W / 2) - 2;
+        best.rot = 0;
+
+        Placement topN[TETRIS_AI_TOP_N];
+        uint8_t topCount = 0;
+
+        for (uint8_t rot = 0; rot < 4; rot++) {
+            for (int8_t px = -2; px < (int8_t)W; px++) {
+                if (!pieceFits(type, rot, px, -2)) continue;
+                int8_t landY = hardDropY(type, rot, px);
+                if (landY < -1) continue;
+
+                float s = scorePlacement(type, rot, px);
+                s += (float)rng.range(-15, 16) / 100.0f;
+
+                if (s > best.score) {
+                    best.score = s;
+                    best.x = px;
+                    best.rot = rot;
+                }
+
+                if (topCount < TETRIS_AI_TOP_N) {
+                    topN[topCount++] = {px, rot, s};
+                } else {
+                    uint8_t worstIdx = 0;
+                    for (uint8_t i = 1; i < TETRIS_AI_TOP_N; i++) {
+                        if (topN[i].score < topN[worstIdx].score) worstIdx = i;
+                    }
+                    if (s > topN[worstIdx].score) {
+                        topN[worstIdx] = {px, rot, s};
+                    }
+                }
+            }
+        }
+
+        // Use cfgAiSkillPct to determine optimal vs random pick
+        uint8_t randPct = 100 - cfgAiSkillPct;
+        if (rng.chance(randPct) && topCount > 1) {
+            uint8_t pick = rng.below(topCount);
+            targetX = topN[pick].x;
+            targetRot = topN[pick].rot;
+        } else {
+            targetX = best.x;
+            targetRot = best.rot;
+        }
+    }
+
+    // ─── Piece Lifecycle ───────────────────────────────────────────────────
+
+    void lockPiece() {
+        for (uint8_t r = 0; r < 4; r++) {
+            for (uint8_t c = 0; c < 4; c++) {
+                if (!shapeCell(pieceType, pieceRot, r, c)) continue;
+                int8_t bx = pieceX + c;
+                int8_t by = pieceY + r;
+                if (bx >= 0 && bx < W && by >= 0 && by < H) {
+                    board[by][bx] = TETRIS_COLOURS[pieceType];
+                    rows[by] |= (RowBits)1 << bx;
+                }
+            }
+        }
+        piecesPlaced++;
+    }
+
+    uint8_t findFullRows() {
+        numClearRows = 0;
+        for (uint8_t y = 0; y < H; y++) {
+            if (rows[y] == Geo::FULL_ROW) {
+                clearRows[numClearRows++] = y;
+            }
+        }
+        return numClearRows;
+    }
+
+    void removeRows() {
+        totalLines += numClearRows;
+        totalScore += numClearRows * numClearRows * 100;  // 1=100, 2=400, 3=900, 4=1600
+
+        for (int8_t i = numClearRows - 1; i >= 0; i--) {
+            uint8_t row = clearRows[i];
+            for (int8_t y = row; y > 0; y--) {
+                memcpy(board[y], board[y - 1], sizeof(board[y]));
+                rows[y] = rows[y - 1];
+            }
+            memset(board[0], 0, sizeof(board[0]));
+            rows[0] = 0;
+        }
+    }
+
+    void spawnPiece() {
+        pieceType = rng.below(TETRIS_NUM_PIECES);
+        pieceX = (W / 2) - 2;
+        pieceY = -1;
+        reachedTarget = false;
+        softDropActive = false;
+
+        if (manualActive) {
+            pieceRot = 0;
+            rotStepsLeft = 0;
+            aiThinking = false;
+        } else {
+            // Always spawn at rotation 0 (natural, like a real game)
+            pieceRot = 0;
+
+            // AI decides where to place
+            aiChoosePlacement(pieceType);
+
+            // Shortest-path rotation (0-2 steps, like a human would do)
+            uint8_t cwDist  = (targetRot - pieceRot + 4) % 4;
+            uint8_t ccwDist = (pieceRot - targetRot + 4) % 4;
+            if (cwDist <= ccwDist) {
+                rotDir = 1;
+                rotStepsLeft = cwDist;
+            } else {
+                rotDir = -1;
+                rotStepsLeft = ccwDist;
+            }
+
+            // Human-like reaction delay: piece drops a couple of rows
+            // before the "player" starts moving/rotating (150-500ms)
+            aiThinking = true;
+            thinkStartMs = millis();
+        }
+
+        if (!pieceFits(pieceType, pieceRot, pieceX, pieceY)) {
+            gameOver = true;
+            gameOverStartMs = millis();
+        }
+    }
+
+    // ─── Rendering ─────────────────────────────────────────────────────────
+
+    template <class Strip>
+    void render(Strip &strip) {
+        for (uint8_t y = 0; y < H; y++) {
+            for (uint8_t x = 0; x < W; x++) {
+                uint32_t c = board[y][x];
+                strip.setPixelColor(Geo::index(x, y), c != 0 ? c : cfgBgColour);
+            }
+        }
+
+        // Draw the falling piece
+        if (!clearing && !gameOver) {
+            for (uint8_t r = 0; r < 4; r++) {
+                for (uint8_t c = 0; c < 4; c++) {
+                    if (!shapeCell(pieceType, pieceRot, r, c)) continue;
+                    int8_t bx = pieceX + c;
+                    int8_t by = pieceY + r;
+                    if (bx >= 0 && bx < W && by >= 0 && by < H) {
+                        strip.setPixelColor(Geo::index(bx, by), TETRIS_COLOURS[pieceType]);
+                    }
+                }
+            }
+        }
+
+        strip.show();
+    }
+};
+
+#endif // TETRIS_ENGINE_H
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""Generate the seed corpus for json_reader_test.cpp.
+
+Writes light_commands.tsv next to this script: one MQTT light command per
+line, with what parseLightCommand() must make of it according to Python's
+json module. Documents mix the three keys the device reads with keys it
+skips, \\u escapes, nested junk values, out-of-range brightness, overlong
+effect names and whitespace. About one in five is then broken (truncated,
+or a missing colon).
+
+Line format, tab-separated:
+    <document hex>  1  <state>  <brightness>  <effect hex>   well-formed
+    <document hex>  0                                        malformed
+
+state and brightness are -1 when absent or rejected, effect is empty.
+The seed is fixed, so the file only changes when this script does.
+"""
+
+import json
+import random
+import sys
+from pathlib import Path
+
+OUT = Path(__file__).parent / "light_commands.tsv"
+EFFECTS = ["Tetris", "Rainbow Wave", "Colour Wash", "Diagonal Rainbow", "Fire", "Snake", "GIF"]
+EFFECT_MAX = 23     # LightCommand::effect holds 23 bytes + NUL
+
+
+def jstr(s: str, escape: bool = False) -> str:
+    out = '"'
+    for ch in s:
+        if ch in '"\\':
+            out += "\\" + ch
+        elif ord(ch) < 0x20 or (escape and random.random() < 0.3):
+            out += "\\u%04x" % ord(ch)
+        else:
+            out += ch
+    return out + '"'
+
+
+def junk(depth: int = 0) -> str:
+    kind = random.randint(0, 6 if depth < 3 else 3)
+    if kind == 0:
+        return str(random.randint(-1000, 1000))
+    if kind == 1:
+        return random.choice(["true", "false", "null", "1.5", "2e3", "-0"])
+    if kind == 2:
+        return jstr(random.choice(["x", "ON", "été", 'a"b', "\\\\", "\n"]), True)
+    if kind == 3:
+        return '"%s"' % ("z" * random.randint(0, 40))
+    if kind == 4:
+        return "[" + ",".join(junk(depth + 1) for _ in range(random.randint(0, 4))) + "]"
+    return "{" + ",".join(jstr("k%d" % i) + ":" + junk(depth + 1)
+                          for i in range(random.randint(0, 3))) + "}"
+
+
+def ws() -> str:
+    return random.choice(["", "", " ", "\n\t ", " \r\n"])
+
+
+def state_value():
+    c = random.randint(0, 4)
+    if c < 2:
+        word = ["OFF", "ON"][c]
+        return jstr(word, escape=random.random() < 0.3), c
+    if c == 2:
+        return '"on"', -1
+    if c == 3:
+        return '"OFFF"', -1
+    v = junk()
+    return v, {"ON": 1, "OFF": 0}.get(json.loads(v), -1) if v.startswith('"') else -1
+
+
+def brightness_value():
+    c = random.randint(0, 3)
+    if c == 0:
+        b = random.randint(0, 255)
+        return str(b), b
+    if c == 1:
+        return str(random.randint(256, 10**12)), -1
+    if c == 2:
+        return random.choice(["-1", "12.0", "1e2", '"40"', "true", "null", "[]"]), -1
+    return "99999999999999999999", -1
+
+
+def effect_value():
+    c = random.randint(0, 3)
+    if c < 2:
+        name = random.choice(EFFECTS)
+        return jstr(name, escape=c == 1), name
+    if c == 2:
+        return jstr("Q" * random.randint(EFFECT_MAX + 1, 40)), ""
+    v = junk()
+    if v.startswith('"') and len(json.loads(v).encode()) <= EFFECT_MAX:
+        return v, json.loads(v)
+    return v, ""
+
+
+def document():
+    want = {"state": -1, "brightness": -1, "effect": ""}
+    items = []
+    keys = random.sample(["state", "brightness", "effect", "color_mode", "transition", "color", "x" * 20],
+                         random.randint(0, 5))
+    for key in keys:
+        if key == "state":
+            v, want["state"] = state_value()
+        elif key == "brightness":
+            v, want["brightness"] = brightness_value()
+        elif key == "effect":
+            v, want["effect"] = effect_value()
+        else:
+            v = junk()
+        items.append(ws() + jstr(key, escape=True) + ws() + ":" + ws() + v + ws())
+    doc = ws() + "{" + ",".join(items) + "}" + ws()
+
+    r = random.random()
+    if r < 0.15:
+        doc = doc[:random.randint(0, len(doc) - 1)]
+    elif r < 0.2:
+        doc = doc.replace(":", " ", 1) if ":" in doc else "[" + doc
+    try:
+        json.loads(doc)
+    except ValueError:
+        return "%s\t0" % doc.encode().hex()
+    return "%s\t1\t%d\t%d\t%s" % (doc.encode().hex(), want["state"], want["brightness"],
+                                  want["effect"].encode().hex())
+
+
+def main():
+    count = int(sys.argv[1]) if len(sys.argv) > 1 else 200
+    random.seed(44)
+    lines = [document() for _ in range(count)]
+    OUT.write_text("\n".join(lines) + "\n")
+    bad = sum(1 for line in lines if line.split("\t")[1] == "0")
+    print(f"{OUT.name}: {count} documents, {bad} malformed")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,70 @@
+#ifndef HOST_ADAFRUIT_NEOPIXEL_H
+#define HOST_ADAFRUIT_NEOPIXEL_H
+
+#include <Arduino.h>
+#include <vector>
+
+// ─── Host NeoPixel Strip ───────────────────────────────────────────────────
+// The part of Adafruit_NeoPixel the sketches call, over a pixel array.
+// show() only counts frames. Colours are kept as set (0xWWRRGGBB) next to
+// the brightness, so tests can compare either; the byte buffer getPixels()
+// returns is scaled as set, like the real strip's, so it costs what the
+// real one does.
+
+#define NEO_GRB       0x52
+#define NEO_GRBW      0xD2
+#define NEO_KHZ800    0x0000
+
+class Adafruit_NeoPixel {
+public:
+    Adafruit_NeoPixel(uint16_t n = 0, int16_t pin = -1, uint16_t type = NEO_GRB + NEO_KHZ800)
+        : px(n, 0), bytes(n * 4, 0) {}
+
+    void begin() {}
+    void show() { shows++; }
+    void clear() { fill(0); }
+    void fill(uint32_t c = 0, uint16_t first = 0, uint16_t count = 0) {
+        uint16_t end = (count == 0 || first + count > numPixels()) ? numPixels() : first + count;
+        for (uint16_t i = first; i < end; i++) setPixelColor(i, c);
+    }
+    void setPixelColor(uint16_t n, uint32_t c) {
+        if (n >= px.size()) return;
+        px[n] = c;
+        scale(n);
+    }
+    void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b) {
+        setPixelColor(n, ((uint32_t)r << 16) | ((uint32_t)g << 8) | b);
+    }
+    uint32_t getPixelColor(uint16_t n) const { return n < px.size() ? px[n] : 0; }
+    uint16_t numPixels() const { return (uint16_t)px.size(); }
+    void setBrightness(uint8_t b) {
+        if (b == brightness) return;
+        brightness = b;
+        for (uint16_t i = 0; i < numPixels(); i++) scale(i);
+    }
+    uint8_t  getBrightness() const { return brightness; }
+
+    static uint32_t Color(uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0) {
+        return ((uint32_t)w << 24) | ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+    }
+
+    // W, R, G, B per pixel
+    const uint8_t *getPixels() const { return bytes.data(); }
+
+    uint32_t shows = 0;
+
+private:
+    // Pixel n into the byte buffer, scaled like the real one ((c * (b + 1)) >> 8)
+    void scale(uint16_t n) {
+        for (int k = 0; k < 4; k++) {
+            uint8_t c = px[n] >> (24 - 8 * k);
+            bytes[n * 4 + k] = (uint8_t)((c * (brightness + 1)) >> 8);
+        }
+    }
+
+    std::vector<uint32_t> px;
+    std::vector<uint8_t>  bytes;
+    uint8_t brightness = 255;
+};
+
+#endif // HOST_ADAFRUIT_NEOPIXEL_H
@@ -0,0 +1,98 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// ─── Host Arduino Shim ─────────────────────────────────────────────────────
+// Just enough of the Arduino core to build LedCore's headers with g++ on a
+// desktop: flash tables are plain arrays, the clock is the host's steady
+// clock, Serial prints to stdout and String is a std::string. Tests that
+// need a controllable clock define HOST_FAKE_CLOCK and set hostMillis
+// themselves.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#define PROGMEM
+#define IRAM_ATTR
+#define F(s) s
+#define pgm_read_byte(p)  (*(const uint8_t *)(p))
+#define pgm_read_word(p)  (*(const uint16_t *)(p))
+#define pgm_read_dword(p) (*(const uint32_t *)(p))
+#define memcpy_P memcpy
+
+#define constrain(a, lo, hi) ((a) < (lo) ? (lo) : ((a) > (hi) ? (hi) : (a)))
+#define PI 3.1415926535897932384626433832795
+
+using std::min;
+using std::max;
+
+#ifdef HOST_FAKE_CLOCK
+extern uint32_t hostMillis;
+inline unsigned long millis() { return hostMillis; }
+inline unsigned long micros() { return hostMillis * 1000UL; }
+#else
+inline unsigned long micros() {
+    using namespace std::chrono;
+    return (unsigned long)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+inline unsigned long millis() { return micros() / 1000; }
+#endif
+
+inline void yield() {}
+inline void delay(unsigned long) {}
+
+// random() is a plain LCG. A test replaying the same frames through two
+// implementations saves hostRandomState before the first and restores it
+// for the second, so both draw the same numbers.
+inline uint32_t hostRandomState = 1;
+inline void randomSeed(unsigned long seed) { hostRandomState = seed; }
+inline long random(long howBig) {
+    if (howBig <= 0) return 0;
+    hostRandomState = hostRandomState * 1103515245u + 12345u;
+    return (hostRandomState >> 8) % howBig;
+}
+inline long random(long lo, long hi) { return lo >= hi ? lo : lo + random(hi - lo); }
+
+// Cycle counter for trace spans: a 160 MHz clock derived from micros().
+struct HostEsp {
+    uint32_t getCycleCount() { return (uint32_t)(micros() * 160UL); }
+};
+inline HostEsp ESP;
+inline uint32_t getCpuFrequencyMhz() { return 160; }
+
+class String {
+public:
+    String(const char *c = "") : s(c ? c : "") {}
+    const char *c_str() const { return s.c_str(); }
+    unsigned length() const { return (unsigned)s.size(); }
+    bool operator==(const char *o) const { return s == o; }
+
+private:
+    std::string s;
+};
+
+// Set muted to keep a test's output to its own results.
+struct HostSerial {
+    bool muted = false;
+
+    void begin(unsigned long) {}
+    void print(const char *s) { if (!muted) fputs(s, stdout); }
+    void println(const char *s = "") { if (!muted) puts(s); }
+    void printf(const char *fmt, ...) {
+        if (muted) return;
+        va_list ap;
+        va_start(ap, fmt);
+        vprintf(fmt, ap);
+        va_end(ap);
+    }
+};
+inline HostSerial Serial;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,97 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+#include <vector>
+
+// ─── Fake Preferences ──────────────────────────────────────────────────────
+// The ESP32 Preferences API over an in-memory NVS: every namespace/key maps
+// to its bytes, and each get/put/remove is counted so tests can assert how
+// many flash operations a load or save costs. Values are stored as raw
+// bytes like the real NVS, so a test can corrupt a blob in place, and the
+// next `failWrites` puts fail (write nothing, return 0) like a full or
+// worn partition.
+
+struct HostNvs {
+    std::map<std::string, std::vector<uint8_t> > kv;   // "namespace/key" → bytes
+    int reads   = 0;
+    int writes  = 0;
+    int removes = 0;
+    int failWrites = 0;
+
+    void resetCounts() { reads = writes = removes = 0; }
+};
+inline HostNvs hostNvs;
+
+class Preferences {
+public:
+    bool begin(const char *name, bool readOnly = false) {
+        ns = name;
+        return true;
+    }
+    void end() {}
+
+    uint8_t  getUChar(const char *key, uint8_t def = 0)   { return get(key, def); }
+    uint16_t getUShort(const char *key, uint16_t def = 0) { return get(key, def); }
+    bool     getBool(const char *key, bool def = false)   { return get(key, def); }
+    size_t   putUChar(const char *key, uint8_t v)         { return put(key, &v, sizeof(v)); }
+    size_t   putUShort(const char *key, uint16_t v)       { return put(key, &v, sizeof(v)); }
+    size_t   putBool(const char *key, bool v)             { return put(key, &v, sizeof(v)); }
+
+    String getString(const char *key, String def = String()) {
+        const std::vector<uint8_t> *v = find(key);
+        if (!v) return def;
+        return String(std::string(v->begin(), v->end()).c_str());
+    }
+    size_t putString(const char *key, const char *v) { return put(key, v, strlen(v)); }
+
+    size_t getBytesLength(const char *key) {
+        const std::vector<uint8_t> *v = find(key);
+        return v ? v->size() : 0;
+    }
+    size_t getBytes(const char *key, void *buf, size_t len) {
+        const std::vector<uint8_t> *v = find(key);
+        if (!v || v->size() > len) return 0;
+        memcpy(buf, v->data(), v->size());
+        return v->size();
+    }
+    size_t putBytes(const char *key, const void *v, size_t len) { return put(key, v, len); }
+
+    bool remove(const char *key) {
+        hostNvs.removes++;
+        return hostNvs.kv.erase(ns + "/" + key) > 0;
+    }
+
+private:
+    std::string ns;
+
+    const std::vector<uint8_t> *find(const char *key) {
+        hostNvs.reads++;
+        auto it = hostNvs.kv.find(ns + "/" + key);
+        return it == hostNvs.kv.end() ? nullptr : &it->second;
+    }
+
+    template <typename T>
+    T get(const char *key, T def) {
+        const std::vector<uint8_t> *v = find(key);
+        if (!v || v->size() != sizeof(T)) return def;
+        T out;
+        memcpy(&out, v->data(), sizeof(T));
+        return out;
+    }
+
+    size_t put(const char *key, const void *v, size_t len) {
+        hostNvs.writes++;
+        if (hostNvs.failWrites > 0) {
+            hostNvs.failWrites--;
+            return 0;
+        }
+        const uint8_t *b = (const uint8_t *)v;
+        hostNvs.kv[ns + "/" + key] = std::vector<uint8_t>(b, b + len);
+        return len;
+    }
+};
+
+#endif // HOST_PREFERENCES_H
@@ -0,0 +1,50 @@
+// ─── JSON Reader Benchmark ─────────────────────────────────────────────────
+// Time per parseLightCommand() call on the commands Home Assistant sends,
+// and the heap allocations made while parsing them (there should be none).
+
+#include <Arduino.h>
+#include <light_command.h>
+#include <new>
+
+static long allocations = 0;
+static bool counting    = false;
+
+void *operator new(size_t n) {
+    if (counting) allocations++;
+    void *p = malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+static const char *COMMANDS[] = {
+    "{\"state\":\"ON\",\"brightness\":128}",
+    "{\"state\":\"ON\",\"effect\":\"Diagonal Rainbow\"}",
+    "{\"state\":\"OFF\"}",
+    "{\"state\":\"ON\",\"brightness\":200,\"color_mode\":\"brightness\",\"transition\":2}",
+};
+
+int main() {
+    const long N = 2000000;
+    size_t len[4];
+    for (int i = 0; i < 4; i++) len[i] = strlen(COMMANDS[i]);
+
+    double best = 0;
+    long   sum  = 0;
+    counting = true;
+    for (int run = 0; run < 3; run++) {
+        unsigned long start = micros();
+        for (long i = 0; i < N; i++) {
+            LightCommand cmd;
+            sum += parseLightCommand((const uint8_t *)COMMANDS[i & 3], len[i & 3], cmd) + cmd.brightness;
+        }
+        double ns = (micros() - start) * 1000.0 / N;
+        if (best == 0 || ns < best) best = ns;
+    }
+    counting = false;
+
+    printf("  parseLightCommand %6.1f ns/command, %ld heap allocations (checksum %ld)\n",
+           best, allocations, sum);
+    return 0;
+}
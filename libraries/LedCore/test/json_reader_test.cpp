@@ -0,0 +1,158 @@
+// build: -fsanitize=address,undefined -fno-sanitize-recover=all
+// ─── JSON Reader Test ──────────────────────────────────────────────────────
+// parseLightCommand() on hand-written edge cases and on
+// corpus/light_commands.tsv, whose expected results come from Python's json
+// module, then a mutation fuzz seeded from the corpus: bit flips, token
+// inserts, deletes, splices and truncations. Every payload is an exact-size
+// heap copy, so AddressSanitizer catches any read past its end.
+//
+//   ./json_reader_test [iterations]     (default 200000)
+
+#include <Arduino.h>
+#include <light_command.h>
+#include <string>
+#include <vector>
+
+struct Seed {
+    std::string doc;
+    bool        valid;
+    int         state, brightness;
+    std::string effect;
+};
+
+static std::string unhex(const std::string &h) {
+    std::string out;
+    for (size_t i = 0; i + 1 < h.size(); i += 2) out += (char)strtol(h.substr(i, 2).c_str(), nullptr, 16);
+    return out;
+}
+
+static bool loadCorpus(const char *path, std::vector<Seed> &seeds) {
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+    std::string line;
+    for (int c; (c = fgetc(f)) != EOF;) {
+        if (c != '\n') {
+            line += (char)c;
+            continue;
+        }
+        std::vector<std::string> field;
+        size_t at = 0, tab;
+        while ((tab = line.find('\t', at)) != std::string::npos) {
+            field.push_back(line.substr(at, tab - at));
+            at = tab + 1;
+        }
+        field.push_back(line.substr(at));
+        Seed s = {unhex(field[0]), field[1] == "1", -1, -1, ""};
+        if (s.valid) {
+            s.state      = atoi(field[2].c_str());
+            s.brightness = atoi(field[3].c_str());
+            s.effect     = field.size() > 4 ? unhex(field[4]) : "";
+        }
+        seeds.push_back(s);
+        line.clear();
+    }
+    fclose(f);
+    return true;
+}
+
+// Parse from an exact-size heap copy of `doc`.
+static bool parse(const std::string &doc, LightCommand &cmd) {
+    uint8_t *buf = (uint8_t *)malloc(doc.size() ? doc.size() : 1);
+    memcpy(buf, doc.data(), doc.size());
+    bool ok = parseLightCommand(buf, doc.size(), cmd);
+    free(buf);
+    return ok;
+}
+
+static int failures = 0;
+
+static void fail(const char *what, const std::string &doc) {
+    if (++failures <= 10) printf("  FAIL %s: %s\n", what, doc.c_str());
+}
+
+static void check(const Seed &s) {
+    LightCommand cmd;
+    bool ok = parse(s.doc, cmd);
+    if (ok != s.valid) {
+        fail(s.valid ? "rejected well-formed document" : "accepted malformed document", s.doc);
+    } else if (ok && (cmd.state != s.state || cmd.brightness != s.brightness || s.effect != cmd.effect)) {
+        fail("wrong values", s.doc);
+    }
+}
+
+// Limits the generated corpus may not hit.
+static const Seed EDGES[] = {
+    {"{}",                                              true,  -1,  -1, ""},
+    {" {\"state\":\"ON\"} ",                            true,   1,  -1, ""},
+    {"{\"st\\u0061te\":\"\\u004fFF\"}",                 true,   0,  -1, ""},
+    {"{\"brightness\":0}",                              true,  -1,   0, ""},
+    {"{\"brightness\":255}",                            true,  -1, 255, ""},
+    {"{\"brightness\":256}",                            true,  -1,  -1, ""},
+    {"{\"brightness\":4294967296}",                     true,  -1,  -1, ""},
+    {"{\"brightness\":-0}",                             true,  -1,  -1, ""},
+    {"{\"effect\":\"AAAAAAAAAAAAAAAAAAAAAAA\"}",        true,  -1,  -1, "AAAAAAAAAAAAAAAAAAAAAAA"},
+    {"{\"effect\":\"AAAAAAAAAAAAAAAAAAAAAAAA\"}",       true,  -1,  -1, ""},
+    {"{\"effect\":\"\\u00e9t\\u00e9\"}",                true,  -1,  -1, "\xc3\xa9t\xc3\xa9"},
+    {"{\"color\":{\"r\":[1,{\"g\":2}]},\"state\":\"OFF\"}", true, 0, -1, ""},
+    {"",                                                false, -1,  -1, ""},
+    {"[]",                                              false, -1,  -1, ""},
+    {"{\"state\":\"ON\"",                               false, -1,  -1, ""},
+    {"{\"state\" \"ON\"}",                              false, -1,  -1, ""},
+    {"{\"state\":\"ON\",}",                             false, -1,  -1, ""},
+    {"{\"effect\":\"\\u12\"}",                          false, -1,  -1, ""},
+};
+
+static void fuzz(const std::vector<Seed> &seeds, long iterations) {
+    static const char *TOKENS[] = {"{", "}", "[", "]", "\"", ":", ",", "\\", "\\u", "\\u12", "true", "1e", "-", "0"};
+    const size_t NTOKENS = sizeof(TOKENS) / sizeof(TOKENS[0]);
+    srand(7);
+    long accepted = 0;
+
+    for (long i = 0; i < iterations; i++) {
+        std::string s = seeds[rand() % seeds.size()].doc;
+        for (int m = 1 + rand() % 4; m > 0; m--) {
+            size_t pos = s.empty() ? 0 : rand() % (s.size() + 1);
+            switch (rand() % 5) {
+                case 0:
+                    if (!s.empty()) s[pos == s.size() ? pos - 1 : pos] ^= 1 << (rand() % 8);
+                    break;
+                case 1:
+                    s.insert(pos, TOKENS[rand() % NTOKENS]);
+                    break;
+                case 2:
+                    if (!s.empty()) s.erase(pos, 1 + rand() % 8);
+                    break;
+                case 3: {
+                    const std::string &o = seeds[rand() % seeds.size()].doc;
+                    s = s.substr(0, pos) + o.substr(o.empty() ? 0 : rand() % o.size());
+                    break;
+                }
+                default:
+                    s.resize(pos);
+                    break;
+            }
+        }
+
+        LightCommand cmd;
+        if (!parse(s, cmd)) continue;
+        accepted++;
+        if (cmd.state < -1 || cmd.state > 1 || cmd.brightness < -1 || cmd.brightness > 255 ||
+            strnlen(cmd.effect, sizeof(cmd.effect)) >= sizeof(cmd.effect)) {
+            fail("value out of range", s);
+        }
+    }
+    printf("  fuzz: %ld mutated documents, %ld accepted\n", iterations, accepted);
+}
+
+int main(int argc, char **argv) {
+    std::vector<Seed> seeds;
+    if (!loadCorpus("corpus/light_commands.tsv", seeds) || seeds.empty()) {
+        printf("  FAIL corpus/light_commands.tsv missing (run corpus/light_commands.py)\n");
+        return 1;
+    }
+    for (const Seed &s : EDGES) check(s);
+    for (const Seed &s : seeds) check(s);
+    printf("  %zu edge cases, %zu corpus documents\n", sizeof(EDGES) / sizeof(EDGES[0]), seeds.size());
+    fuzz(seeds, argc > 1 ? atol(argv[1]) : 200000);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,47 @@
+// build: -I../../../night_light -Wno-unused-variable ../../../night_light/led_effects.cpp reference/night_light_float.cpp
+// ─── Night Light Benchmark ─────────────────────────────────────────────────
+// Time per frame of each night_light effect on its 55-LED strip, the float
+// versions (reference/night_light_float.cpp) next to the fixed-point ones
+// the sketch now runs. The host has an FPU and the C3 doesn't, so the
+// ratio here understates the gain on the device.
+
+#include <Arduino.h>
+#include "led_effects.h"
+#include "reference/night_light_float.h"
+
+float thermalDimFactor = 1.0f;
+float masterFadeFactor = 1.0f;
+
+static Adafruit_NeoPixel strip(NUM_LEDS);
+static volatile uint32_t sink;   // keeps results live
+
+// Best of three runs, in ns per frame; `now` advances 30 ms a frame.
+template <class Frame>
+static double timeFrames(Frame frame) {
+    const long N = 200000;
+    double best = 0;
+    for (int run = 0; run < 3; run++) {
+        randomSeed(7);
+        unsigned long start = micros();
+        for (long i = 0; i < N; i++) frame((unsigned long)i * 30);
+        double ns = (micros() - start) * 1000.0 / N;
+        if (best == 0 || ns < best) best = ns;
+        sink += strip.getPixelColor(0);
+    }
+    return best;
+}
+
+int main() {
+    printf("  %-16s %10s %10s\n", "effect", "float", "fixed");
+    for (int e = 0; e < EFFECT_COUNT; e++) {
+        EffectType effect = (EffectType)e;
+        double f = timeFrames([&](unsigned long now) {
+            nl_float::applyEffect(strip, effect, 255, 140, 40, 200, 200, now);
+        });
+        double x = timeFrames([&](unsigned long now) {
+            applyEffect(strip, effect, 255, 140, 40, 200, 200, now);
+        });
+        printf("  %-16s %7.0f ns %7.0f ns  (%.2fx)\n", EFFECT_NAMES[e], f, x, f / x);
+    }
+    return 0;
+}
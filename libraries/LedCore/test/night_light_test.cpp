@@ -0,0 +1,147 @@
+// build: -I../../../night_light -Wno-unused-variable ../../../night_light/led_effects.cpp reference/night_light_float.cpp
+// ─── Night Light Test ──────────────────────────────────────────────────────
+// night_light's fixed-point effects against the float versions they
+// replaced (reference/night_light_float.cpp), frame by frame: the strip
+// brightness and every channel of every LED must agree within ±1 LSB.
+// Each effect runs for 40 s of frames (Sunrise: its whole 30 min cycle, a
+// frame a second) in five colour/brightness settings, then slot
+// transitions are swept from 0 to 1. Both sides draw the same random()
+// numbers, so the twinkle and flicker effects are compared too.
+//
+// One difference is deliberate: at the end of Sunrise's cycle the float
+// white ramp passes 255 and wraps to 0 (phase 3 runs 0.34 of the cycle),
+// where the fixed-point one holds 255. Those frames are counted apart.
+
+#include <Arduino.h>
+#include "led_effects.h"
+#include "reference/night_light_float.h"
+
+float thermalDimFactor = 1.0f;
+float masterFadeFactor = 1.0f;
+
+static Adafruit_NeoPixel fixedStrip(NUM_LEDS);
+static Adafruit_NeoPixel floatStrip(NUM_LEDS);
+
+struct Setting {
+    uint8_t r, g, b, w, brightness;
+};
+
+static const Setting SETTINGS[] = {
+    {255, 140,  40, 200, 255},
+    { 10,  20,  30,  40, 128},
+    {  0,   0,   0, 255,  37},
+    {255, 255, 255, 255, 255},
+    {200,  50, 120,   0,  90},
+};
+
+static int failures = 0;
+
+// Largest difference between the two strips, over the brightness and every
+// channel.
+static int frameDiff() {
+    int worst = abs((int)fixedStrip.getBrightness() - (int)floatStrip.getBrightness());
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        uint32_t a = fixedStrip.getPixelColor(i), b = floatStrip.getPixelColor(i);
+        for (int shift = 0; shift < 32; shift += 8) {
+            int d = abs((int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF));
+            if (d > worst) worst = d;
+        }
+    }
+    return worst;
+}
+
+// True if the strips differ only in white, where the fixed strip holds 255
+// and the float one wrapped past it.
+static bool whiteHeld() {
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        uint32_t a = fixedStrip.getPixelColor(i), b = floatStrip.getPixelColor(i);
+        if ((a >> 24) != 255 || (b >> 24) >= 255 - 1) return false;
+        for (int shift = 0; shift < 24; shift += 8) {
+            if (abs((int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF)) > 1) return false;
+        }
+    }
+    return abs((int)fixedStrip.getBrightness() - (int)floatStrip.getBrightness()) <= 1;
+}
+
+struct Tally {
+    uint32_t frames = 0;
+    uint32_t offByOne = 0;
+    uint32_t held = 0;
+    int      worst = 0;
+
+    void add(int diff) {
+        frames++;
+        if (diff == 1) offByOne++;
+        if (diff > worst) worst = diff;
+    }
+};
+
+// Render one frame both ways from the same random() state.
+template <class FloatFn, class FixedFn>
+static int compareFrame(FloatFn floatFrame, FixedFn fixedFrame, bool &randomInStep) {
+    uint32_t state = hostRandomState;
+    floatFrame();
+    uint32_t floatState = hostRandomState;
+    hostRandomState = state;
+    fixedFrame();
+    if (hostRandomState != floatState) randomInStep = false;
+    return frameDiff();
+}
+
+static void compareEffect(EffectType e) {
+    Tally t;
+    bool randomInStep = true;
+    unsigned long stepMs = e == EFFECT_SUNRISE ? 1000 : LED_UPDATE_INTERVAL;
+    unsigned long spanMs = e == EFFECT_SUNRISE ? 30UL * 60 * 1000 + 5000 : 40000;
+
+    for (const Setting &s : SETTINGS) {
+        randomSeed(7);
+        for (unsigned long now = 0; now < spanMs; now += stepMs) {
+            int diff = compareFrame(
+                [&] { nl_float::applyEffect(floatStrip, e, s.r, s.g, s.b, s.w, s.brightness, now); },
+                [&] { applyEffect(fixedStrip, e, s.r, s.g, s.b, s.w, s.brightness, now); },
+                randomInStep);
+            if (diff > 1 && e == EFFECT_SUNRISE && whiteHeld()) {
+                t.held++;
+                continue;
+            }
+            t.add(diff);
+        }
+    }
+
+    printf("  %-16s %6u frames, %5u off by 1, max diff %d", EFFECT_NAMES[e], t.frames, t.offByOne, t.worst);
+    if (t.held) printf(" (+%u with white held at 255)", t.held);
+    printf("\n");
+    if (t.worst > 1 || !randomInStep) {
+        printf("  FAIL %s%s\n", EFFECT_NAMES[e], randomInStep ? "" : ": random() calls differ");
+        failures++;
+    }
+}
+
+static void compareTransitions() {
+    ScheduleSlot from = {}, to = {};
+    from.red = 10;  from.green = 200; from.blue = 30; from.white = 0;   from.brightness = 40;
+    to.red   = 250; to.green   = 0;   to.blue  = 90; to.white   = 255; to.brightness   = 255;
+
+    Tally t;
+    bool randomInStep = true;
+    for (int i = 0; i <= 1000; i++) {
+        float progress = i / 1000.0f;
+        t.add(compareFrame(
+            [&] { nl_float::applyTransition(floatStrip, from, to, progress, 0); },
+            [&] { applyTransition(fixedStrip, from, to, progress, 0); },
+            randomInStep));
+    }
+
+    printf("  %-16s %6u frames, %5u off by 1, max diff %d\n", "Transition", t.frames, t.offByOne, t.worst);
+    if (t.worst > 1) {
+        printf("  FAIL transitions\n");
+        failures++;
+    }
+}
+
+int main() {
+    for (int e = 0; e < EFFECT_COUNT; e++) compareEffect((EffectType)e);
+    compareTransitions();
+    return failures ? 1 : 0;
+}
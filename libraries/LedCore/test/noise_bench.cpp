@@ -0,0 +1,89 @@
+// ─── Noise Benchmark ───────────────────────────────────────────────────────
+// Samples per second for the gradient noise primitives and the cost of one
+// frame of each noise-field effect (next to the Lava and Candle it can stand
+// in for) on the grid's 16x16 and the panel's 32x8 geometry. Host numbers
+// compare changes to noise.cpp; on the device, /api/perf reports the same
+// effects' render time per frame.
+
+#include <Arduino.h>
+#include <led_geometry.h>
+#include <noise.h>
+#include <shared_effects.h>
+
+typedef LedGeometry<16, 16, WIRING_ROWS, ROTATE_90, true>     GridGeo;
+typedef LedGeometry<32, 8, WIRING_COLUMNS, ROTATE_180, true>  PanelGeo;
+
+static volatile uint32_t sink;   // keeps results live
+
+// Effects draw into this instead of a compositor canvas.
+template <uint16_t N>
+struct BenchCanvas {
+    uint32_t px[N];
+    void setPixelColor(uint16_t i, uint32_t c) { px[i] = c; }
+    void fill(uint32_t c) { for (uint16_t i = 0; i < N; i++) px[i] = c; }
+    void clear() { fill(0); }
+    void setPixels(const uint32_t *src) { memcpy(px, src, sizeof(px)); }
+    void show() { sink += px[0] ^ px[N - 1]; }
+};
+
+// Best of three runs of `fn(i)` for i in [0, n), in calls per second.
+template <class Fn>
+static double rate(uint32_t n, Fn fn) {
+    double best = 0;
+    for (int run = 0; run < 3; run++) {
+        unsigned long start = micros();
+        uint32_t acc = 0;
+        for (uint32_t i = 0; i < n; i++) acc += fn(i);
+        unsigned long us = micros() - start;
+        sink += acc;
+        double r = us ? n * 1e6 / us : 0;
+        if (r > best) best = r;
+    }
+    return best;
+}
+
+template <class Geo>
+static void benchEffects(const char *name) {
+    static SharedEffects<Geo> fx;
+    static BenchCanvas<Geo::COUNT> canvas;
+    fx.seed(12345);
+
+    static const struct {
+        const char *name;
+        void (SharedEffects<Geo>::*draw)(BenchCanvas<Geo::COUNT> &);
+    } EFFECTS[] = {
+        {"fireNoise",   &SharedEffects<Geo>::template fireNoise<BenchCanvas<Geo::COUNT> >},
+        {"auroraNoise", &SharedEffects<Geo>::template auroraNoise<BenchCanvas<Geo::COUNT> >},
+        {"lavaNoise",   &SharedEffects<Geo>::template lavaNoise<BenchCanvas<Geo::COUNT> >},
+        {"candleNoise", &SharedEffects<Geo>::template candleNoise<BenchCanvas<Geo::COUNT> >},
+        {"lava",        &SharedEffects<Geo>::template lava<BenchCanvas<Geo::COUNT> >},
+        {"candle",      &SharedEffects<Geo>::template candle<BenchCanvas<Geo::COUNT> >},
+    };
+
+    printf("\n%s (%u LEDs)\n", name, (unsigned)Geo::COUNT);
+    for (const auto &e : EFFECTS) {
+        double fps = rate(2000, [&](uint32_t) { (fx.*e.draw)(canvas); return 0u; });
+        printf("  %-12s %9.0f ns/frame\n", e.name, 1e9 / fps);
+    }
+}
+
+int main() {
+    const uint32_t N = 1u << 20;
+
+    printf("Samples/s\n");
+    printf("  noise2          %12.0f\n", rate(N, [](uint32_t i) {
+        return (uint32_t)(uint8_t)noise2((uint16_t)(i * 37), (uint16_t)(i * 91));
+    }));
+    printf("  noise3          %12.0f\n", rate(N, [](uint32_t i) {
+        return (uint32_t)(uint8_t)noise3((uint16_t)(i * 37), (uint16_t)(i * 91), (uint16_t)i);
+    }));
+    for (uint8_t oct = 1; oct <= NOISE_MAX_OCTAVES; oct++) {
+        printf("  fractalNoise3/%u %12.0f\n", oct, rate(N / oct, [oct](uint32_t i) {
+            return (uint32_t)fractalNoise3((uint16_t)(i * 37), (uint16_t)(i * 91), (uint16_t)i, oct);
+        }));
+    }
+
+    benchEffects<GridGeo>("16x16 grid");
+    benchEffects<PanelGeo>("32x8 panel");
+    return 0;
+}
@@ -0,0 +1,254 @@
+// build: -DHOST_FAKE_CLOCK -I../../../led_grid ../../../led_grid/persistence.cpp ../../../led_grid/trace_log.cpp -Wno-format-truncation
+// ─── Config Store Test ─────────────────────────────────────────────────────
+// led_grid's persistence.cpp against a fake Preferences (host/Preferences.h):
+// migration from the per-key schema 0, single-read boot, write-behind saves
+// (coalescing, the max delay, diffing, flush, retrying a failed write) and
+// recovery from a blob that fails its CRC or comes from newer firmware.
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <crc32.h>
+#include "persistence.h"
+
+uint32_t hostMillis = 10000;
+
+static int failures = 0;
+
+#define CHECK(cond)                                                     \
+    do {                                                                \
+        if (!(cond)) {                                                  \
+            printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);    \
+            failures++;                                                 \
+        }                                                               \
+    } while (0)
+
+static const char *BLOB        = "ledgrid/cfg";
+static const size_t RESERVED_AT = 6;     // ConfigBlobHeader::reserved, not checked
+
+static bool sameConfig(const GridConfig &a, const GridConfig &b) {
+    return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+static GridConfig defaults() {
+    GridConfig d;
+    initDefaultConfig(d);
+    return d;
+}
+
+// Let `ms` pass in 100 ms steps, calling loopPersistence() like loop() does.
+static void idle(uint32_t ms) {
+    for (uint32_t t = 0; t < ms; t += 100) {
+        hostMillis += 100;
+        loopPersistence();
+    }
+}
+
+static void testMigration() {
+    hostNvs = HostNvs();
+    Preferences p;
+    p.begin("ledgrid");
+    p.putUChar("brightness", 77);
+    p.putUChar("effect", EFFECT_FIRE);
+    p.putUShort("dropStart", 420);
+    p.putBool("use24Hour", false);
+    p.putString("authPass", "hunter2");
+    p.putBool("mqttOn", true);
+    p.putString("mqttHost", "broker.lan");
+    p.putUShort("mqttPort", 8883);
+    p.putString("session", "kept");          // not a config key
+    p.end();
+
+    GridConfig cfg;
+    loadGridConfig(cfg);
+    CHECK(cfg.brightness == 77);
+    CHECK(cfg.currentEffect == EFFECT_FIRE);
+    CHECK(cfg.dropStartMs == 420);
+    CHECK(!cfg.use24Hour);
+    CHECK(strcmp(cfg.authPassword, "hunter2") == 0);
+    CHECK(cfg.mqtt.enabled && strcmp(cfg.mqtt.host, "broker.lan") == 0 && cfg.mqtt.port == 8883);
+    CHECK(cfg.aiSkillPct == defaults().aiSkillPct);
+
+    // The blob replaces the legacy keys; anything else is left alone
+    CHECK(hostNvs.kv.count(BLOB) == 1);
+    CHECK(hostNvs.kv.count("ledgrid/brightness") == 0 && hostNvs.kv.count("ledgrid/mqttHost") == 0);
+    CHECK(hostNvs.kv.count("ledgrid/session") == 1);
+
+    // The next boot reads the blob alone and writes nothing
+    hostNvs.resetCounts();
+    GridConfig again;
+    loadGridConfig(again);
+    CHECK(sameConfig(again, cfg));
+    CHECK(hostNvs.writes == 0);
+    CHECK(hostNvs.reads <= 2);               // length + bytes
+    printf("  migration: schema 0 -> %d, boot reads %d\n", CONFIG_SCHEMA_VERSION, hostNvs.reads);
+}
+
+static void testWriteBehind() {
+    GridConfig cfg;
+    loadGridConfig(cfg);
+
+    // A slider dragged for 4 s: nothing until it settles, then one write
+    hostNvs.resetCounts();
+    for (int i = 0; i < 40; i++) {
+        cfg.brightness = 100 + i;
+        saveGridConfig(cfg);
+        idle(100);
+    }
+    CHECK(hostNvs.writes == 0);
+    idle(CONFIG_SAVE_DELAY_MS);
+    CHECK(hostNvs.writes == 1);
+    GridConfig stored;
+    loadGridConfig(stored);
+    CHECK(stored.brightness == 139);
+    printf("  slider: 40 changes, %d write\n", hostNvs.writes);
+
+    // Saving what is already stored writes nothing
+    hostNvs.resetCounts();
+    saveGridConfig(cfg);
+    idle(CONFIG_SAVE_DELAY_MS * 2);
+    CHECK(hostNvs.writes == 0);
+
+    // Changed and changed back before the commit: nothing
+    cfg.bgR = 9;
+    saveGridConfig(cfg);
+    cfg.bgR = 0;
+    saveGridConfig(cfg);
+    idle(CONFIG_SAVE_DELAY_MS * 2);
+    CHECK(hostNvs.writes == 0);
+
+    // Changes that never settle are still committed by the max delay
+    hostNvs.resetCounts();
+    uint32_t start = hostMillis;
+    while (hostNvs.writes == 0 && hostMillis - start < CONFIG_SAVE_MAX_DELAY_MS * 2) {
+        cfg.jitterPct = (cfg.jitterPct + 1) % 50;
+        saveGridConfig(cfg);
+        idle(1000);
+    }
+    CHECK(hostNvs.writes == 1);
+    CHECK(hostMillis - start <= CONFIG_SAVE_MAX_DELAY_MS + 1000);
+    printf("  continuous changes: committed after %lu ms\n", (unsigned long)(hostMillis - start));
+
+    // flushGridConfig() commits at once (before a restart)
+    hostNvs.resetCounts();
+    cfg.aiSkillPct = 3;
+    saveGridConfig(cfg);
+    flushGridConfig();
+    CHECK(hostNvs.writes == 1);
+    loadGridConfig(stored);
+    CHECK(sameConfig(stored, cfg));
+}
+
+static void testWriteFailure() {
+    GridConfig cfg;
+    loadGridConfig(cfg);
+
+    // A failed write stays queued and is retried, backing off
+    hostNvs.resetCounts();
+    hostNvs.failWrites = 3;
+    cfg.brightness = 21;
+    saveGridConfig(cfg);
+    idle(CONFIG_SAVE_DELAY_MS);
+    CHECK(hostNvs.writes == 1);
+    idle(CONFIG_SAVE_RETRY_MS);
+    CHECK(hostNvs.writes == 2);
+    idle(CONFIG_SAVE_RETRY_MS);              // second retry waits twice as long
+    CHECK(hostNvs.writes == 2);
+    idle(CONFIG_SAVE_RETRY_MS);
+    CHECK(hostNvs.writes == 3);
+    idle(CONFIG_SAVE_RETRY_MS * 4);
+    CHECK(hostNvs.writes == 4);
+    GridConfig stored;
+    loadGridConfig(stored);
+    CHECK(stored.brightness == 21);
+    printf("  write failures: 3 failed, stored on write %d\n", hostNvs.writes);
+
+    // A change made while a retry waits goes out with it
+    hostNvs.resetCounts();
+    hostNvs.failWrites = 1;
+    cfg.brightness = 22;
+    saveGridConfig(cfg);
+    idle(CONFIG_SAVE_DELAY_MS);
+    cfg.bgG = 5;
+    saveGridConfig(cfg);
+    idle(CONFIG_SAVE_RETRY_MS);
+    CHECK(hostNvs.writes == 2);
+    loadGridConfig(stored);
+    CHECK(sameConfig(stored, cfg));
+
+    // flushGridConfig() reports a failure and keeps the save
+    hostNvs.resetCounts();
+    hostNvs.failWrites = 1;
+    cfg.brightness = 23;
+    saveGridConfig(cfg);
+    CHECK(!flushGridConfig());
+    CHECK(flushGridConfig());
+    CHECK(hostNvs.writes == 2);
+    loadGridConfig(stored);
+    CHECK(stored.brightness == 23);
+}
+
+static void testCorruption() {
+    GridConfig cfg;
+    loadGridConfig(cfg);
+    cfg.brightness = 11;
+    saveGridConfig(cfg);
+    flushGridConfig();
+    const std::vector<uint8_t> good = hostNvs.kv[BLOB];
+
+    // The stored CRC is zlib's, so tools can check a dumped blob
+    CHECK(crc32Update(0, "123456789", 9) == 0xCBF43926);
+    CHECK(crc32Update(crc32Update(0, "1234", 4), "56789", 5) == 0xCBF43926);
+
+    // Any single flipped bit in the header or the payload is caught
+    int checked = 0, caught = 0;
+    for (size_t i = 0; i < good.size(); i++) {
+        if (i == RESERVED_AT || i == RESERVED_AT + 1) continue;
+        hostNvs.kv[BLOB] = good;
+        hostNvs.kv[BLOB][i] ^= 1 << (i % 8);
+        GridConfig c;
+        loadGridConfig(c);
+        checked++;
+        if (sameConfig(c, defaults())) caught++;
+    }
+    CHECK(caught == checked);
+    printf("  corruption: %d of %d flipped bytes fell back to defaults\n", caught, checked);
+
+    // ... except in the reserved field, which loads as before
+    hostNvs.kv[BLOB] = good;
+    hostNvs.kv[BLOB][RESERVED_AT] ^= 0xFF;
+    GridConfig r;
+    loadGridConfig(r);
+    CHECK(sameConfig(r, cfg));
+
+    // A truncated blob too
+    hostNvs.kv[BLOB] = good;
+    hostNvs.kv[BLOB].resize(good.size() - 1);
+    GridConfig c;
+    loadGridConfig(c);
+    CHECK(sameConfig(c, defaults()));
+
+    // After a bad blob, saving the defaults still writes a good one
+    hostNvs.resetCounts();
+    saveGridConfig(c);
+    flushGridConfig();
+    CHECK(hostNvs.writes == 1);
+    CHECK(hostNvs.kv[BLOB].size() == good.size());
+    GridConfig reloaded;
+    loadGridConfig(reloaded);
+    CHECK(sameConfig(reloaded, defaults()));
+
+    // A blob from newer firmware (schema unknown here), with a valid CRC
+    hostNvs.kv[BLOB] = good;
+    hostNvs.kv[BLOB][2] = CONFIG_SCHEMA_VERSION + 1;
+    loadGridConfig(c);
+    CHECK(sameConfig(c, defaults()));
+}
+
+int main() {
+    Serial.muted = true;                     // "Config: ..." boot messages
+    testMigration();
+    testWriteBehind();
+    testWriteFailure();
+    testCorruption();
+    return failures ? 1 : 0;
+}
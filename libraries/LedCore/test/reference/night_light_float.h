@@ -0,0 +1,25 @@
+#ifndef NIGHT_LIGHT_FLOAT_H
+#define NIGHT_LIGHT_FLOAT_H
+
+#include <Arduino.h>
+#include <Adafruit_NeoPixel.h>
+#include "config.h"
+
+// ─── Night Light Float Reference ───────────────────────────────────────────
+// The float effects night_light had before its fixed-point rewrite, with
+// the same signatures as the sketch's (see night_light_float.cpp).
+
+namespace nl_float {
+
+void applyEffect(Adafruit_NeoPixel &strip, EffectType effect,
+                 uint8_t r, uint8_t g, uint8_t b, uint8_t w,
+                 uint8_t brightness, unsigned long now);
+
+void applyTransition(Adafruit_NeoPixel &strip,
+                     const ScheduleSlot &from, const ScheduleSlot &to,
+                     float progress, unsigned long now,
+                     int16_t brightnessOverride = -1);
+
+} // namespace nl_float
+
+#endif // NIGHT_LIGHT_FLOAT_H
@@ -0,0 +1,126 @@
+// build: -I../../../led_grid
+// ─── Render Jitter Model ───────────────────────────────────────────────────
+// Frame-to-frame gaps of led_grid's render loop, before and after it moved
+// into its own task, with std::thread standing in for FreeRTOS tasks.
+//
+//   before  one loop() serves the network, then renders when a frame is due
+//   after   a render thread drains a SpscQueue<RENDER_QUEUE_LEN> that the
+//           network thread posts a command to after each request
+//
+// Network work per loop() pass is drawn from a fixed mix: mostly idle,
+// 3.7% ordinary requests (4 ms), 0.3% slow ones (120 ms: a large upload
+// chunk, a flash write). Rendering takes 5 ms every LED_UPDATE_INTERVAL_MS.
+// The host's cores run the two threads in parallel, which a higher
+// priority task gets on the single-core C3 by preempting loop().
+//
+//   ./render_jitter_bench [seconds per run]     (default 4)
+
+#include <Arduino.h>
+#include <spsc_queue.h>
+#include "config.h"
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+static const double FRAME_MS  = LED_UPDATE_INTERVAL_MS;
+static const double RENDER_MS = 5;
+static const double LATE_MS   = FRAME_MS * 1.5;
+
+struct Command {
+    double postedMs;
+};
+
+static double nowMs() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Busy for `ms`, like code that doesn't yield.
+static void spin(double ms) {
+    double end = nowMs() + ms;
+    while (nowMs() < end) {}
+}
+
+// One loop() pass worth of network work, in ms.
+static double networkWork(std::mt19937 &rng) {
+    int r = std::uniform_int_distribution<int>(0, 999)(rng);
+    if (r < 3)  return 120;
+    if (r < 40) return 4;
+    return 0.05;
+}
+
+static double percentile(std::vector<double> &v, int p) {
+    return v.empty() ? 0 : v[(v.size() - 1) * p / 100];
+}
+
+static void report(const char *name, std::vector<double> &gaps) {
+    std::sort(gaps.begin(), gaps.end());
+    long late = std::count_if(gaps.begin(), gaps.end(), [](double g) { return g > LATE_MS; });
+    printf("  %-6s %5zu frames, gap p50 %5.1f  p99 %5.1f  max %5.1f ms, %ld late (>%.0f ms)\n",
+           name, gaps.size(), percentile(gaps, 50), percentile(gaps, 99),
+           gaps.empty() ? 0 : gaps.back(), late, LATE_MS);
+}
+
+static void before(double runMs) {
+    std::mt19937 rng(1);
+    std::vector<double> gaps;
+    double start = nowMs(), last = start;
+    while (nowMs() - start < runMs) {
+        spin(networkWork(rng));
+        double now = nowMs();
+        if (now - last >= FRAME_MS) {
+            gaps.push_back(now - last);
+            last = now;
+            spin(RENDER_MS);
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    report("before", gaps);
+}
+
+static void after(double runMs) {
+    std::mt19937 rng(1);
+    SpscQueue<Command, RENDER_QUEUE_LEN> queue;
+    std::atomic<bool> stop{false};
+    std::vector<double> gaps, latency;
+
+    std::thread render([&] {
+        double last = nowMs();
+        Command c;
+        while (!stop) {
+            while (queue.pop(c)) latency.push_back(nowMs() - c.postedMs);
+            double now = nowMs();
+            if (now - last >= FRAME_MS) {
+                gaps.push_back(now - last);
+                last = now;
+                spin(RENDER_MS);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    int drops = 0;
+    double start = nowMs();
+    while (nowMs() - start < runMs) {
+        double work = networkWork(rng);
+        spin(work);
+        if (work > 1 && !queue.push(Command{nowMs()})) drops++;
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    stop = true;
+    render.join();
+
+    report("after", gaps);
+    std::sort(latency.begin(), latency.end());
+    printf("         %5zu commands, latency p50 %5.2f  p99 %5.2f ms, %d dropped\n",
+           latency.size(), percentile(latency, 50), percentile(latency, 99), drops);
+}
+
+int main(int argc, char **argv) {
+    double runMs = (argc > 1 ? atof(argv[1]) : 4) * 1000;
+    before(runMs);
+    after(runMs);
+    return 0;
+}
@@ -0,0 +1,45 @@
+#!/usr/bin/env bash
+# Host tests and benchmarks for LedCore.
+# Usage:
+#   ./run_tests.sh            # Build and run every *_test.cpp, then *_bench.cpp
+#   ./run_tests.sh noise      # Only the ones whose name starts with "noise"
+#
+# Each file is one program, built with g++ against host/ (a minimal Arduino
+# shim) and ../src. A first line of the form "// build: <flags>" adds
+# compiler flags for that file (sanitizers). A test fails the run by
+# exiting non-zero; benchmarks only print.
+
+set -euo pipefail
+cd "$(dirname "$0")"
+
+CXX="${CXX:-g++}"
+CXXFLAGS="-std=gnu++17 -O2 -g -Wall -Wextra -Wno-unused-parameter -Ihost -I../src"
+BUILD="$(mktemp -d)"
+trap 'rm -rf "$BUILD"' EXIT
+
+FILTER="${1:-}"
+FAILED=0
+
+run() {
+    local src="$1"; shift
+    local name="${src%.cpp}"
+    [[ -n "$FILTER" && "$name" != "$FILTER"* ]] && return 0
+    echo "==> $name"
+    local flags
+    flags="$(sed -n '1s|^// build: ||p' "$src")"
+    # noise.cpp is LedCore's only translation unit
+    if ! $CXX $CXXFLAGS $flags "$@" "$src" ../src/noise.cpp -o "$BUILD/$name" -lpthread; then
+        FAILED=1
+        return 0
+    fi
+    "$BUILD/$name" || FAILED=1
+}
+
+for src in *_test.cpp; do [[ -e "$src" ]] && run "$src"; done
+for src in *_bench.cpp; do [[ -e "$src" ]] && run "$src"; done
+
+if [[ $FAILED -ne 0 ]]; then
+    echo "==> FAILED"
+    exit 1
+fi
+echo "==> OK"
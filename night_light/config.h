@@ -156,8 +156,8 @@ struct NightLightConfig {
 #define TEMP_READ_INTERVAL_MS   5000    // Read chip temperature every 5 seconds
 
 // ─── LED Effect Timing ──────────────────────────────────────────────────────
-#define BREATHING_CYCLE_MS   6000.0f   // 6 seconds per breath
-#define GLOW_CYCLE_MS        20000.0f  // 20 seconds per glow cycle
+#define BREATHING_CYCLE_MS   6000UL    // 6 seconds per breath
+#define GLOW_CYCLE_MS        20000UL   // 20 seconds per glow cycle
 #define TWINKLE_CHANCE       5         // % chance per LED per frame
 #define CANDLE_FLICKER_MS    50        // Flicker update interval
 #define LED_UPDATE_INTERVAL  30        // ms between LED updates (~33 fps)
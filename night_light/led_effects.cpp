@@ -1,5 +1,5 @@
 #include "led_effects.h"
-#include <math.h>
+#include <sine16.h>
 #include <esp_task_wdt.h>
 
 // Thermal dimming factor from main loop (1.0 = normal, 0.0 = fully throttled)
@@ -41,20 +41,69 @@ void wheelRGB(uint8_t pos, uint8_t &r, uint8_t &g, uint8_t &b) {
     }
 }
 
+// ─── Helper: fixed-point fractions ─────────────────────────────────────────
+// Blend factors are fractions of FRAC_ONE (1/65536ths) rather than floats:
+// the ESP32-C3 has no FPU, so each float multiply is a library call.
+#define FRAC_ONE 65536UL
+
+// x / 255 as a fraction, exact at both ends (255 → FRAC_ONE)
+static inline uint32_t frac255(uint8_t x) {
+    return x * 257UL + (x >> 7);
+}
+
+// Position in a repeating cycle as a sine16() angle
+static inline uint16_t cycleAngle(unsigned long now, unsigned long cycleMs) {
+    return (uint16_t)((now % cycleMs) * FRAC_ONE / cycleMs);
+}
+
 // ─── Helper: linear interpolation ───────────────────────────────────────────
-static uint8_t lerp8(uint8_t a, uint8_t b, float t) {
-    return (uint8_t)((float)a + ((float)b - (float)a) * t);
+// a → b as t goes 0 → FRAC_ONE. Rounds down, as the float version truncated.
+static inline uint8_t lerp8(uint8_t a, uint8_t b, uint32_t t) {
+    return (uint8_t)(a + (((int32_t)b - a) * (int32_t)t >> 16));
+}
+
+// ─── Frame Output ──────────────────────────────────────────────────────────
+// The bytes last sent to the LEDs. The strip buffer holds pixels with
+// brightness already applied, so a buffer identical to this one means
+// identical light and show() can be skipped.
+#define FRAME_BYTES (NUM_LEDS * 4)      // SK6812 RGBW: 4 bytes per LED
+
+static uint8_t  shownFrame[FRAME_BYTES];
+static bool     shownValid = false;     // nothing sent since boot
+
+// Set while the LEDs hold effectSolid()'s frame for this colour/brightness
+static bool     solidShown = false;
+static uint32_t solidColour;
+static uint8_t  solidBrightness;
+
+bool showFrame(Adafruit_NeoPixel &strip) {
+    solidShown = false;
+    const uint8_t *pixels = strip.getPixels();
+    if (shownValid && memcmp(pixels, shownFrame, FRAME_BYTES) == 0) return false;
+
+    memcpy(shownFrame, pixels, FRAME_BYTES);
+    shownValid = true;
+    strip.show();
+    return true;
 }
 
 // ─── 0. Solid Colour ────────────────────────────────────────────────────────
 void effectSolid(Adafruit_NeoPixel &strip,
                  uint8_t r, uint8_t g, uint8_t b, uint8_t w, uint8_t brightness) {
-    strip.setBrightness(brightness);
     uint32_t colour = strip.Color(r, g, b, w);
+
+    // Overnight this is the same frame every time: don't even rebuild it
+    if (solidShown && colour == solidColour && brightness == solidBrightness) return;
+
+    strip.setBrightness(brightness);
     for (int i = 0; i < strip.numPixels(); i++) {
         strip.setPixelColor(i, colour);
     }
-    strip.show();
+    showFrame(strip);
+
+    solidShown      = true;
+    solidColour     = colour;
+    solidBrightness = brightness;
 }
 
 // ─── 1. Breathing ───────────────────────────────────────────────────────────
@@ -63,19 +112,18 @@ void effectBreathing(Adafruit_NeoPixel &strip,
                      uint8_t r, uint8_t g, uint8_t b, uint8_t w,
                      uint8_t brightness, unsigned long now) {
     // Sinusoidal brightness modulation
-    float phase = (float)now / BREATHING_CYCLE_MS * 2.0f * PI;
-    float factor = (sinf(phase) + 1.0f) / 2.0f;  // 0.0 → 1.0
+    uint32_t factor = wave16(cycleAngle(now, BREATHING_CYCLE_MS));  // 0 → FRAC_ONE
 
     // Modulate between 15% and 100% of the target brightness
-    uint8_t minBri = (uint8_t)(brightness * 0.15f);
-    uint8_t actualBri = minBri + (uint8_t)((brightness - minBri) * factor);
+    uint8_t minBri = brightness * 15 / 100;
+    uint8_t actualBri = minBri + (uint8_t)((brightness - minBri) * factor >> 16);
 
     strip.setBrightness(actualBri);
     uint32_t colour = strip.Color(r, g, b, w);
     for (int i = 0; i < strip.numPixels(); i++) {
         strip.setPixelColor(i, colour);
     }
-    strip.show();
+    showFrame(strip);
 }
 
 // ─── 2. Soft Glow ──────────────────────────────────────────────────────────
@@ -85,23 +133,28 @@ void effectSoftGlow(Adafruit_NeoPixel &strip,
                     uint8_t brightness, unsigned long now) {
     strip.setBrightness(brightness);
 
-    float phase = (float)now / GLOW_CYCLE_MS * 2.0f * PI;
+    uint16_t phase = cycleAngle(now, GLOW_CYCLE_MS);
     int numLeds = strip.numPixels();
 
+    // Drift the colour slightly warmer/cooler
+    uint8_t rHi = (uint8_t)min(255, (int)r + 30);
+    uint8_t gLo = g * 7 / 10;
+    uint8_t bLo = b / 2;
+    uint8_t wLo = w * 6 / 10;
+
     for (int i = 0; i < numLeds; i++) {
         // One smooth wave spanning the full strip length
-        float ledPhase = phase + (float)i / (float)numLeds * 2.0f * PI;
-        float drift = (sinf(ledPhase) + 1.0f) / 2.0f;  // 0.0 → 1.0
+        uint16_t ledPhase = phase + (uint16_t)(i * FRAC_ONE / numLeds);
+        uint32_t drift = wave16(ledPhase);  // 0 → FRAC_ONE
 
-        // Drift the colour slightly warmer/cooler
-        uint8_t rr = lerp8(r, (uint8_t)min(255, (int)r + 30), drift);
-        uint8_t gg = lerp8((uint8_t)(g * 0.7f), g, drift);
-        uint8_t bb = lerp8((uint8_t)(b * 0.5f), b, drift);
-        uint8_t ww = lerp8((uint8_t)(w * 0.6f), w, drift);
+        uint8_t rr = lerp8(r, rHi, drift);
+        uint8_t gg = lerp8(gLo, g, drift);
+        uint8_t bb = lerp8(bLo, b, drift);
+        uint8_t ww = lerp8(wLo, w, drift);
 
         strip.setPixelColor(i, strip.Color(rr, gg, bb, ww));
     }
-    strip.show();
+    showFrame(strip);
 }
 
 // ─── 3. Starry Twinkle ─────────────────────────────────────────────────────
@@ -120,10 +173,10 @@ void effectStarryTwinkle(Adafruit_NeoPixel &strip,
     strip.setBrightness(brightness);
 
     // Base colour at reduced intensity
-    uint8_t baseR = (uint8_t)(r * 0.4f);
-    uint8_t baseG = (uint8_t)(g * 0.4f);
-    uint8_t baseB = (uint8_t)(b * 0.4f);
-    uint8_t baseW = (uint8_t)(w * 0.4f);
+    uint8_t baseR = r * 4 / 10;
+    uint8_t baseG = g * 4 / 10;
+    uint8_t baseB = b * 4 / 10;
+    uint8_t baseW = w * 4 / 10;
 
     int numLeds = strip.numPixels();
 
@@ -135,7 +188,7 @@ void effectStarryTwinkle(Adafruit_NeoPixel &strip,
 
         // Blend between base colour and bright white based on twinkle level
         if (twinkleBrightness[i] > 0) {
-            float t = (float)twinkleBrightness[i] / 255.0f;
+            uint32_t t = frac255(twinkleBrightness[i]);
             uint8_t rr = lerp8(baseR, r, t);
             uint8_t gg = lerp8(baseG, g, t);
             uint8_t bb = lerp8(baseB, (uint8_t)min(255, (int)b + 40), t);
@@ -152,7 +205,7 @@ void effectStarryTwinkle(Adafruit_NeoPixel &strip,
             strip.setPixelColor(i, strip.Color(baseR, baseG, baseB, baseW));
         }
     }
-    strip.show();
+    showFrame(strip);
 }
 
 // ─── 4. Rainbow ─────────────────────────────────────────────────────────────
@@ -169,7 +222,7 @@ void effectRainbow(Adafruit_NeoPixel &strip,
         uint8_t pos = (uint8_t)((i * 256 / numLeds + offset) & 0xFF);
         strip.setPixelColor(i, wheel(strip, pos));
     }
-    strip.show();
+    showFrame(strip);
 }
 
 // ─── 5. Candle Flicker ─────────────────────────────────────────────────────
@@ -198,7 +251,7 @@ void effectCandleFlicker(Adafruit_NeoPixel &strip,
             // Target a new random flicker value, biased warm
             uint8_t target = (uint8_t)random(80, 255);
             // Smooth towards target (don't jump instantly)
-            flickerValues[idx] = lerp8(flickerValues[idx], target, 0.4f);
+            flickerValues[idx] = lerp8(flickerValues[idx], target, FRAC_ONE * 4 / 10);
         }
     }
 
@@ -206,15 +259,15 @@ void effectCandleFlicker(Adafruit_NeoPixel &strip,
 
     int numLeds = strip.numPixels();
     for (int i = 0; i < numLeds; i++) {
-        float f = (float)flickerValues[i] / 255.0f;
+        uint32_t f = flickerValues[i];   // flicker level, 255 = full
         // Warm amber/orange palette
-        uint8_t r = (uint8_t)(255 * f);
-        uint8_t g = (uint8_t)(120 * f * f);   // Less green at lower flicker
-        uint8_t b = (uint8_t)(15 * f * f * f); // Almost no blue
-        uint8_t wLed = (uint8_t)(w * f * 0.8f); // Warm white glow
+        uint8_t r = f;
+        uint8_t g = 120 * f * f / (255UL * 255);         // Less green at lower flicker
+        uint8_t b = 15 * f * f * f / (255UL * 255 * 255); // Almost no blue
+        uint8_t wLed = w * f * 8 / (255 * 10);           // Warm white glow
         strip.setPixelColor(i, strip.Color(r, g, b, wLed));
     }
-    strip.show();
+    showFrame(strip);
 }
 
 // ─── 6. Sunrise ─────────────────────────────────────────────────────────────
@@ -225,37 +278,43 @@ void effectSunrise(Adafruit_NeoPixel &strip,
                    uint8_t w, uint8_t brightness, unsigned long now) {
     // 30-minute repeating cycle
     const unsigned long cycleMs = 30UL * 60UL * 1000UL;
-    float progress = (float)(now % cycleMs) / (float)cycleMs;  // 0.0 → 1.0
+    uint32_t progress = (uint32_t)((uint64_t)(now % cycleMs) * FRAC_ONE / cycleMs);  // 0 → FRAC_ONE
 
     // Brightness ramps up from 5% to full over the cycle
-    uint8_t minBri = (uint8_t)(brightness * 0.05f);
-    uint8_t actualBri = minBri + (uint8_t)((brightness - minBri) * progress);
+    uint8_t minBri = brightness * 5 / 100;
+    uint8_t actualBri = minBri + (uint8_t)((brightness - minBri) * progress >> 16);
     strip.setBrightness(actualBri);
 
-    // Colour transitions: deep red → amber → warm white
+    // Colour transitions: deep red → amber → warm white, a third (0.33)
+    // of the cycle each
+    const uint32_t third = FRAC_ONE * 33 / 100;
     uint8_t r, g, b;
     uint8_t wLed;
-    if (progress < 0.33f) {
+    if (progress < third) {
         // Phase 1: deep red to orange, white off
-        float t = progress / 0.33f;
+        uint32_t t = progress * FRAC_ONE / third;
         r = lerp8(120, 255, t);
         g = lerp8(0, 80, t);
         b = 0;
         wLed = 0;
-    } else if (progress < 0.66f) {
+    } else if (progress < 2 * third) {
         // Phase 2: orange to warm amber, white ramps to 30%
-        float t = (progress - 0.33f) / 0.33f;
+        uint32_t t = (progress - third) * FRAC_ONE / third;
         r = 255;
         g = lerp8(80, 180, t);
         b = lerp8(0, 30, t);
-        wLed = (uint8_t)(w * 0.3f * t);
+        wLed = (uint8_t)(w * 3 * t / 10 >> 16);
     } else {
-        // Phase 3: warm amber to warm white, white ramps to full
-        float t = (progress - 0.66f) / 0.33f;
+        // Phase 3: warm amber to warm white, white ramps to full. The phase
+        // runs 0.34 of the cycle, so t ends a little past FRAC_ONE; hold
+        // white at 255 rather than let it wrap.
+        uint32_t t = (progress - 2 * third) * FRAC_ONE / third;
+        uint8_t wLo = w * 3 / 10;
         r = 255;
         g = lerp8(180, 230, t);
         b = lerp8(30, 120, t);
-        wLed = lerp8((uint8_t)(w * 0.3f), w, t);
+        uint32_t wRamp = wLo + ((w - wLo) * t >> 16);
+        wLed = wRamp > 255 ? 255 : wRamp;
     }
 
     uint32_t colour = strip.Color(r, g, b, wLed);
@@ -263,18 +322,17 @@ void effectSunrise(Adafruit_NeoPixel &strip,
     for (int i = 0; i < numLeds; i++) {
         strip.setPixelColor(i, colour);
     }
-    strip.show();
+    showFrame(strip);
 }
 
 // ─── 7. Christmas ───────────────────────────────────────────────────────────
 // Red/green alternating LEDs with sinusoidal breathing
 void effectChristmas(Adafruit_NeoPixel &strip,
                      uint8_t brightness, unsigned long now) {
-    float phase = (float)now / BREATHING_CYCLE_MS * 2.0f * PI;
-    float factor = (sinf(phase) + 1.0f) / 2.0f;
+    uint32_t factor = wave16(cycleAngle(now, BREATHING_CYCLE_MS));
 
-    uint8_t minBri = (uint8_t)(brightness * 0.3f);
-    uint8_t actualBri = minBri + (uint8_t)((brightness - minBri) * factor);
+    uint8_t minBri = brightness * 3 / 10;
+    uint8_t actualBri = minBri + (uint8_t)((brightness - minBri) * factor >> 16);
     strip.setBrightness(actualBri);
 
     // Slow shift offset so the pattern moves along the strip
@@ -291,7 +349,7 @@ void effectChristmas(Adafruit_NeoPixel &strip,
             strip.setPixelColor(i, strip.Color(0, 200, 0, 0));
         }
     }
-    strip.show();
+    showFrame(strip);
 }
 
 // ─── 8. Halloween ───────────────────────────────────────────────────────────
@@ -316,7 +374,7 @@ void effectHalloween(Adafruit_NeoPixel &strip,
         for (int u = 0; u < updates; u++) {
             int idx = random(numLeds);
             uint8_t target = (uint8_t)random(120, 255);
-            flickerValues[idx] = lerp8(flickerValues[idx], target, 0.3f);
+            flickerValues[idx] = lerp8(flickerValues[idx], target, FRAC_ONE * 3 / 10);
         }
     }
 
@@ -324,22 +382,22 @@ void effectHalloween(Adafruit_NeoPixel &strip,
     int numLeds = strip.numPixels();
 
     for (int i = 0; i < numLeds; i++) {
-        float f = (float)flickerValues[i] / 255.0f;
+        uint32_t f = flickerValues[i];   // flicker level, 255 = full
         if (i % 3 == 0) {
             // Purple
-            uint8_t r = (uint8_t)(120 * f);
+            uint8_t r = 120 * f / 255;
             uint8_t g = 0;
-            uint8_t b = (uint8_t)(200 * f);
+            uint8_t b = 200 * f / 255;
             strip.setPixelColor(i, strip.Color(r, g, b, 0));
         } else {
             // Orange
-            uint8_t r = (uint8_t)(255 * f);
-            uint8_t g = (uint8_t)(100 * f * f);
+            uint8_t r = f;
+            uint8_t g = 100 * f * f / (255UL * 255);
             uint8_t b = 0;
             strip.setPixelColor(i, strip.Color(r, g, b, 0));
         }
     }
-    strip.show();
+    showFrame(strip);
 }
 
 // ─── 9. Birthday ────────────────────────────────────────────────────────────
@@ -371,7 +429,7 @@ void effectBirthday(Adafruit_NeoPixel &strip,
         }
 
         if (sparkle[i] > 0) {
-            float t = (float)sparkle[i] / 255.0f;
+            uint32_t t = frac255(sparkle[i]);
             r = lerp8(r, 255, t);
             g = lerp8(g, 255, t);
             b = lerp8(b, 255, t);
@@ -386,7 +444,7 @@ void effectBirthday(Adafruit_NeoPixel &strip,
             strip.setPixelColor(i, strip.Color(r, g, b, 0));
         }
     }
-    strip.show();
+    showFrame(strip);
 }
 
 // ─── Effect Dispatcher ──────────────────────────────────────────────────────
@@ -464,7 +522,7 @@ void playBootAnimation(Adafruit_NeoPixel &strip, unsigned long durationMs) {
             uint8_t pos = (uint8_t)((i * 256 / numLeds + offset) & 0xFF);
             strip.setPixelColor(i, wheel(strip, pos));
         }
-        strip.show();
+        showFrame(strip);
 
         delay(LED_UPDATE_INTERVAL);
     }
@@ -477,13 +535,14 @@ void applyTransition(Adafruit_NeoPixel &strip,
                      const ScheduleSlot &from, const ScheduleSlot &to,
                      float progress, unsigned long now,
                      int16_t brightnessOverride) {
-    uint8_t r   = lerp8(from.red,        to.red,        progress);
-    uint8_t g   = lerp8(from.green,      to.green,      progress);
-    uint8_t b   = lerp8(from.blue,       to.blue,       progress);
-    uint8_t w   = lerp8(from.white,      to.white,      progress);
+    uint32_t t  = (uint32_t)(progress * FRAC_ONE);
+    uint8_t r   = lerp8(from.red,        to.red,        t);
+    uint8_t g   = lerp8(from.green,      to.green,      t);
+    uint8_t b   = lerp8(from.blue,       to.blue,       t);
+    uint8_t w   = lerp8(from.white,      to.white,      t);
     uint8_t bri = (brightnessOverride >= 0)
                   ? (uint8_t)brightnessOverride
-                  : lerp8(from.brightness, to.brightness, progress);
+                  : lerp8(from.brightness, to.brightness, t);
 
     // Use the destination effect once past 50% transition
     EffectType effect = (progress < 0.5f)
@@ -17,6 +17,14 @@ void applyTransition(Adafruit_NeoPixel &strip,
                      float progress, unsigned long now,
                      int16_t brightnessOverride = -1);
 
+// Send the strip buffer to the LEDs, unless it is byte-for-byte what was
+// sent last time (pixels are stored with brightness applied, so that covers
+// brightness too). Returns true if show() ran. Every show() goes through
+// here, so the comparison is always against what the LEDs display; any
+// change from the schedule, MQTT or the web UI reaches them on the next
+// update.
+bool showFrame(Adafruit_NeoPixel &strip);
+
 // Individual effect functions (public for direct testing if needed)
 void effectSolid(Adafruit_NeoPixel &strip,
                  uint8_t r, uint8_t g, uint8_t b, uint8_t w, uint8_t brightness);
@@ -89,7 +89,7 @@ void setup() {
     // Initialise LED strip
     strip.begin();
     strip.setBrightness(50);
-    strip.show();
+    showFrame(strip);
     Serial.println(F("LEDs initialised"));
 
     // Load configuration from NVS (or defaults)
@@ -107,7 +107,7 @@ void setup() {
     for (int i = 0; i < NUM_LEDS; i++) {
         strip.setPixelColor(i, strip.Color(FALLBACK_R, FALLBACK_G, FALLBACK_B, FALLBACK_W));
     }
-    strip.show();
+    showFrame(strip);
     Serial.println(F("Boot animation complete"));
 
     // Connect to WiFi via WiFiManager captive portal (pulses LEDs while waiting)
@@ -130,7 +130,7 @@ void setup() {
         // and would otherwise trigger a panic reboot mid-update
         esp_task_wdt_delete(NULL);
         strip.clear();
-        strip.show();
+        showFrame(strip);
         Serial.println(F("OTA update starting..."));
     });
     ArduinoOTA.onEnd([]() {
@@ -237,7 +237,7 @@ void loop() {
 
         if (!config.ledsEnabled && masterFadeFactor <= 0.0f) {
             strip.clear();
-            strip.show();
+            showFrame(strip);
             return;
         }
     }
@@ -245,7 +245,7 @@ void loop() {
     // 3a. Thermal shutdown — force LEDs off if chip is critically hot
     if (thermalShutdown) {
         strip.clear();
-        strip.show();
+        showFrame(strip);
         return;
     }
 
@@ -41,7 +41,7 @@ static void scannerStrip(Adafruit_NeoPixel &strip, unsigned long now) {
             strip.setPixelColor(i, strip.Color(18, 10, 2, 0));
         }
     }
-    strip.show();
+    showFrame(strip);
 }
 
 // ─── AP controls server helpers ─────────────────────────────────────────────
@@ -202,7 +202,7 @@ void setupWiFiManager(Adafruit_NeoPixel &strip) {
 
             if (thermalShutdown) {
                 strip.clear();
-                strip.show();
+                showFrame(strip);
             } else if (manualOverride) {
                 uint8_t bri = userBrightnessActive ? userBrightness : overrideBrightness;
                 applyEffect(strip, (EffectType)overrideEffect,